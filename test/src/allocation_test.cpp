@@ -0,0 +1,162 @@
+#include <core/block.h>
+#include <core/chain.h>
+#include <core/mem_pool.h>
+#include <util/random_generation.h>
+#include <util/timestamp.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// The number of transactions held by the benchmarked block and mempool.
+	constexpr uint32_t transactionCount = 2048;
+
+	// The number of blocks held by the benchmarked chain.
+	constexpr uint32_t blockCount = 16;
+
+	// The number of times each operation is timed.
+	constexpr uint32_t benchmarkRounds = 256;
+
+	// The number of allocations done and the number of bytes allocated since the program started.
+	std::atomic<uint64_t> allocationCount = 0, allocatedBytes = 0;
+
+	// The allocations done and the average time taken by an operation.
+	struct Measurement
+	{
+		uint64_t allocations = 0, bytes = 0;
+		double nanoseconds = 0;
+	};
+
+	// Counts the allocations done by the operation given when run once.
+	template<typename Operation> void CountAllocations(Measurement& measurement, Operation operation)
+	{
+		const uint64_t startAllocations = allocationCount.load(), startBytes = allocatedBytes.load();
+		operation();
+
+		measurement.allocations = allocationCount.load() - startAllocations;
+		measurement.bytes = allocatedBytes.load() - startBytes;
+	}
+
+	// Times the operation given over the benchmark rounds.
+	template<typename Operation> void TimeOperation(Measurement& measurement, Operation operation)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t round = 0; round < benchmarkRounds; round++)
+			operation();
+
+		const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - startTime;
+		measurement.nanoseconds = duration.count() / benchmarkRounds;
+	}
+
+	// Measures copying an object of the type given against moving it, the moves are timed by moving the object back and
+	// forth between two objects. Returns TRUE if moving the object didn't allocate anything.
+	template<typename Ty> bool MeasureCopyAndMove(const char* name, Ty& object)
+	{
+		Measurement copy, move;
+
+		CountAllocations(copy, [&]() { Ty copiedObject(object); });
+		TimeOperation(copy, [&]() { Ty copiedObject(object); });
+
+		CountAllocations(move, [&]() { Ty movedObject(std::move(object)); object = std::move(movedObject); });
+		TimeOperation(move, [&]() { Ty movedObject(std::move(object)); object = std::move(movedObject); });
+
+		// Each round moves the object twice
+		std::cout << "[" << name << " Copy]: " << copy.allocations << " allocations, " << copy.bytes << " bytes, " <<
+			std::fixed << std::setprecision(1) << copy.nanoseconds << " ns" << std::endl;
+
+		std::cout << "[" << name << " Move]: " << move.allocations << " allocations, " << move.bytes << " bytes, " <<
+			move.nanoseconds / 2 << " ns" << std::endl << std::endl;
+
+		return move.allocations == 0;
+	}
+
+	Volt::Transaction GetRandomTransaction(const Volt::ECKeyPair& sender, const Volt::ECKeyPair& recipient)
+	{
+		return Volt::Transaction(Volt::TransactionType::TRANSFER, Volt::GenerateRandomUint64(0, UINT64_MAX),
+			(Volt::Amount)Volt::GenerateRandomUint64(1, VOLT_MAX_AMOUNT), 1, Volt::GetTimeSinceEpoch(), sender.GetPublicKeyHex(),
+			recipient.GetPublicKeyHex());
+	}
+}
+
+// Every allocation done by the program goes through these, so the allocations done by each operation can be counted.
+// Note that when the library is built as a DLL, only the allocations done by the templates instantiated here are seen.
+void* operator new(size_t size)
+{
+	allocationCount++;
+	allocatedBytes += size;
+
+	void* memory = std::malloc(size ? size : 1);
+	if (!memory)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	std::free(memory);
+}
+
+int main(int argc, char** argv)
+{
+	Volt::ECKeyPair sender, recipient;
+	bool movesAllocationFree = true;
+
+	std::vector<Volt::Transaction> txs;
+	txs.reserve(transactionCount);
+
+	for (uint32_t i = 0; i < transactionCount; i++)
+		txs.emplace_back(GetRandomTransaction(sender, recipient));
+
+	// The containers and the types built on top of them, each holding the same transactions
+	Volt::Vector<Volt::Transaction> txVector(txs);
+	movesAllocationFree &= MeasureCopyAndMove("Vector<Transaction>", txVector);
+
+	Volt::Deque<Volt::Transaction> txDeque(std::deque<Volt::Transaction>(txs.begin(), txs.end()));
+	movesAllocationFree &= MeasureCopyAndMove("Deque<Transaction>", txDeque);
+
+	Volt::Block block(1, Volt::DigestField(), txVector, 256);
+	movesAllocationFree &= MeasureCopyAndMove("Block", block);
+
+	Volt::MemPool pool(txDeque);
+	movesAllocationFree &= MeasureCopyAndMove("MemPool", pool);
+
+	std::vector<Volt::Block> blocks(blockCount, block);
+	Volt::Chain chain = Volt::CreateExistingChain(Volt::Vector<Volt::Block>(std::move(blocks)));
+	movesAllocationFree &= MeasureCopyAndMove("Chain", chain);
+
+	// Push the same mined block onto two copies of a chain, one by copy and one by move
+	Volt::Chain copyChain, moveChain;
+	Volt::MemPool emptyPool;
+	Volt::Block minedBlock;
+
+	Volt::ErrorCode miningError = Volt::MineNextBlock(emptyPool, minedBlock, copyChain, 256, recipient);
+
+	// The allocations done by verifying the block are the same for both, so the difference is the copy of the block
+	Measurement pushCopy, pushMove;
+	Volt::ErrorCode pushCopyError, pushMoveError;
+
+	CountAllocations(pushCopy, [&]() { pushCopyError = Volt::PushBlock(copyChain, minedBlock); });
+	CountAllocations(pushMove, [&]() { pushMoveError = Volt::PushBlock(moveChain, std::move(minedBlock)); });
+
+	std::cout << "[PushBlock Copy]: " << pushCopy.allocations << " allocations, " << pushCopy.bytes << " bytes" << std::endl;
+	std::cout << "[PushBlock Move]: " << pushMove.allocations << " allocations, " << pushMove.bytes << " bytes" << std::endl;
+	std::cout << "[Blocks Pushed]: " << (!miningError && !pushCopyError && !pushMoveError ? "Yes" : "No") << std::endl <<
+		std::endl;
+
+	movesAllocationFree &= !miningError && !pushCopyError && !pushMoveError;
+	std::cout << "[Moves Allocation Free]: " << (movesAllocationFree ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return movesAllocationFree ? 0 : 1;
+}
@@ -24,23 +24,24 @@ int main(int argc, char** argv)
 	Volt::Block block;
 
 	// Mine 2 blocks and append them to the chain
-	miningError = Volt::MineNextBlock(memPool, block, chain, 2, keyPair);
+	miningError = Volt::MineNextBlock(memPool, block, chain, 256, keyPair);
 	chainAppendError = Volt::PushBlock(chain, block);
 
 	recordedhashRates.emplace_back(Volt::GetCurrentHashesPerSecond());
 
-	miningError = Volt::MineNextBlock(memPool, block, chain, 2, keyPair);
+	miningError = Volt::MineNextBlock(memPool, block, chain, 256, keyPair);
 	chainAppendError = Volt::PushBlock(chain, block);
 
 	recordedhashRates.emplace_back(Volt::GetCurrentHashesPerSecond());
 
 	// Create a transaction and push the transaction to the mempool
 	Volt::Transaction tx;
-	tx = Volt::CreateNewTransaction(100, 20, keyPair, keyPair2, &txError);
+	tx = Volt::CreateNewTransaction(Volt::ConvertCoinsToAmount(100), Volt::ConvertCoinsToAmount(20), keyPair, keyPair2,
+		&txError);
 	txError = Volt::PushTransaction(memPool, chain, tx);
 	
 	// Mine 3rd block (this time we will use a different method to mine the block)
-	block = Volt::CreateBlock(memPool, chain, 2, &keyPair2, [](const Volt::Transaction& tx) { return true; });
+	block = Volt::CreateBlock(memPool, chain, 256, &keyPair2, [](const Volt::Transaction& tx) { return true; });
 	miningError = Volt::MineNextBlock(block);
 	chainAppendError = Volt::PushBlock(chain, block);
 
@@ -64,10 +65,10 @@ int main(int argc, char** argv)
 	std::cout << "[Average Hash Rate]: " << (total / recordedhashRates.size()) << " H/s\n\n";
 
 	// Print out the balance of public key addresses
-	std::cout << "[Public Key 1]: " << keyPair.GetPublicKeyHex() << " -> Balance: " << chain.GetAddressBalance(keyPair) << 
-		std::endl;
-	std::cout << "[Public Key 2]: " << keyPair2.GetPublicKeyHex() << " -> Balance: " << chain.GetAddressBalance(keyPair2) << 
-		std::endl;
+	std::cout << "[Public Key 1]: " << keyPair.GetPublicKeyHex() << " -> Balance: " << 
+		Volt::ConvertAmountToString(chain.GetAddressBalance(keyPair)) << std::endl;
+	std::cout << "[Public Key 2]: " << keyPair2.GetPublicKeyHex() << " -> Balance: " << 
+		Volt::ConvertAmountToString(chain.GetAddressBalance(keyPair2)) << std::endl;
 
 	// Print the current block height of the chain
 	std::cout << "[Current Block Height]: " << chain.GetLatestBlockHeight() << std::endl;
@@ -0,0 +1,259 @@
+#include <util/data_conversion.h>
+#include <util/random_generation.h>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace
+{
+	// The largest random data length tested, this covers every tail length of the vectorized loops several times.
+	constexpr size_t maxRandomDataSize = 300;
+
+	// The number of random buffers converted by each backend.
+	constexpr uint32_t randomDataCount = 4096;
+
+	// The total number of bytes converted by each implementation for each benchmarked size.
+	constexpr size_t benchmarkByteCount = 1 << 24;
+
+	// The sizes benchmarked: a hash digest, a DER signiture, and a large buffer.
+	constexpr size_t benchmarkSizes[] = { 32, 72, 4096 };
+
+	// Keeps the results of the benchmarked conversions from being optimized away.
+	volatile uint64_t benchmarkSink = 0;
+
+	const Volt::HexCodecBackend backends[] = {
+		Volt::HexCodecBackend::SCALAR, Volt::HexCodecBackend::SSSE3, Volt::HexCodecBackend::AVX2
+	};
+
+	const char* GetBackendName(Volt::HexCodecBackend backend)
+	{
+		switch (backend)
+		{
+		case Volt::HexCodecBackend::SSSE3:
+			return "SSSE3";
+		case Volt::HexCodecBackend::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+
+	std::vector<uint8_t> GetRandomData(size_t dataSize)
+	{
+		std::vector<uint8_t> data(dataSize);
+		for (uint8_t& byte : data)
+			byte = (uint8_t)Volt::GenerateRandomUint64(0, UINT8_MAX);
+
+		return data;
+	}
+
+	// The previous implementation of the conversions, which the benchmarks are compared with.
+	std::string LegacyConvertByteToHexData(const std::vector<uint8_t>& bytes)
+	{
+		std::stringstream ss;
+		for (uint32_t i = 0; i < bytes.size(); i++)
+			ss << std::hex << std::setw(2) << std::setfill('0') << (int)bytes[i];
+
+		std::string hex = ss.str();
+		std::transform(hex.begin(), hex.end(), hex.begin(), ::toupper);
+
+		return hex;
+	}
+
+	std::vector<uint8_t> LegacyConvertHexToByteData(const std::string& hex)
+	{
+		std::vector<uint8_t> resultByteData;
+		resultByteData.reserve(hex.size() / 2);
+
+		for (size_t i = 0; i < hex.size(); i += 2)
+		{
+			int leftShiftAmt = 4;
+			unsigned char deneryChar = 0;
+
+			for (size_t j = 0; j < 2; j++)
+			{
+				if (hex[i + j] >= '0' && hex[i + j] <= '9')
+					deneryChar += (unsigned char)((hex[i + j] - '0') << leftShiftAmt);
+				else if (hex[i + j] >= 'A' && hex[i + j] <= 'F')
+					deneryChar += (unsigned char)((10 + (hex[i + j] - 'A')) << leftShiftAmt);
+
+				leftShiftAmt -= 4;
+			}
+
+			resultByteData.emplace_back(deneryChar);
+		}
+
+		return resultByteData;
+	}
+
+	std::string LegacyConvertUintToHex(uint64_t num)
+	{
+		std::stringstream hexStream;
+		hexStream << std::hex << std::setw(2) << std::setfill('0') << num;
+
+		return hexStream.str();
+	}
+
+	// Checks the backend currently selected against the legacy implementation, returns the number of failed checks.
+	uint64_t CheckBackend()
+	{
+		uint64_t failures = 0;
+		for (uint32_t i = 0; i < randomDataCount; i++)
+		{
+			const std::vector<uint8_t> data = GetRandomData(i % (maxRandomDataSize + 1));
+			const std::string hex = Volt::ConvertByteToHexData(data);
+
+			if (hex != LegacyConvertByteToHexData(data))
+				failures++;
+
+			// Both upper and lower case hex must decode back into the same bytes
+			std::string lowerHex = hex;
+			std::transform(lowerHex.begin(), lowerHex.end(), lowerHex.begin(), ::tolower);
+
+			std::vector<uint8_t> decoded(data.size());
+			if (!Volt::ConvertHexToByteData(hex.data(), hex.size(), decoded.data()) || decoded != data)
+				failures++;
+			if (!Volt::ConvertHexToByteData(lowerHex.data(), lowerHex.size(), decoded.data()) || decoded != data)
+				failures++;
+
+			if (data.empty())
+				continue;
+
+			// A character which isn't a hex digit must be rejected and treated as zero
+			std::string malformedHex = hex;
+			const size_t malformedIndex = Volt::GenerateRandomUint64(0, hex.size() - 1);
+			const char invalidCharacters[] = { 'G', 'g', '/', ':', '@', '`', ' ', '\0', (char)0xC1 };
+			malformedHex[malformedIndex] =
+				invalidCharacters[Volt::GenerateRandomUint64(0, sizeof(invalidCharacters) - 1)];
+
+			std::vector<uint8_t> expected = data;
+			expected[malformedIndex / 2] &= (malformedIndex % 2 == 0) ? 0x0F : 0xF0;
+
+			if (Volt::ConvertHexToByteData(malformedHex.data(), malformedHex.size(), decoded.data()) || decoded != expected)
+				failures++;
+
+			// Odd lengths must be rejected
+			if (Volt::ConvertHexToByteData(hex.data(), hex.size() - 1, decoded.data()))
+				failures++;
+		}
+
+		return failures;
+	}
+
+	// Returns the number of failed unsigned integer conversions.
+	uint64_t CheckUintConversions()
+	{
+		uint64_t failures = 0;
+		for (uint32_t i = 0; i < randomDataCount; i++)
+		{
+			// Cover every digit count
+			const uint64_t num = Volt::GenerateRandomUint64(0, UINT64_MAX) >> (i % 64);
+
+			char upperHex[VOLT_UINT64_HEX_LENGTH + 1];
+			std::snprintf(upperHex, sizeof(upperHex), "%02" PRIX64, num);
+
+			char hex[VOLT_UINT64_HEX_LENGTH];
+			const size_t hexLength = Volt::ConvertUintToHex(num, hex, true);
+
+			if (Volt::ConvertUintToHex(num) != LegacyConvertUintToHex(num) || std::string(hex, hexLength) != upperHex ||
+				Volt::ConvertHexToUint(hex, hexLength) != num)
+				failures++;
+		}
+
+		return failures;
+	}
+
+	// Prints the number of bytes converted per second by the conversion given, for each benchmarked size.
+	template<typename ConversionFunction>
+	void Benchmark(const char* name, ConversionFunction convert)
+	{
+		std::cout << "[" << name << "]:";
+		for (size_t size : benchmarkSizes)
+		{
+			const std::vector<uint8_t> data = GetRandomData(size);
+			const std::string hex = Volt::ConvertByteToHexData(data);
+			const size_t iterations = benchmarkByteCount / size;
+
+			uint64_t checksum = 0;
+			const auto startTime = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; i++)
+				checksum += convert(data, hex);
+
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+			std::cout << " " << size << "B: " << std::fixed << std::setprecision(1) <<
+				(iterations * size) / seconds / (1 << 20) << " MiB/s (" << (uint64_t)(iterations / seconds) << "/s);";
+
+			benchmarkSink = checksum;
+		}
+
+		std::cout << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint64_t failures = CheckUintConversions();
+	std::cout << "[Uint Conversions]: " << (failures == 0 ? "Passed" : "FAILED") << std::endl;
+
+	for (Volt::HexCodecBackend backend : backends)
+	{
+		if (Volt::SetHexCodecBackend(backend))
+		{
+			std::cout << "[" << GetBackendName(backend) << "]: Not supported" << std::endl;
+			continue;
+		}
+
+		const uint64_t backendFailures = CheckBackend();
+		std::cout << "[" << GetBackendName(backend) << "]: " << (backendFailures == 0 ? "Passed" : "FAILED") << std::endl;
+
+		failures += backendFailures;
+	}
+
+	// Benchmark encoding and decoding with the legacy implementation and every backend
+	std::cout << std::endl << "Encoding:" << std::endl;
+	Benchmark("Legacy", [](const std::vector<uint8_t>& data, const std::string& hex)
+	{
+		return (uint64_t)LegacyConvertByteToHexData(data)[0];
+	});
+
+	for (Volt::HexCodecBackend backend : backends)
+	{
+		if (Volt::SetHexCodecBackend(backend))
+			continue;
+
+		Benchmark(GetBackendName(backend), [](const std::vector<uint8_t>& data, const std::string& hex)
+		{
+			char output[8192];
+			Volt::ConvertByteToHexData(data.data(), data.size(), output);
+			return (uint64_t)output[0];
+		});
+	}
+
+	std::cout << std::endl << "Decoding:" << std::endl;
+	Benchmark("Legacy", [](const std::vector<uint8_t>& data, const std::string& hex)
+	{
+		return (uint64_t)LegacyConvertHexToByteData(hex)[0] + 1;
+	});
+
+	for (Volt::HexCodecBackend backend : backends)
+	{
+		if (Volt::SetHexCodecBackend(backend))
+			continue;
+
+		Benchmark(GetBackendName(backend), [](const std::vector<uint8_t>& data, const std::string& hex)
+		{
+			uint8_t output[4096];
+			return (uint64_t)Volt::ConvertHexToByteData(hex.data(), hex.size(), output) + output[0];
+		});
+	}
+
+	Volt::SetHexCodecBackend(Volt::GetBestHexCodecBackend());
+	std::cout << std::endl << "[All Conversions Correct]: " << (failures == 0 ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return failures == 0 ? 0 : 1;
+}
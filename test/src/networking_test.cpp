@@ -63,7 +63,7 @@ int main(int argc, char** argv)
 				Volt::Node::OperationReturn futureReturn;
 				Volt::RequestAddressBalance(clientNode, keyPair, futureReturn);
 				
-				std::cout << "Returned Balance: " << std::get<double>(futureReturn.get()) << std::endl;
+				std::cout << "Returned Balance: " << Volt::ConvertAmountToString(std::get<Volt::Amount>(futureReturn.get())) << std::endl;
 			}
 
 			thread.join();
@@ -0,0 +1,132 @@
+#include <util/data_conversion.h>
+#include <util/random_generation.h>
+#include <crypto/sha256.h>
+#include <crypto/sha256_kernel.h>
+#include <iostream>
+#include <chrono>
+
+namespace
+{
+	// The size of the message hashed by the test, this matches the size of the block header.
+	constexpr size_t messageSize = 96, prefixSize = 64, nonceOffset = messageSize - sizeof(uint64_t);
+
+	// The number of nonces hashed when benchmarking each kernel.
+	constexpr uint64_t benchmarkHashCount = 1 << 21;
+
+	const char* GetKernelName(Volt::NonceKernel kernel)
+	{
+		switch (kernel)
+		{
+		case Volt::NonceKernel::SSE41:
+			return "SSE4.1";
+		case Volt::NonceKernel::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+
+	void WriteNonce(std::vector<uint8_t>& message, uint64_t nonce)
+	{
+		for (size_t i = 0; i < sizeof(uint64_t); i++)
+			message[nonceOffset + i] = (uint8_t)(nonce >> (8 * (sizeof(uint64_t) - 1 - i)));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Generate a random message to be hashed
+	std::vector<uint8_t> message(messageSize);
+	for (uint8_t& byte : message)
+		byte = (uint8_t)Volt::GenerateRandomUint64(0, UINT8_MAX);
+
+	Volt::SHA256Midstate midstate;
+	Volt::NonceKernelInput input;
+
+	if (Volt::GetSHA256Midstate(message.data(), prefixSize, midstate) ||
+		Volt::InitNonceKernelInput(midstate, message.data() + prefixSize, messageSize - prefixSize, nonceOffset - prefixSize,
+			input))
+	{
+		std::cout << "Failed to initialize the kernel input" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Best kernel: " << GetKernelName(Volt::GetBestNonceKernel()) << std::endl << std::endl;
+	bool allPassed = true;
+
+	for (Volt::NonceKernel kernel : { Volt::NonceKernel::SCALAR, Volt::NonceKernel::SSE41, Volt::NonceKernel::AVX2 })
+	{
+		if (!Volt::IsNonceKernelSupported(kernel))
+		{
+			std::cout << "[" << GetKernelName(kernel) << "]: Not supported" << std::endl;
+			continue;
+		}
+
+		// Check the kernel output against the OpenSSL digest of the full message for every lane
+		// The nonces tested include ones where the lower 32 bits overflow into the upper 32 bits
+		const uint32_t laneCount = Volt::GetNonceKernelLaneCount(kernel);
+		uint32_t digests[SHA_256_KERNEL_MAX_LANES][8];
+		uint64_t mismatches = 0;
+
+		for (uint64_t firstNonce : std::initializer_list<uint64_t>{ 0, 0xFFFFFFFC, 0x123456789ABCDEF, UINT64_MAX - 16 })
+		{
+			for (uint64_t batch = 0; batch < 4; batch++)
+			{
+				const uint64_t batchStart = firstNonce + (batch * laneCount);
+				Volt::HashNonceBatch(kernel, input, batchStart, digests);
+
+				for (uint32_t lane = 0; lane < laneCount; lane++)
+				{
+					WriteNonce(message, batchStart + lane);
+
+					std::vector<uint8_t> expectedDigest, kernelDigest(SHA_256_DIGEST_LENGTH);
+					Volt::GetSHA256Digest(message, expectedDigest);
+					Volt::ConvertDigestWordsToBytes(digests[lane], kernelDigest.data());
+
+					if (expectedDigest != kernelDigest)
+						mismatches++;
+				}
+			}
+		}
+
+		allPassed &= (mismatches == 0);
+
+		// Benchmark the kernel
+		const auto startTime = std::chrono::steady_clock::now();
+		uint32_t checksum = 0;
+
+		for (uint64_t nonce = 0; nonce < benchmarkHashCount; nonce += laneCount)
+		{
+			Volt::HashNonceBatch(kernel, input, nonce, digests);
+			checksum ^= digests[0][0];
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "[" << GetKernelName(kernel) << "]: " << (mismatches == 0 ? "Passed" : "FAILED") << " (" <<
+			mismatches << " mismatches), " << (uint64_t)(benchmarkHashCount / seconds) << " H/s (checksum " << checksum <<
+			")" << std::endl;
+	}
+
+	// Benchmark the generic OpenSSL path for comparison
+	{
+		const uint64_t hashCount = benchmarkHashCount / 8;
+		std::vector<uint8_t> digest;
+		Volt::SetSHA256Backend(Volt::SHA256Backend::OPENSSL);
+
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint64_t nonce = 0; nonce < hashCount; nonce++)
+		{
+			WriteNonce(message, nonce);
+			Volt::GetSHA256Digest(message, digest);
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "[OpenSSL EVP]: " << (uint64_t)(hashCount / seconds) << " H/s" << std::endl;
+	}
+
+	std::cout << std::endl << "[All Kernels Valid]: " << (allPassed ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return allPassed ? 0 : 1;
+}
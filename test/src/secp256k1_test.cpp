@@ -0,0 +1,267 @@
+#include <util/data_conversion.h>
+#include <util/random_generation.h>
+#include <crypto/sha256.h>
+#include <crypto/secp256k1.h>
+#include <iostream>
+#include <chrono>
+#include <memory>
+
+namespace
+{
+	// The number of key pairs the messages are signed with.
+	constexpr size_t keyCount = 16;
+
+	// The number of random messages signed and verified by both backends.
+	constexpr uint32_t messageCount = 1024;
+
+	// The number of signitures generated and verified when benchmarking each backend.
+	constexpr uint32_t benchmarkCount = 4096;
+
+	// The order of the secp256k1 group, big-endian.
+	constexpr uint8_t curveOrder[32] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+		0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41
+	};
+
+	const char* GetBackendName(Volt::ECDSABackend backend)
+	{
+		return backend == Volt::ECDSABackend::NATIVE ? "Native" : "OpenSSL";
+	}
+
+	std::vector<uint8_t> GetRandomMessage(size_t messageSize)
+	{
+		std::vector<uint8_t> message(messageSize);
+		for (uint8_t& byte : message)
+			byte = (uint8_t)Volt::GenerateRandomUint64(0, UINT8_MAX);
+
+		return message;
+	}
+
+	std::vector<uint8_t> Sign(Volt::ECDSABackend backend, const std::vector<uint8_t>& message, const Volt::ECKeyPair& key)
+	{
+		std::vector<uint8_t> signiture;
+
+		Volt::SetECDSABackend(backend);
+		Volt::GetSignedSHA256Digest(message, key, signiture);
+
+		return signiture;
+	}
+
+	bool Verify(Volt::ECDSABackend backend, const std::vector<uint8_t>& message, const Volt::ECKeyPair& key,
+		const std::vector<uint8_t>& signiture)
+	{
+		Volt::SetECDSABackend(backend);
+		return !Volt::VerifySHA256Digest(message, key, signiture);
+	}
+
+	Volt::CompactSigniture SignCompact(Volt::ECDSABackend backend, const std::vector<uint8_t>& message,
+		const Volt::ECKeyPair& key)
+	{
+		Volt::CompactSigniture signiture = {};
+
+		Volt::SetECDSABackend(backend);
+		Volt::GetSignedSHA256Digest(message.data(), message.size(), key, signiture);
+
+		return signiture;
+	}
+
+	bool VerifyCompact(Volt::ECDSABackend backend, const std::vector<uint8_t>& message, const Volt::ECKeyPair& key,
+		const Volt::CompactSigniture& signiture)
+	{
+		Volt::SetECDSABackend(backend);
+		return !Volt::VerifySHA256Digest(message.data(), message.size(), key, signiture);
+	}
+
+	// Returns the signiture given with s replaced by n - s, which is also a valid signiture but not a low-S one.
+	Volt::CompactSigniture GetHighSSigniture(const Volt::CompactSigniture& signiture)
+	{
+		Volt::CompactSigniture highS = signiture;
+
+		int borrow = 0;
+		for (int i = 31; i >= 0; i--)
+		{
+			const int difference = curveOrder[i] - signiture[32 + i] - borrow;
+			highS[32 + i] = (uint8_t)difference;
+			borrow = difference < 0;
+		}
+
+		return highS;
+	}
+
+	// Returns TRUE if both backends agree on whether the signiture given is valid, 'isValid' is set to the OpenSSL result.
+	bool BackendsAgree(const std::vector<uint8_t>& message, const Volt::ECKeyPair& key,
+		const std::vector<uint8_t>& signiture, bool& isValid)
+	{
+		isValid = Verify(Volt::ECDSABackend::OPENSSL, message, key, signiture);
+		return Verify(Volt::ECDSABackend::NATIVE, message, key, signiture) == isValid;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::unique_ptr<Volt::ECKeyPair>> keys;
+	uint64_t mismatches = 0;
+
+	// Check that the native public key derivation matches OpenSSL's for keys generated by OpenSSL
+	for (size_t i = 0; i < keyCount; i++)
+	{
+		keys.emplace_back(std::make_unique<Volt::ECKeyPair>());
+
+		std::string privateKeyHex = keys[i]->GetPrivateKeyHex();
+		privateKeyHex.insert(0, SECP256K1_PRIVATE_KEY_LENGTH * 2 - privateKeyHex.size(), '0');
+
+		uint8_t privateKey[SECP256K1_PRIVATE_KEY_LENGTH], publicKey[SECP256K1_COMPRESSED_PUBLIC_KEY_LENGTH];
+		Volt::ConvertHexToByteData(privateKeyHex.data(), privateKeyHex.size(), privateKey);
+
+		if (Volt::GetSecp256k1PublicKey(privateKey, publicKey) ||
+			"VPK_" + Volt::ConvertByteToHexData(std::vector<uint8_t>(publicKey, publicKey + sizeof(publicKey))) !=
+			keys[i]->GetPublicKeyHex())
+			mismatches++;
+	}
+
+	std::cout << "[Public Key Derivation]: " << (mismatches == 0 ? "Passed" : "FAILED") << std::endl;
+
+	// Sign random messages with both backends, and make sure both backends agree on every signiture along with tampered
+	// messages, keys and signitures
+	uint64_t checks = 0, validSignitures = 0;
+	for (uint32_t i = 0; i < messageCount; i++)
+	{
+		const Volt::ECKeyPair& key = *keys[i % keyCount];
+		const Volt::ECKeyPair& otherKey = *keys[(i + 1) % keyCount];
+		const std::vector<uint8_t> message = GetRandomMessage(1 + (i % 200));
+
+		for (Volt::ECDSABackend backend : { Volt::ECDSABackend::OPENSSL, Volt::ECDSABackend::NATIVE })
+		{
+			const std::vector<uint8_t> signiture = Sign(backend, message, key);
+			bool isValid;
+
+			// The untouched signiture must be valid
+			checks++;
+			if (!BackendsAgree(message, key, signiture, isValid) || !isValid)
+				mismatches++;
+
+			// A different message or key must be rejected
+			std::vector<uint8_t> tamperedMessage = message;
+			tamperedMessage[Volt::GenerateRandomUint64(0, message.size() - 1)] ^=
+				(uint8_t)(1 << Volt::GenerateRandomUint64(0, 7));
+
+			checks += 2;
+			if (!BackendsAgree(tamperedMessage, key, signiture, isValid) || isValid)
+				mismatches++;
+			if (!BackendsAgree(message, otherKey, signiture, isValid) || isValid)
+				mismatches++;
+
+			// Corrupted and truncated signitures must be judged the same by both backends (a corrupted DER header can
+			// still leave a valid signiture in rare cases, so only agreement is checked)
+			std::vector<uint8_t> corruptedSigniture = signiture;
+			corruptedSigniture[Volt::GenerateRandomUint64(0, signiture.size() - 1)] ^=
+				(uint8_t)(1 << Volt::GenerateRandomUint64(0, 7));
+
+			const std::vector<uint8_t> truncatedSigniture(signiture.begin(),
+				signiture.begin() + Volt::GenerateRandomUint64(0, signiture.size() - 1));
+
+			checks += 2;
+			if (!BackendsAgree(message, key, corruptedSigniture, isValid))
+				mismatches++;
+			validSignitures += isValid;
+
+			if (!BackendsAgree(message, key, truncatedSigniture, isValid))
+				mismatches++;
+			validSignitures += isValid;
+		}
+	}
+
+	std::cout << "[Differential Test]: " << (mismatches == 0 ? "Passed" : "FAILED") << " (" << checks << " checks, " <<
+		mismatches << " mismatches, " << validSignitures << " corrupted signitures still valid)" << std::endl << std::endl;
+
+	// Compact signitures from either backend must be low-S and valid for both backends, the native backend's signitures are
+	// deterministic so its DER signiture must convert into the same compact signiture. High-S signitures must be rejected
+	uint64_t compactMismatches = 0;
+	for (uint32_t i = 0; i < messageCount; i++)
+	{
+		const Volt::ECKeyPair& key = *keys[i % keyCount];
+		const std::vector<uint8_t> message = GetRandomMessage(1 + (i % 200));
+
+		for (Volt::ECDSABackend backend : { Volt::ECDSABackend::OPENSSL, Volt::ECDSABackend::NATIVE })
+		{
+			const Volt::CompactSigniture signiture = SignCompact(backend, message, key);
+			const Volt::CompactSigniture highSSigniture = GetHighSSigniture(signiture);
+
+			Volt::SignitureBuffer derSigniture;
+			Volt::CompactSigniture convertedSigniture;
+
+			if (!VerifyCompact(Volt::ECDSABackend::OPENSSL, message, key, signiture) ||
+				!VerifyCompact(Volt::ECDSABackend::NATIVE, message, key, signiture) ||
+				VerifyCompact(Volt::ECDSABackend::OPENSSL, message, key, highSSigniture) ||
+				VerifyCompact(Volt::ECDSABackend::NATIVE, message, key, highSSigniture) ||
+				Volt::ConvertCompactSignitureToDER(signiture, derSigniture) ||
+				Volt::ConvertDERToCompactSigniture(derSigniture.data.data(), derSigniture.length, convertedSigniture) ||
+				convertedSigniture != signiture)
+				compactMismatches++;
+		}
+
+		const std::vector<uint8_t> nativeSigniture = Sign(Volt::ECDSABackend::NATIVE, message, key);
+
+		Volt::CompactSigniture convertedSigniture;
+		if (Volt::ConvertDERToCompactSigniture(nativeSigniture.data(), nativeSigniture.size(), convertedSigniture) ||
+			convertedSigniture != SignCompact(Volt::ECDSABackend::NATIVE, message, key))
+			compactMismatches++;
+	}
+
+	std::cout << "[Compact Signitures]: " << (compactMismatches == 0 ? "Passed" : "FAILED") << std::endl << std::endl;
+	mismatches += compactMismatches;
+
+	// Benchmark both backends on one thread, so the results are per core
+	const std::vector<uint8_t> benchmarkMessage = GetRandomMessage(SHA_256_DIGEST_LENGTH);
+	std::vector<std::vector<uint8_t>> signitures(benchmarkCount);
+
+	for (Volt::ECDSABackend backend : { Volt::ECDSABackend::OPENSSL, Volt::ECDSABackend::NATIVE })
+	{
+		Volt::SetECDSABackend(backend);
+
+		auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < benchmarkCount; i++)
+			Volt::GetSignedSHA256Digest(benchmarkMessage, *keys[i % keyCount], signitures[i]);
+
+		const double signSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		uint32_t validCount = 0;
+
+		startTime = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < benchmarkCount; i++)
+			validCount += !Volt::VerifySHA256Digest(benchmarkMessage, *keys[i % keyCount], signitures[i]);
+
+		const double verifySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "[" << GetBackendName(backend) << "]: " << (uint64_t)(benchmarkCount / signSeconds) <<
+			" signitures generated/s, " << (uint64_t)(benchmarkCount / verifySeconds) << " signitures verified/s per core (" <<
+			validCount << "/" << benchmarkCount << " valid)" << std::endl;
+
+		// The same again with compact signitures, which skip DER parsing on the native backend
+		std::vector<Volt::CompactSigniture> compactSignitures(benchmarkCount);
+
+		startTime = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < benchmarkCount; i++)
+			Volt::GetSignedSHA256Digest(benchmarkMessage.data(), benchmarkMessage.size(), *keys[i % keyCount],
+				compactSignitures[i]);
+
+		const double compactSignSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		validCount = 0;
+
+		startTime = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < benchmarkCount; i++)
+			validCount += !Volt::VerifySHA256Digest(benchmarkMessage.data(), benchmarkMessage.size(), *keys[i % keyCount],
+				compactSignitures[i]);
+
+		const double compactVerifySeconds =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "[" << GetBackendName(backend) << " Compact]: " << (uint64_t)(benchmarkCount / compactSignSeconds) <<
+			" signitures generated/s, " << (uint64_t)(benchmarkCount / compactVerifySeconds) <<
+			" signitures verified/s per core (" << validCount << "/" << benchmarkCount << " valid)" << std::endl;
+	}
+
+	std::cout << std::endl << "[Backends Agree]: " << (mismatches == 0 ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return mismatches == 0 ? 0 : 1;
+}
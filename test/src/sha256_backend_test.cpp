@@ -0,0 +1,144 @@
+#include <util/data_conversion.h>
+#include <util/random_generation.h>
+#include <crypto/sha256.h>
+#include <iostream>
+#include <chrono>
+
+namespace
+{
+	// The largest random message length tested, this covers every padding case over several blocks.
+	constexpr size_t maxRandomMessageSize = 300;
+
+	// The number of random messages hashed by each backend.
+	constexpr uint32_t randomMessageCount = 4096;
+
+	// The size of the messages and number of digests generated when benchmarking each backend.
+	constexpr size_t benchmarkMessageSize = 256;
+	constexpr uint64_t benchmarkDigestCount = 1 << 18;
+
+	// A test vector from FIPS 180-2, the message is the string repeated the number of times given.
+	struct TestVector
+	{
+		std::string message;
+		size_t repeatCount;
+		std::string digestHex;
+	};
+
+	const TestVector testVectors[] = {
+		{ "abc", 1, "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD" },
+		{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+			"248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1" },
+		{ "a", 1000000, "CDC76E5C9914FB9281A1C7E284D73E67F1809A48A497200E046D39CCC7112CD0" }
+	};
+
+	const char* GetBackendName(Volt::SHA256Backend backend)
+	{
+		switch (backend)
+		{
+		case Volt::SHA256Backend::OPENSSL:
+			return "OpenSSL";
+		case Volt::SHA256Backend::SHA_NI:
+			return "SHA-NI";
+		default:
+			return "Scalar";
+		}
+	}
+
+	std::vector<uint8_t> GetRandomMessage(size_t messageSize)
+	{
+		std::vector<uint8_t> message(messageSize);
+		for (uint8_t& byte : message)
+			byte = (uint8_t)Volt::GenerateRandomUint64(0, UINT8_MAX);
+
+		return message;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Generate the random messages and their digests using OpenSSL, which the in-tree backends are checked against
+	std::vector<std::vector<uint8_t>> messages, expectedDigests(randomMessageCount);
+	Volt::SetSHA256Backend(Volt::SHA256Backend::OPENSSL);
+
+	for (uint32_t i = 0; i < randomMessageCount; i++)
+	{
+		messages.push_back(GetRandomMessage(1 + (i % maxRandomMessageSize)));
+		Volt::GetSHA256Digest(messages[i], expectedDigests[i]);
+	}
+
+	std::cout << "Best backend: " << GetBackendName(Volt::GetBestSHA256Backend()) << std::endl << std::endl;
+	bool allPassed = true;
+
+	for (Volt::SHA256Backend backend : { Volt::SHA256Backend::OPENSSL, Volt::SHA256Backend::SCALAR,
+		Volt::SHA256Backend::SHA_NI })
+	{
+		if (Volt::SetSHA256Backend(backend))
+		{
+			std::cout << "[" << GetBackendName(backend) << "]: Not supported" << std::endl;
+			continue;
+		}
+
+		uint64_t mismatches = 0;
+		std::vector<uint8_t> digest;
+
+		// Check the known answer test vectors
+		for (const TestVector& vector : testVectors)
+		{
+			std::string message;
+			for (size_t i = 0; i < vector.repeatCount; i++)
+				message += vector.message;
+
+			if (Volt::GetSHA256Digest(Volt::GetRawString(message), digest) ||
+				Volt::ConvertByteToHexData(digest) != vector.digestHex)
+				mismatches++;
+		}
+
+		// Check the random messages against the OpenSSL digests
+		for (uint32_t i = 0; i < randomMessageCount; i++)
+		{
+			if (Volt::GetSHA256Digest(messages[i], digest) || digest != expectedDigests[i])
+				mismatches++;
+		}
+
+		// Check the midstate path, which continues from the state after some whole blocks of the message
+		for (uint32_t i = 0; i < randomMessageCount; i++)
+		{
+			const std::vector<uint8_t>& message = messages[i];
+			const size_t prefixLength = (message.size() / SHA_256_BLOCK_LENGTH) * SHA_256_BLOCK_LENGTH;
+
+			Volt::SHA256Midstate midstate;
+			uint8_t midstateDigest[SHA_256_DIGEST_LENGTH];
+
+			if (Volt::GetSHA256Midstate(message.data(), prefixLength, midstate) ||
+				Volt::GetSHA256DigestFromMidstate(midstate, message.data() + prefixLength, message.size() - prefixLength,
+					midstateDigest) ||
+				!std::equal(expectedDigests[i].begin(), expectedDigests[i].end(), midstateDigest))
+				mismatches++;
+		}
+
+		allPassed &= (mismatches == 0);
+
+		// Benchmark the backend
+		const std::vector<uint8_t> benchmarkMessage = GetRandomMessage(benchmarkMessageSize);
+		uint32_t checksum = 0;
+
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < benchmarkDigestCount; i++)
+		{
+			Volt::GetSHA256Digest(benchmarkMessage, digest);
+			checksum += digest[0];
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		const double megabytesPerSecond = (benchmarkDigestCount * benchmarkMessageSize) / seconds / (1024 * 1024);
+
+		std::cout << "[" << GetBackendName(backend) << "]: " << (mismatches == 0 ? "Passed" : "FAILED") << " (" <<
+			mismatches << " mismatches), " << (uint64_t)(benchmarkDigestCount / seconds) << " digests/s, " <<
+			(uint64_t)megabytesPerSecond << " MB/s (checksum " << checksum << ")" << std::endl;
+	}
+
+	std::cout << std::endl << "[All Backends Valid]: " << (allPassed ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return allPassed ? 0 : 1;
+}
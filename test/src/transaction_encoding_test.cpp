@@ -0,0 +1,192 @@
+#include <core/transaction.h>
+#include <core/mem_pool.h>
+#include <util/random_generation.h>
+#include <util/timestamp.h>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	// The number of random transactions encoded and decoded.
+	constexpr uint32_t transactionCount = 1024;
+
+	// The number of times each transaction is converted when benchmarking.
+	constexpr uint32_t benchmarkRounds = 64;
+
+	// Keeps the results of the benchmarked conversions from being optimized away.
+	volatile uint64_t benchmarkSink = 0;
+
+	Volt::Amount GetRandomAmount()
+	{
+		return (Volt::Amount)Volt::GenerateRandomUint64(0, VOLT_MAX_AMOUNT);
+	}
+
+	// Returns a random signed transfer, mining reward or unsigned transfer.
+	Volt::Transaction GetRandomTransaction(const Volt::ECKeyPair& sender, const Volt::ECKeyPair& recipient, uint32_t index)
+	{
+		switch (index % 3)
+		{
+		case 0:
+			return Volt::CreateNewTransaction(GetRandomAmount(), GetRandomAmount(), sender, recipient);
+		case 1:
+			return Volt::Transaction(Volt::TransactionType::MINING_REWARD, Volt::GenerateRandomUint64(0, UINT64_MAX),
+				GetRandomAmount(), 0, Volt::GetTimeSinceEpoch(), "", recipient.GetPublicKeyHex());
+		default:
+			return Volt::Transaction(Volt::TransactionType::TRANSFER, Volt::GenerateRandomUint64(0, UINT64_MAX),
+				GetRandomAmount(), GetRandomAmount(), Volt::GenerateRandomUint64(0, UINT64_MAX), sender.GetPublicKeyHex(),
+				recipient.GetPublicKeyHex());
+		}
+	}
+
+	// Returns TRUE if the encoding given is rejected.
+	bool IsRejected(const std::vector<uint8_t>& encoding)
+	{
+		Volt::Transaction tx;
+		return Volt::DecodeTransaction(encoding.data(), encoding.size(), tx) != Volt::ErrorID::NONE;
+	}
+
+	// Checks the encoding of the transaction given, returns the number of failed checks.
+	uint64_t CheckTransaction(const Volt::Transaction& tx)
+	{
+		uint64_t failures = 0;
+
+		uint8_t encoding[VOLT_TRANSACTION_MAX_ENCODED_SIZE];
+		const size_t encodingLength = Volt::EncodeTransaction(tx, encoding);
+
+		// The transaction must decode back into the same transaction, and encode into the same bytes again
+		Volt::Transaction decodedTx;
+		size_t bytesRead = 0;
+
+		uint8_t reencoding[VOLT_TRANSACTION_MAX_ENCODED_SIZE];
+		if (encodingLength == 0 || Volt::DecodeTransaction(encoding, encodingLength, decodedTx, &bytesRead) ||
+			bytesRead != encodingLength || !(decodedTx == tx) || decodedTx.GetTxHash() != tx.GetTxHash() ||
+			Volt::EncodeTransaction(decodedTx, reencoding) != encodingLength ||
+			std::memcmp(encoding, reencoding, encodingLength) != 0)
+			failures++;
+
+		// Truncated encodings must be rejected
+		const std::vector<uint8_t> fullEncoding(encoding, encoding + encodingLength);
+		for (size_t length = 0; length < encodingLength; length++)
+			failures += !IsRejected(std::vector<uint8_t>(encoding, encoding + length));
+
+		// Data which follows the encoding must be left unread
+		std::vector<uint8_t> paddedEncoding = fullEncoding;
+		paddedEncoding.insert(paddedEncoding.end(), fullEncoding.begin(), fullEncoding.end());
+
+		if (Volt::DecodeTransaction(paddedEncoding.data(), paddedEncoding.size(), decodedTx, &bytesRead) ||
+			bytesRead != encodingLength)
+			failures++;
+
+		// A length which doesn't match the fields must be rejected
+		std::vector<uint8_t> malformedEncoding = fullEncoding;
+		malformedEncoding.push_back(0);
+		malformedEncoding[2]++;
+		failures += !IsRejected(malformedEncoding);
+
+		// Unknown versions and types, key lengths which aren't 0 or 33 and invalid amounts must be rejected
+		malformedEncoding = fullEncoding;
+		malformedEncoding[0] = VOLT_TRANSACTION_ENCODING_VERSION + 1;
+		if (Volt::DecodeTransaction(malformedEncoding.data(), malformedEncoding.size(), decodedTx) !=
+			Volt::ErrorID::TRANSACTION_ENCODING_VERSION_UNSUPPORTED)
+			failures++;
+
+		malformedEncoding = fullEncoding;
+		malformedEncoding[3] = 2;
+		failures += !IsRejected(malformedEncoding);
+
+		malformedEncoding = fullEncoding;
+		malformedEncoding[36] = (uint8_t)(malformedEncoding[36] == 0 ? 1 : malformedEncoding[36] - 1);
+		failures += !IsRejected(malformedEncoding);
+
+		const uint8_t negativeAmount[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+		malformedEncoding = fullEncoding;
+		std::copy(std::begin(negativeAmount), std::end(negativeAmount), malformedEncoding.begin() + 20);
+		failures += !IsRejected(malformedEncoding);
+
+		const uint8_t excessiveAmount[8] = { 0x7F, 0xF8, 0, 0, 0, 0, 0, 0 };
+		malformedEncoding = fullEncoding;
+		std::copy(std::begin(excessiveAmount), std::end(excessiveAmount), malformedEncoding.begin() + 28);
+		failures += !IsRejected(malformedEncoding);
+
+		return failures;
+	}
+
+	// Prints the average time taken by the conversion given for each transaction, along with the average size.
+	template<typename ConversionFunction>
+	void Benchmark(const char* name, const std::vector<Volt::Transaction>& txs, ConversionFunction convert)
+	{
+		uint64_t totalBytes = 0;
+
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t round = 0; round < benchmarkRounds; round++)
+		{
+			for (uint32_t i = 0; i < txs.size(); i++)
+				totalBytes += convert(i);
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		const uint64_t conversions = (uint64_t)benchmarkRounds * txs.size();
+
+		std::cout << "[" << name << "]: " << std::fixed << std::setprecision(1) << (double)totalBytes / conversions <<
+			" bytes, " << seconds * 1e9 / conversions << " ns/op" << std::endl;
+
+		benchmarkSink = totalBytes;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Volt::ECKeyPair sender, recipient;
+
+	std::vector<Volt::Transaction> txs;
+	txs.reserve(transactionCount);
+
+	uint64_t failures = 0;
+	for (uint32_t i = 0; i < transactionCount; i++)
+	{
+		txs.emplace_back(GetRandomTransaction(sender, recipient, i));
+		failures += CheckTransaction(txs.back());
+	}
+
+	std::cout << "[Encoding Round Trips]: " << (failures == 0 ? "Passed" : "FAILED") << std::endl << std::endl;
+
+	// Compare the binary encoding with the JSON the transactions were relayed as before, binary decoding includes
+	// generating the transaction's hash while JSON keeps the hash given (it's checked when the transaction is verified)
+	std::vector<std::string> jsonTxs(txs.size());
+	std::vector<std::vector<uint8_t>> encodedTxs(txs.size(), std::vector<uint8_t>(VOLT_TRANSACTION_MAX_ENCODED_SIZE));
+
+	Benchmark("JSON Serialize", txs, [&](uint32_t i)
+	{
+		jsonTxs[i] = Volt::SerializeTransaction(txs[i]);
+		return (uint64_t)jsonTxs[i].size();
+	});
+
+	Benchmark("Binary Encode", txs, [&](uint32_t i)
+	{
+		return (uint64_t)Volt::EncodeTransaction(txs[i], encodedTxs[i].data());
+	});
+
+	Benchmark("JSON Parse", txs, [&](uint32_t i)
+	{
+		json::error_code ec;
+		const Volt::Transaction tx = json::value_to<Volt::Transaction>(json::parse(jsonTxs[i], ec));
+
+		return (uint64_t)jsonTxs[i].size();
+	});
+
+	Benchmark("Binary Decode", txs, [&](uint32_t i)
+	{
+		Volt::Transaction tx;
+		size_t bytesRead = 0;
+		Volt::DecodeTransaction(encodedTxs[i].data(), encodedTxs[i].size(), tx, &bytesRead);
+
+		return (uint64_t)bytesRead;
+	});
+
+	std::cout << std::endl << "[All Encodings Correct]: " << (failures == 0 ? "Yes" : "No") << std::endl;
+
+	std::cin.get();
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#include <core/amount.h>
+
+#include <cmath>
+
+namespace Volt
+{
+	Amount ConvertCoinsToAmount(double coins)
+	{
+		const double units = std::round(coins * VOLT_AMOUNT_UNITS_PER_COIN);
+		if (!(units >= 0 && units <= (double)VOLT_MAX_AMOUNT))
+			return -1;
+
+		return (Amount)units;
+	}
+
+	std::string ConvertAmountToString(Amount amount)
+	{
+		// The magnitude is taken as unsigned so the smallest amount doesn't overflow when negated
+		const uint64_t magnitude = amount < 0 ? 0 - (uint64_t)amount : (uint64_t)amount;
+		std::string string = (amount < 0 ? "-" : "") + std::to_string(magnitude / VOLT_AMOUNT_UNITS_PER_COIN);
+
+		std::string fraction = std::to_string(magnitude % VOLT_AMOUNT_UNITS_PER_COIN);
+		if (fraction == "0")
+			return string;
+
+		fraction.insert(0, VOLT_AMOUNT_DECIMAL_PLACES - fraction.size(), '0');
+		fraction.erase(fraction.find_last_not_of('0') + 1);
+
+		return string + "." + fraction;
+	}
+}
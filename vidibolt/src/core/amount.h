@@ -0,0 +1,40 @@
+#ifndef VIDIBOLT_CORE_AMOUNT_H
+#define VIDIBOLT_CORE_AMOUNT_H
+
+#include <util/volt_api.h>
+
+#include <cstdint>
+#include <string>
+
+// The number of base units in one coin, and the number of decimal places that gives to amounts given in coins.
+#define VOLT_AMOUNT_UNITS_PER_COIN 100000000
+#define VOLT_AMOUNT_DECIMAL_PLACES 8
+
+// The largest amount (in base units) a transaction can transfer or pay as a fee, which is one billion coins. It's small
+// enough that the amounts and fees of every transaction in a block can be summed without overflowing.
+#define VOLT_MAX_AMOUNT 100000000000000000
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// An amount of coins held as a whole number of base units (see 'VOLT_AMOUNT_UNITS_PER_COIN'), so amounts are summed
+	// and compared exactly. Coins are only used when amounts are given by or displayed to the user.
+	using Amount = int64_t;
+
+	// Returns TRUE if the amount given can be transferred or paid as a fee, which is between 0 and 'VOLT_MAX_AMOUNT'.
+	inline bool IsAmountValid(Amount amount)
+	{
+		return amount >= 0 && amount <= VOLT_MAX_AMOUNT;
+	}
+
+	// Returns the amount closest to the number of coins given, -1 is returned if the number of coins isn't a valid amount.
+	extern VOLT_API Amount ConvertCoinsToAmount(double coins);
+
+	// Returns the amount given in coins as a decimal string without trailing zeros e.g. "12.5", "-0.00000001" and "30".
+	extern VOLT_API std::string ConvertAmountToString(Amount amount);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
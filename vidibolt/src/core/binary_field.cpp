@@ -0,0 +1,99 @@
+#include <core/binary_field.h>
+#include <util/data_conversion.h>
+
+namespace
+{
+	// Decodes the upper case hex given into the binary field, the hex must be exactly twice as long as the field.
+	// Lower case hex is treated as malformed, since the hex of a field must always be the same for the same value.
+	template<typename Ty> void ConvertCanonicalHex(const char* hex, size_t hexLength, Volt::BinaryField<Ty>& field)
+	{
+		field.state = Volt::BinaryFieldState::MALFORMED;
+		if (hexLength != field.data.size() * 2 ||
+			std::any_of(hex, hex + hexLength, [](char c) { return c >= 'a' && c <= 'f'; }) ||
+			!Volt::ConvertHexToByteData(hex, hexLength, field.data.data()))
+		{
+			field.data.fill(0);
+			return;
+		}
+
+		field.state = Volt::BinaryFieldState::VALID;
+	}
+
+	// Returns the upper case hex of the binary field given, an empty string is returned if the field isn't valid.
+	template<typename Ty> std::string ConvertFieldToHex(const Volt::BinaryField<Ty>& field)
+	{
+		if (field.state != Volt::BinaryFieldState::VALID)
+			return std::string();
+
+		std::string hex(field.data.size() * 2, '0');
+		Volt::ConvertByteToHexData(field.data.data(), field.data.size(), &hex[0]);
+
+		return hex;
+	}
+}
+
+namespace Volt
+{
+	PublicKeyField ConvertHexToPublicKeyField(const std::string& hex)
+	{
+		PublicKeyField key = {};
+		if (hex.empty())
+			return key;
+
+		if (hex.compare(0, VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH, VOLT_PUBLIC_KEY_HEX_PREFIX) != 0)
+		{
+			key.state = BinaryFieldState::MALFORMED;
+			return key;
+		}
+
+		ConvertCanonicalHex(hex.data() + VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH, hex.size() - VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH,
+			key);
+
+		return key;
+	}
+
+	size_t ConvertPublicKeyFieldToHex(const PublicKeyField& key, char* hexOutput)
+	{
+		if (key.state != BinaryFieldState::VALID)
+			return 0;
+
+		std::copy_n(VOLT_PUBLIC_KEY_HEX_PREFIX, VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH, hexOutput);
+		Volt::ConvertByteToHexData(key.data.data(), key.data.size(), hexOutput + VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH);
+
+		return VOLT_PUBLIC_KEY_HEX_LENGTH;
+	}
+
+	std::string ConvertPublicKeyFieldToHex(const PublicKeyField& key)
+	{
+		char hex[VOLT_PUBLIC_KEY_HEX_LENGTH];
+		return std::string(hex, Volt::ConvertPublicKeyFieldToHex(key, hex));
+	}
+
+	DigestField ConvertHexToDigestField(const char* hex, size_t hexLength)
+	{
+		DigestField digest = {};
+		if (hexLength > 0)
+			ConvertCanonicalHex(hex, hexLength, digest);
+
+		return digest;
+	}
+
+	std::string ConvertDigestFieldToHex(const DigestField& digest)
+	{
+		return ConvertFieldToHex(digest);
+	}
+
+	SignitureField ConvertHexToSignitureField(const std::string& hex)
+	{
+		SignitureField signiture = {};
+		if (!hex.empty())
+			ConvertCanonicalHex(hex.data(), hex.size(), signiture);
+
+		return signiture;
+	}
+
+	std::string ConvertSignitureFieldToHex(const SignitureField& signiture)
+	{
+		return ConvertFieldToHex(signiture);
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef VIDIBOLT_CORE_BINARY_FIELD_H
+#define VIDIBOLT_CORE_BINARY_FIELD_H
+
+#include <util/volt_api.h>
+#include <crypto/sha256.h>
+#include <crypto/public_key_cache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+// The prefix of public keys given in hex, and the length of the whole hex string (prefix included).
+#define VOLT_PUBLIC_KEY_HEX_PREFIX "VPK_"
+#define VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH 4
+#define VOLT_PUBLIC_KEY_HEX_LENGTH (VOLT_PUBLIC_KEY_HEX_PREFIX_LENGTH + EC_COMPRESSED_PUBLIC_KEY_LENGTH * 2)
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// An enumeration that represents the state of a binary field which is given as hex at the JSON and display boundary.
+	enum class BinaryFieldState : uint8_t
+	{
+		EMPTY,    // The field was given as an empty string
+		VALID,    // The field holds the value given
+		MALFORMED // The hex given wasn't in the canonical form, the field can never be valid
+	};
+
+	// A fixed size binary field along with its state, value initialized fields are empty.
+	template<typename Ty> struct BinaryField
+	{
+		Ty data;
+		BinaryFieldState state;
+	};
+
+	// A compressed public key, given in hex as 'VOLT_PUBLIC_KEY_HEX_PREFIX' followed by the upper case hex of the key.
+	using PublicKeyField = BinaryField<CompressedPublicKey>;
+
+	// A hash digest, given in hex as the upper case hex of the digest.
+	using DigestField = BinaryField<SHA256Digest>;
+
+	// A compact signiture, given in hex as the upper case hex of the signiture.
+	using SignitureField = BinaryField<CompactSigniture>;
+
+	template<typename Ty> bool operator==(const BinaryField<Ty>& lhs, const BinaryField<Ty>& rhs)
+	{
+		return std::memcmp(lhs.data.data(), rhs.data.data(), lhs.data.size()) == 0 && lhs.state == rhs.state;
+	}
+
+	template<typename Ty> bool operator!=(const BinaryField<Ty>& lhs, const BinaryField<Ty>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the public key field parsed from the hex given.
+	extern VOLT_API PublicKeyField ConvertHexToPublicKeyField(const std::string& hex);
+
+	// Writes the hex of the public key field given into 'hexOutput' without a null terminator.
+	// Returns the number of characters written, which is 'VOLT_PUBLIC_KEY_HEX_LENGTH' for valid keys and 0 otherwise.
+	extern VOLT_API size_t ConvertPublicKeyFieldToHex(const PublicKeyField& key, char* hexOutput);
+
+	// Returns the hex of the public key field given, an empty string is returned if the key isn't valid.
+	extern VOLT_API std::string ConvertPublicKeyFieldToHex(const PublicKeyField& key);
+
+	// Returns the digest field parsed from the hex given.
+	extern VOLT_API DigestField ConvertHexToDigestField(const char* hex, size_t hexLength);
+
+	// Returns the hex of the digest field given, an empty string is returned if the digest isn't valid.
+	extern VOLT_API std::string ConvertDigestFieldToHex(const DigestField& digest);
+
+	// Returns the signiture field parsed from the hex given.
+	extern VOLT_API SignitureField ConvertHexToSignitureField(const std::string& hex);
+
+	// Returns the hex of the signiture field given, an empty string is returned if the signiture isn't valid.
+	extern VOLT_API std::string ConvertSignitureFieldToHex(const SignitureField& signiture);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -2,10 +2,29 @@
 #include <core/chain.h>
 #include <core/mem_pool.h>
 #include <core/hash_stats.h>
+#include <core/nonce_partition.h>
 #include <crypto/sha256.h>
+#include <crypto/sha256_kernel.h>
 #include <util/random_generation.h>
 #include <util/timestamp.h>
 
+#include <atomic>
+#include <thread>
+
+namespace
+{
+	// The offsets of the fields in the block header which lie outside of the midstate.
+	constexpr uint32_t headerTimestampOffset = 80, headerExtraNonceOffset = 88;
+	constexpr uint32_t headerNonceOffset = VOLT_BLOCK_HEADER_SIZE - sizeof(uint64_t);
+
+	// Writes the unsigned integer given into the buffer in big-endian byte order.
+	template<typename Ty> void WriteBigEndian(uint8_t* buffer, Ty value)
+	{
+		for (size_t i = 0; i < sizeof(Ty); i++)
+			buffer[i] = (uint8_t)(value >> (8 * (sizeof(Ty) - 1 - i)));
+	}
+}
+
 namespace Volt
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -14,22 +33,68 @@ namespace Volt
 	{
 	public:
 		uint32_t index;
-		uint64_t timestamp, difficulty, nonce;
-		std::string previousHash, hash;
+		uint64_t timestamp, difficulty, nonce, extraNonce;
+		DigestField previousHash, hash;
 		Vector<Transaction> txs;
+		MerkleTree txsMerkleTree;
 	public:
 		Implementation() :
-			index(0), timestamp(0), nonce(0), difficulty(0)
+			index(0), timestamp(0), nonce(0), extraNonce(0), difficulty(0), previousHash(), hash()
 		{}
 
-		Implementation(uint32_t index, uint64_t timestamp, const std::string& prevHash, 
-			const Vector<Transaction>& txs, const std::string& blockHash, uint64_t difficulty, 
-			uint64_t nonce) :
-			index(index), timestamp(timestamp), previousHash(prevHash), txs(txs), hash(blockHash), nonce(nonce), 
-			difficulty(difficulty)
-		{}
+		Implementation(const Implementation& impl) = default;
+
+		// The transactions are taken by value so blocks created from a temporary list of transactions can move it in.
+		Implementation(uint32_t index, uint64_t timestamp, const DigestField& prevHash, 
+			Vector<Transaction> txs, const DigestField& blockHash, uint64_t difficulty, 
+			uint64_t nonce, uint64_t extraNonce) :
+			index(index), timestamp(timestamp), previousHash(prevHash), txs(std::move(txs)), hash(blockHash), nonce(nonce), 
+			extraNonce(extraNonce), difficulty(difficulty)
+		{
+			// Build the merkle tree from the hashes of the transactions
+			std::vector<MerkleHash> leaves;
+			leaves.reserve(this->txs.GetSize());
+
+			for (const Transaction& tx : this->txs.GetVectorObject())
+				leaves.emplace_back(Volt::GetTransactionLeafHash(tx));
+
+			this->txsMerkleTree = MerkleTree(leaves);
+		}
 
 		~Implementation() = default;
+
+		// Appends the transaction to the block, the merkle tree is updated along the way.
+		void AddTransaction(const Transaction& tx)
+		{
+			this->txs.EmplaceBackElement(tx);
+			this->txsMerkleTree.AppendLeaf(Volt::GetTransactionLeafHash(tx));
+		}
+
+		// Removes the transaction at the index specified from the block, the merkle tree is updated along the way.
+		void RemoveTransaction(size_t index)
+		{
+			this->txs.EraseElementAtIndex(index);
+			this->txsMerkleTree.RemoveLeaf(index);
+		}
+
+		// Writes the binary header of the block into the buffer given.
+		void WriteHeader(uint8_t* header) const
+		{
+			std::fill(header, header + VOLT_BLOCK_HEADER_SIZE, (uint8_t)0);
+
+			WriteBigEndian<uint32_t>(header, VOLT_BLOCK_HEADER_VERSION);
+			WriteBigEndian<uint32_t>(header + 4, this->index);
+
+			// The genesis block has no previous hash, so the field is left zeroed for it
+			std::copy(this->previousHash.data.begin(), this->previousHash.data.end(), header + 8);
+
+			const MerkleHash& merkleRoot = this->txsMerkleTree.GetRoot();
+			std::copy(merkleRoot.begin(), merkleRoot.end(), header + 40);
+			WriteBigEndian<uint64_t>(header + 72, this->difficulty);
+			WriteBigEndian<uint64_t>(header + headerTimestampOffset, this->timestamp);
+			WriteBigEndian<uint64_t>(header + headerExtraNonceOffset, this->extraNonce);
+			WriteBigEndian<uint64_t>(header + headerNonceOffset, this->nonce);
+		}
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -39,45 +104,65 @@ namespace Volt
 	{}
 
 	Block::Block(const Block& block) :
-		impl(std::make_unique<Implementation>(block.GetIndex(), block.GetTimestamp(), block.GetPreviousBlockHash(),
-			block.GetTransactions(), block.GetBlockHash(), block.GetDifficulty(), block.GetNonce()))
+		impl(std::make_unique<Implementation>(*block.impl))
 	{}
 
 	Block::Block(uint32_t index, const std::string& prevHash, const Vector<Transaction>& txs, 
-		uint64_t difficulty, const std::string& blockHash, uint64_t timestamp, uint64_t nonce) :
-		impl(std::make_unique<Implementation>(index, timestamp, prevHash, txs, blockHash, difficulty, nonce))
+		uint64_t difficulty, const std::string& blockHash, uint64_t timestamp, uint64_t nonce, uint64_t extraNonce) :
+		impl(std::make_unique<Implementation>(index, timestamp, Volt::ConvertHexToDigestField(prevHash.data(), prevHash.size()),
+			txs, Volt::ConvertHexToDigestField(blockHash.data(), blockHash.size()), difficulty, nonce, extraNonce))
+	{}
+
+	Block::Block(uint32_t index, const DigestField& prevHash, const Vector<Transaction>& txs, uint64_t difficulty,
+		const DigestField& blockHash, uint64_t timestamp, uint64_t nonce, uint64_t extraNonce) :
+		impl(std::make_unique<Implementation>(index, timestamp, prevHash, txs, blockHash, difficulty, nonce, extraNonce))
+	{}
+
+	Block::Block(uint32_t index, const DigestField& prevHash, Vector<Transaction>&& txs, uint64_t difficulty,
+		const DigestField& blockHash, uint64_t timestamp, uint64_t nonce, uint64_t extraNonce) :
+		impl(std::make_unique<Implementation>(index, timestamp, prevHash, std::move(txs), blockHash, difficulty, nonce,
+			extraNonce))
+	{}
+
+	Block::Block(Block&& block) noexcept :
+		impl(std::move(block.impl))
 	{}
 
 	Block::~Block() = default;
 
 	void Block::operator=(const Block& block)
 	{
-		this->impl = std::make_unique<Implementation>(block.GetIndex(), block.GetTimestamp(), block.GetPreviousBlockHash(),
-			block.GetTransactions(), block.GetBlockHash(), block.GetDifficulty(), block.GetNonce());
+		this->impl = std::make_unique<Implementation>(*block.impl);
 	}
 
-	ErrorCode Block::GenerateBlockHash(std::string& outputBlockHash) const
+	void Block::operator=(Block&& block) noexcept
 	{
-		// Combine the data of all transactions into one string of data
-		std::string combinedTxsData;
-		for (uint32_t index = 0; index < this->impl->txs.GetSize(); index++)
-			combinedTxsData += Volt::SerializeTransaction(this->impl->txs[index]);
-
-		// Combine all block data into one string, then convert string data into byte vector array
-		const std::string blockData = std::to_string(this->impl->index) + std::to_string(this->impl->nonce) + 
-			this->impl->previousHash + combinedTxsData;
+		this->impl = std::move(block.impl);
+	}
 
-		const std::vector<uint8_t> rawBlockData = Volt::GetRawString(blockData);
+	ErrorCode Block::GenerateBlockHash(std::string& outputBlockHash) const
+	{
+		// Generate the hash from the binary header of the block
+		const BlockHeader header = this->GetHeader();
 
-		// Generate the hash
-		std::vector<uint8_t> rawHashDigest;
-		ErrorCode error = Volt::GetSHA256Digest(rawBlockData, rawHashDigest);
-		if (!error)
-			outputBlockHash = Volt::ConvertByteToHexData(rawHashDigest); // The block hash was successfully generated
+		SHA256Digest rawHashDigest;
+		ErrorCode error = Volt::GetSHA256Digest(header.data(), header.size(), rawHashDigest);
+		if (!error) // The block hash was successfully generated
+		{
+			outputBlockHash.resize(SHA_256_DIGEST_LENGTH_HEX);
+			Volt::ConvertByteToHexData(rawHashDigest.data(), rawHashDigest.size(), &outputBlockHash[0]);
+		}
 
 		return error;
 	}
 
+	BlockHeader Block::GetHeader() const
+	{
+		BlockHeader header;
+		this->impl->WriteHeader(header.data());
+		return header;
+	}
+
 	const uint32_t& Block::GetIndex() const
 	{
 		return this->impl->index;
@@ -98,12 +183,27 @@ namespace Volt
 		return this->impl->nonce;
 	}
 
-	const std::string& Block::GetPreviousBlockHash() const
+	const uint64_t& Block::GetExtraNonce() const
+	{
+		return this->impl->extraNonce;
+	}
+
+	std::string Block::GetPreviousBlockHash() const
+	{
+		return Volt::ConvertDigestFieldToHex(this->impl->previousHash);
+	}
+
+	std::string Block::GetBlockHash() const
+	{
+		return Volt::ConvertDigestFieldToHex(this->impl->hash);
+	}
+
+	const DigestField& Block::GetPreviousBlockHashField() const
 	{
 		return this->impl->previousHash;
 	}
 
-	const std::string& Block::GetBlockHash() const
+	const DigestField& Block::GetBlockHashField() const
 	{
 		return this->impl->hash;
 	}
@@ -113,34 +213,68 @@ namespace Volt
 		return this->impl->txs;
 	}
 
+	const MerkleHash& Block::GetMerkleRoot() const
+	{
+		return this->impl->txsMerkleTree.GetRoot();
+	}
+
+	ErrorCode Block::GenerateTransactionProof(const std::string& txHash, std::vector<MerkleProofStep>& proof) const
+	{
+		// The digests are compared first so the hash strings are only generated for the matching transaction
+		const DigestField txDigest = Volt::ConvertHexToDigestField(txHash.data(),
+			std::min(txHash.size(), (size_t)SHA_256_DIGEST_LENGTH_HEX));
+
+		for (uint32_t index = 0; index < this->impl->txs.GetSize(); index++)
+		{
+			const Transaction& tx = this->impl->txs[index];
+			if (tx.GetTxDigestField() == txDigest && tx.GetTxHash() == txHash)
+				return this->impl->txsMerkleTree.GenerateProof(index, proof);
+		}
+
+		return ErrorID::TRANSACTION_NOT_FOUND;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	ErrorCode VerifyBlock(const Block& block, const Chain& chain)
 	{
+		// Verify the hash and signiture of every transaction contained in parallel
+		const std::vector<Transaction>& txs = block.impl->txs.GetVectorObject();
+
+		std::vector<const Transaction*> txBatch;
+		txBatch.reserve(txs.size());
+
+		for (const Transaction& tx : txs)
+			txBatch.emplace_back(&tx);
+
+		ErrorCode error = Volt::VerifyTransactionsBatch(txBatch);
+		if (error)
+			return error;
+
+		return Volt::VerifyBlockStructure(block, chain);
+	}
+
+	ErrorCode VerifyBlockStructure(const Block& block, const Chain& chain)
+	{
+		const Vector<Transaction>& txs = block.GetTransactions();
 		const Transaction* miningRewardTx = nullptr;
-		double totalFees = 0;
+		uint64_t totalFees = 0; // Summed as unsigned so the sum is well defined however many transactions the block holds
 
-		// Check that all the transactions contained are valid
-		for (uint32_t index = 0; index < block.impl->txs.GetSize(); index++)
+		// Get the mining reward transaction and the total fees paid for the next verification step
+		for (uint32_t index = 0; index < txs.GetSize(); index++)
 		{
-			const Transaction& tx = block.impl->txs[index];
-
-			// Get the mining reward transaction for the next block verification step
+			const Transaction& tx = txs[index];
 			if (tx.GetType() == TransactionType::MINING_REWARD)
 				miningRewardTx = &tx;
 
-			// Verify the transaction hash and signiture
-			ErrorCode error = Volt::VerifyTransaction(tx);
-			if (error)
-				return error;
-
-			totalFees += tx.GetFee();
+			totalFees += (uint64_t)tx.GetFee();
 		}
 
 		// Check that the mining reward transaction rewards the right amount of coins
 		if (miningRewardTx)
 		{
-			if (miningRewardTx->GetAmount() != (chain.GetMiningRewardAmount(block.GetIndex()) + totalFees))
+			const uint64_t miningReward = (uint64_t)chain.GetMiningRewardAmount(block.GetIndex()) + totalFees;
+			if ((uint64_t)miningRewardTx->GetAmount() != miningReward)
 				return ErrorID::BLOCK_MINING_REWARD_INVALID;
 		}
 
@@ -151,12 +285,16 @@ namespace Volt
 		if (block.GetIndex() != 0)
 		{
 			const Block& prevBlock = chain.GetBlockAtIndexHeight(block.GetIndex() - 1);
-			if (block.GetPreviousBlockHash() != prevBlock.GetBlockHash())
+			if (block.GetPreviousBlockHashField() != prevBlock.GetBlockHashField())
 				return ErrorID::BLOCK_PREVIOUS_HASH_INVALID;
 
 			if (block.GetTimestamp() < prevBlock.GetTimestamp())
 				return ErrorID::BLOCK_TIMESTAMP_INVALID;
 
+			// Miners are allowed to roll the timestamp forward to get more search space, but only by a limited amount
+			if (block.GetTimestamp() > Volt::GetTimeSinceEpoch() + VOLT_MAX_BLOCK_TIMESTAMP_DRIFT)
+				return ErrorID::BLOCK_TIMESTAMP_INVALID;
+
 			if (block.GetIndex() != prevBlock.GetIndex() + 1)
 				return ErrorID::BLOCK_INDEX_INVALID;
 		}
@@ -168,33 +306,26 @@ namespace Volt
 		}
 
 		// Check that the hash of the block is valid
-		std::string hash;
-		ErrorCode error = block.GenerateBlockHash(hash);
-		if (error)
-			return error;
+		const BlockHeader header = block.GetHeader();
+		SHA256Digest rawHashDigest;
 
-		const std::string hashInput = hash + std::to_string(block.GetTimestamp());
-		std::vector<uint8_t> buffer = Volt::GetRawString(hashInput), finalHashBuffer;
-
-		error = Volt::GetSHA256Digest(buffer, finalHashBuffer);
+		ErrorCode error = Volt::GetSHA256Digest(header.data(), header.size(), rawHashDigest);
 		if (error)
 			return error;
 
-		if (block.GetBlockHash() != Volt::ConvertByteToHexData(finalHashBuffer))
+		const DigestField& blockHash = block.GetBlockHashField();
+		if (blockHash.state != BinaryFieldState::VALID || blockHash.data != rawHashDigest)
 			return ErrorID::BLOCK_HASH_INVALID;
 
 		// Check that the hash satisfies the difficulty of the block
-		bool difficultyOK = true;
-		for (size_t i = 0; i < block.GetDifficulty(); i++)
+		uint32_t digestWords[8];
+		for (size_t i = 0; i < 8; i++)
 		{
-			if (hash[i] != '0')
-			{
-				difficultyOK = false;
-				break;
-			}
+			digestWords[i] = ((uint32_t)rawHashDigest[i * 4] << 24) | ((uint32_t)rawHashDigest[i * 4 + 1] << 16) |
+				((uint32_t)rawHashDigest[i * 4 + 2] << 8) | (uint32_t)rawHashDigest[i * 4 + 3];
 		}
 
-		if (!difficultyOK)
+		if (!Volt::DigestMeetsTarget(digestWords, Volt::GetDifficultyTarget(block.GetDifficulty())))
 			return ErrorID::BLOCK_HASH_DIFFICULTY_INSUFFICIENT;
 
 		return ErrorID::NONE;
@@ -224,21 +355,24 @@ namespace Volt
 		else // No custom handler function was given, so just get the transactions at the front of queue in the mempool
 			txs = Volt::PopTransactions(pool, VOLT_MAX_TRANSACTIONS_PER_BLOCK);
 
-		Block block(latestBlock.GetIndex() + 1, latestBlock.GetBlockHash(), txs, difficulty);
+		// The mining reward also includes the collected fees paid by the senders of the transactions in the block
+		Amount totalFees = 0;
+		for (const Transaction& tx : txs)
+			totalFees += tx.GetFee();
+
+		// The timestamp can't be earlier than the latest block's, which may have been rolled forward by its miner
+		const uint64_t timestamp = std::max(Volt::GetTimeSinceEpoch(), latestBlock.GetTimestamp());
+		Block block(latestBlock.GetIndex() + 1, latestBlock.GetBlockHashField(), Vector<Transaction>(std::move(txs)),
+			difficulty, DigestField(), timestamp, 0, Volt::GenerateRandomUint64(0, UINT64_MAX));
 
 		// Add mining reward transaction for the miner to the block 
-		// The mining reward also includes the collected fees paid by the senders of the transactions in the block
 		if (minerPublicKey)
 		{
-			double totalFees = 0;
-			for (const Transaction& tx : txs)
-				totalFees += tx.GetFee();
-
 			Transaction tx(TransactionType::MINING_REWARD, Volt::GenerateRandomUint64(0, UINT64_MAX),
 				chain.GetMiningRewardAmount() + totalFees, 0, Volt::GetTimeSinceEpoch(), "", 
 				minerPublicKey->GetPublicKeyHex());
 
-			block.impl->txs.EmplaceBackElement(tx);
+			block.impl->AddTransaction(tx);
 		}
 
 		return block;
@@ -250,121 +384,256 @@ namespace Volt
 		minedBlock = Volt::CreateBlock(pool, chain, difficulty, &minerPublicKey, txHandler);
 
 		// Start doing proof-of-work (find a hash that satisfies the block difficulty)
-		std::string generatedHash;
-		bool hashValid = false;
-		
-		Volt::StartHashRateRecord(minedBlock.GetNonce()); // Start recording the current hash rate
+		// The entire nonce range is searched, so a solution is practically guaranteed to be found
+		MiningResult result;
+		return Volt::MineNextBlock(minedBlock, 1, result);
+	}
+
+	ErrorCode MineNextBlock(Block& block, uint64_t nonceStart, uint64_t nonceEnd)
+	{
+		MiningResult result;
+		return Volt::MineNextBlock(block, 1, result, nonceStart, nonceEnd);
+	}
+
+	ErrorCode MineNextBlock(Block& block, uint32_t numThreads, MiningResult& result, uint64_t nonceStart, uint64_t nonceEnd)
+	{
+		// Make sure that the min nonce isn't larger than the max nonce
+		if (nonceStart > nonceEnd)
+			return ErrorID::NONCE_MIN_LARGER_THAN_NONCE_MAX;
+
+		if (numThreads == 0)
+			numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+		// Split the nonce range into a partition for each worker
+		std::vector<NoncePartition> partitions(numThreads);
+		Volt::AssignNoncePartitions(partitions, nonceStart, nonceEnd);
+
+		// The header midstate and final message block are the same for every nonce attempt, so only the final message block
+		// has to be hashed by the workers
+		NonceKernelInput kernelInput;
+		ErrorCode error = Volt::GetBlockNonceKernelInput(block, kernelInput);
+		if (error)
+			return error;
+
+		// The target is derived once, each worker only has to do a word-wise compare of the raw digests against it
+		const DifficultyTarget target = Volt::GetDifficultyTarget(block.GetDifficulty());
+
+		// Use the widest nonce search kernel supported by the CPU
+		const NonceKernel kernel = Volt::GetBestNonceKernel();
+		const uint32_t laneCount = Volt::GetNonceKernelLaneCount(kernel);
+
+		// State shared between all of the workers
+		std::atomic<bool> stopSearch = false;
+		uint64_t winningNonce = 0;
+		DigestField winningHash = {};
+
+		result = MiningResult();
+		result.hashCounts.resize(numThreads, 0);
 
-		while (!hashValid)
+		// The search done by each worker, starting with its own partition then moving onto the partitions of other workers
+		auto searchNonceRange = [&](uint32_t workerIndex)
 		{
-			// Generate a new hash
-			ErrorCode error = minedBlock.GenerateBlockHash(generatedHash);
-			if (error)
-				return error;
-
-			// Check if the hash is valid
-			hashValid = true;
-			for (size_t i = 0; i < difficulty; i++)
+			HashRateRecorder hashRateRecorder;
+			uint32_t digests[SHA_256_KERNEL_MAX_LANES][8];
+			uint64_t hashCount = 0, chunkStart = 0, chunkEnd = 0;
+
+			for (uint32_t offset = 0; offset < numThreads && !stopSearch.load(std::memory_order_relaxed); offset++)
 			{
-				if (generatedHash[i] != '0')
+				NoncePartition& partition = partitions[(workerIndex + offset) % numThreads];
+
+				while (!stopSearch.load(std::memory_order_relaxed) && partition.ClaimChunk(chunkStart, chunkEnd))
 				{
-					hashValid = false;
-					break;
+					const uint64_t chunkHashCountStart = hashCount;
+
+					for (uint64_t batchStart = chunkStart; ; batchStart += laneCount)
+					{
+						if (stopSearch.load(std::memory_order_relaxed))
+							break;
+
+						// Generate the hashes for the next batch of nonces, lanes past the end of the chunk are ignored
+						Volt::HashNonceBatch(kernel, kernelInput, batchStart, digests);
+
+						const uint64_t lanesInChunk = std::min<uint64_t>(laneCount, chunkEnd - batchStart + 1);
+						hashCount += lanesInChunk;
+
+						// Check if any of the hashes are valid, only the first worker to find a valid hash gets to submit 
+						// its solution
+						bool solutionFound = false;
+						for (uint32_t lane = 0; lane < lanesInChunk && !solutionFound; lane++)
+						{
+							if (Volt::DigestMeetsTarget(digests[lane], target))
+							{
+								solutionFound = true;
+
+								bool expected = false;
+								if (stopSearch.compare_exchange_strong(expected, true))
+								{
+									Volt::ConvertDigestWordsToBytes(digests[lane], winningHash.data.data());
+
+									winningNonce = batchStart + lane;
+									winningHash.state = BinaryFieldState::VALID;
+									result.solutionFound = true;
+								}
+							}
+						}
+
+						if (solutionFound || chunkEnd - batchStart < laneCount)
+							break;
+					}
+
+					hashRateRecorder.RecordHashes(hashCount - chunkHashCountStart);
 				}
 			}
 
-			// Increment the nonce value if the generated hash doesn't satisfy the block difficulty
-			if (!hashValid)
-				minedBlock.impl->nonce++;
-		}
+			result.hashCounts[workerIndex] = hashCount;
+		};
 
-		Volt::EndHashRateRecord(); // Do calculations to get the final recorded hash rate
+		// Do the search across all the workers, the calling thread is used as the first worker
+		std::vector<std::thread> workers;
+		workers.reserve(numThreads - 1);
 
-		// Assign the current timestamp to the block
-		minedBlock.impl->timestamp = Volt::GetTimeSinceEpoch();
+		for (uint32_t index = 1; index < numThreads; index++)
+			workers.emplace_back(searchNonceRange, index);
 
-		// Get the hash of the generated hash combined with the timestamp
-		const std::string hashInput = generatedHash + std::to_string(minedBlock.GetTimestamp());
-		std::vector<uint8_t> buffer = Volt::GetRawString(hashInput), finalHashBuffer;
+		searchNonceRange(0);
 
-		ErrorCode error = Volt::GetSHA256Digest(buffer, finalHashBuffer);
-		if (error)
-			return error;
+		for (std::thread& worker : workers)
+			worker.join();
+
+		if (!result.solutionFound)
+			return ErrorID::NO_HASH_SOLUTION_FOUND_IN_NONCE_RANGE;
+
+		// Finally, assign the winning nonce and its hash to the block
+		result.nonce = winningNonce;
+		block.impl->nonce = winningNonce;
+		block.impl->hash = winningHash;
 
-		// Finally, assign the final generated hash to the block
-		minedBlock.impl->hash = Volt::ConvertByteToHexData(finalHashBuffer);
 		return ErrorID::NONE;
 	}
 
-	ErrorCode MineNextBlock(Block& block, uint64_t nonceStart, uint64_t nonceEnd)
+	void AppendBlockTransaction(Block& block, const Transaction& tx)
 	{
-		// Make sure that the min 
-		if (nonceStart > nonceEnd)
-			return ErrorID::NONCE_MIN_LARGER_THAN_NONCE_MAX;
+		block.impl->AddTransaction(tx);
+		block.impl->nonce = 0;
+		block.impl->hash = DigestField();
+	}
 
-		// Start doing proof-of-work (find a hash that satisfies the block difficulty)
-		std::string generatedHash;
-		bool hashValid = false;
+	void RemoveBlockTransaction(Block& block, size_t index)
+	{
+		block.impl->RemoveTransaction(index);
+		block.impl->nonce = 0;
+		block.impl->hash = DigestField();
+	}
+
+	void SetBlockTimestamp(Block& block, uint64_t timestamp)
+	{
+		block.impl->timestamp = timestamp;
+		block.impl->nonce = 0;
+		block.impl->hash = DigestField();
+	}
 
-		Volt::StartHashRateRecord(block.GetNonce()); // Start recording the current hash rate
-		block.impl->nonce = nonceStart;
+	void SetBlockExtraNonce(Block& block, uint64_t extraNonce)
+	{
+		block.impl->extraNonce = extraNonce;
+		block.impl->nonce = 0;
+		block.impl->hash = DigestField();
+	}
 
-		while (!hashValid && (block.GetNonce() <= nonceEnd))
+	std::ostream& operator<<(std::ostream& stream, const Block& block)
+	{
+		stream << json::serialize(json::value_from(block));
+		return stream;
+	}
+
+	DifficultyTarget GetDifficultyTarget(uint64_t difficulty)
+	{
+		DifficultyTarget target = {};
+		if (difficulty <= 1)
 		{
-			// Generate a new hash
-			ErrorCode error = block.GenerateBlockHash(generatedHash);
-			if (error)
-				return error;
-
-			// Check if the hash is valid
-			hashValid = true;
-			for (size_t i = 0; i < block.GetDifficulty(); i++)
+			target.fill(UINT32_MAX);
+			return target;
+		}
+
+		// Long division of the maximum 256-bit value (all bits set) by the difficulty, done one bit at a time since the
+		// remainder can take up the full 64 bits
+		uint64_t remainder = 0;
+		for (int bit = 255; bit >= 0; bit--)
+		{
+			const bool carry = remainder >> 63;
+			remainder = (remainder << 1) | 1;
+
+			if (carry || remainder >= difficulty)
 			{
-				if (generatedHash[i] != '0')
-				{
-					hashValid = false;
-					break;
-				}
+				remainder -= difficulty;
+				target[7 - (bit / 32)] |= (1u << (bit % 32));
 			}
-
-			// Increment the nonce value if the generated hash doesn't satisfy the block difficulty
-			if (!hashValid)
-				block.impl->nonce++;
 		}
 
-		Volt::EndHashRateRecord(); // Do calculations to get the final recorded hash rate
+		return target;
+	}
 
-		if (hashValid)
+	bool DigestMeetsTarget(const uint32_t(&digestWords)[8], const DifficultyTarget& target)
+	{
+		for (size_t i = 0; i < 8; i++)
 		{
-			// Assign the current timestamp to the block
-			block.impl->timestamp = Volt::GetTimeSinceEpoch();
+			if (digestWords[i] != target[i])
+				return digestWords[i] < target[i];
+		}
 
-			// Get the hash of the generated hash combined with the timestamp
-			const std::string hashInput = generatedHash + std::to_string(block.GetTimestamp());
-			std::vector<uint8_t> buffer = Volt::GetRawString(hashInput), finalHashBuffer;
+		return true;
+	}
 
-			ErrorCode error = Volt::GetSHA256Digest(buffer, finalHashBuffer);
-			if (error)
-				return error;
+	ErrorCode GetBlockNonceKernelInput(const Block& block, NonceKernelInput& inputOutput)
+	{
+		// Generate the SHA256 midstate of the header data in front of the nonce
+		const BlockHeader header = block.GetHeader();
+		SHA256Midstate headerMidstate;
 
-			// Finally, assign the final generated hash to the block
-			block.impl->hash = Volt::ConvertByteToHexData(finalHashBuffer);
-		}
-		else
-			return ErrorID::NO_HASH_SOLUTION_FOUND_IN_NONCE_RANGE;
+		ErrorCode error = Volt::GetSHA256Midstate(header.data(), VOLT_BLOCK_HEADER_MIDSTATE_SIZE, headerMidstate);
+		if (error)
+			return error;
 
-		return ErrorID::NONE;
+		return Volt::GetBlockNonceKernelInput(header, headerMidstate, inputOutput);
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const Block& block)
+	ErrorCode GetBlockNonceKernelInput(const BlockHeader& header, const SHA256Midstate& headerMidstate,
+		NonceKernelInput& inputOutput)
 	{
-		stream << json::serialize(json::value_from(block));
-		return stream;
+		// Build the final message block from the tail of the header
+		return Volt::InitNonceKernelInput(headerMidstate, header.data() + VOLT_BLOCK_HEADER_MIDSTATE_SIZE, 
+			VOLT_BLOCK_HEADER_SIZE - VOLT_BLOCK_HEADER_MIDSTATE_SIZE, headerNonceOffset - VOLT_BLOCK_HEADER_MIDSTATE_SIZE, 
+			inputOutput);
+	}
+
+	void SetKernelInputSearchSpace(NonceKernelInput& input, uint64_t timestamp, uint64_t extraNonce)
+	{
+		// The final message block holds the header bytes after the midstate prefix
+		constexpr uint32_t timestampWordIndex = (headerTimestampOffset - VOLT_BLOCK_HEADER_MIDSTATE_SIZE) / 4;
+		constexpr uint32_t extraNonceWordIndex = (headerExtraNonceOffset - VOLT_BLOCK_HEADER_MIDSTATE_SIZE) / 4;
+
+		input.finalBlock[timestampWordIndex] = (uint32_t)(timestamp >> 32);
+		input.finalBlock[timestampWordIndex + 1] = (uint32_t)timestamp;
+		input.finalBlock[extraNonceWordIndex] = (uint32_t)(extraNonce >> 32);
+		input.finalBlock[extraNonceWordIndex + 1] = (uint32_t)extraNonce;
+	}
+
+	MerkleHash GetTransactionLeafHash(const Transaction& tx)
+	{
+		// The transaction digest covers the canonical encoding of every field but the signiture (type, id, timestamp,
+		// amount, fee and both keys), so none of them can be changed without changing the merkle root. The signiture
+		// isn't committed to, this relies on the low-S rule making signitures non-malleable: without the sender's private
+		// key a valid signiture can't be swapped for another valid one, and a signiture that doesn't verify fails the block
+		const SHA256Digest& txDigest = tx.GetTxDigestField().data;
+
+		MerkleHash leaf;
+		std::copy(txDigest.begin(), txDigest.end(), leaf.begin());
+
+		return leaf;
 	}
 
 	Block GetGenesisBlock()
 	{
-		return Block(0, "", {}, 0, "AC7FDA5E0E2BF8B6600D4AFAC9C6095E89E9C14B30BC4A114FAB090BCAFADC79", 1638318078);
+		return Block(0, "", {}, 0, "EE3A023A11190DBA9E332A5656694F51074FB37F715868A6DE2DE5AE45FFDE78", 1638318078);
 	}
 
 	bool operator==(const Block& lhs, const Block& rhs)
@@ -372,9 +641,10 @@ namespace Volt
 		return lhs.GetIndex() == rhs.GetIndex() &&
 			lhs.GetTimestamp() == rhs.GetTimestamp() &&
 			lhs.GetNonce() == rhs.GetNonce() &&
+			lhs.GetExtraNonce() == rhs.GetExtraNonce() &&
 			lhs.GetDifficulty() == rhs.GetDifficulty() &&
-			lhs.GetPreviousBlockHash() == rhs.GetPreviousBlockHash() &&
-			lhs.GetBlockHash() == rhs.GetBlockHash();
+			lhs.GetPreviousBlockHashField() == rhs.GetPreviousBlockHashField() &&
+			lhs.GetBlockHashField() == rhs.GetBlockHashField();
 	}
 
 	bool operator!=(const Block& lhs, const Block& rhs)
@@ -382,9 +652,10 @@ namespace Volt
 		return lhs.GetIndex() != rhs.GetIndex() ||
 			lhs.GetTimestamp() != rhs.GetTimestamp() ||
 			lhs.GetNonce() != rhs.GetNonce() ||
+			lhs.GetExtraNonce() != rhs.GetExtraNonce() ||
 			lhs.GetDifficulty() != rhs.GetDifficulty() ||
-			lhs.GetPreviousBlockHash() != rhs.GetPreviousBlockHash() ||
-			lhs.GetBlockHash() != rhs.GetBlockHash();
+			lhs.GetPreviousBlockHashField() != rhs.GetPreviousBlockHashField() ||
+			lhs.GetBlockHashField() != rhs.GetBlockHashField();
 	}
 
 	void tag_invoke(json::value_from_tag, json::value& obj, const Block& block)
@@ -394,6 +665,7 @@ namespace Volt
 			{ "timestamp", block.GetTimestamp() },
 			{ "difficulty", block.GetDifficulty() },
 			{ "nonce", block.GetNonce() },
+			{ "extraNonce", block.GetExtraNonce() },
 			{ "previousHash", block.GetPreviousBlockHash() },
 			{ "hash", block.GetBlockHash() },
 			{ "transactions", block.GetTransactions().GetVectorObject() }
@@ -402,14 +674,21 @@ namespace Volt
 
 	Block tag_invoke(json::value_to_tag<Block>, const json::value& obj)
 	{
+		const std::string previousHash = json::value_to<std::string>(obj.at("previousHash"));
+		const std::string hash = json::value_to<std::string>(obj.at("hash"));
+
+		// Blocks written before the extra nonce was added to the header don't hold one, so it defaults to 0
+		const json::value* extraNonce = obj.as_object().if_contains("extraNonce");
+
 		return Block {
 			json::value_to<uint32_t>(obj.at("index")),
-			json::value_to<std::string>(obj.at("previousHash")),
-			json::value_to<std::vector<Transaction>>(obj.at("transactions")),
+			Volt::ConvertHexToDigestField(previousHash.data(), previousHash.size()),
+			Vector<Transaction>(json::value_to<std::vector<Transaction>>(obj.at("transactions"))),
 			json::value_to<uint64_t>(obj.at("difficulty")),
-			json::value_to<std::string>(obj.at("hash")),
+			Volt::ConvertHexToDigestField(hash.data(), hash.size()),
 			json::value_to<uint64_t>(obj.at("timestamp")),
-			json::value_to<uint64_t>(obj.at("nonce"))
+			json::value_to<uint64_t>(obj.at("nonce")),
+			extraNonce ? json::value_to<uint64_t>(*extraNonce) : 0
 		};
 	}
 
@@ -2,13 +2,17 @@
 #define VIDIBOLT_CORE_BLOCK_H
 
 #include <core/transaction.h>
+#include <core/merkle_tree.h>
+#include <crypto/sha256_kernel.h>
 #include <util/volt_api.h>
 #include <util/ts_vector.h>
 
 #include <boost/json.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 #include <memory>
+#include <array>
 
 using namespace boost;
 
@@ -19,7 +23,33 @@ namespace Volt
 	class Chain;
 	class MemPool;
 
+	// The fixed-layout binary block header which the proof-of-work hash of a block is generated from.
+	// All fields are stored in big-endian byte order and are laid out as so:
+	// [ [uint32_t] Version, [uint32_t] Index, [32 bytes] Previous Hash, [32 bytes] Transactions Merkle Root,
+	//   [uint64_t] Difficulty, [uint64_t] Timestamp, [uint64_t] Extra Nonce, [uint64_t] Nonce ]
+	// 
+	// The nonce is kept at the very end of the header so the SHA256 midstate of the first 64 bytes of the header only has
+	// to be generated once per block, leaving a single 64-byte block to be hashed per nonce attempt.
+	// 
+	// The extra nonce and the timestamp also lie outside of the midstate, so they can be changed to give a worker (or a
+	// remote miner) its own search space without having to regenerate the midstate. Each extra nonce value gives a disjoint
+	// search space of 2^64 nonces for the same block template.
+	using BlockHeader = std::array<uint8_t, VOLT_BLOCK_HEADER_SIZE>;
+
+	// A struct which holds the outcome of a proof-of-work search done over a range of nonces.
+	struct MiningResult
+	{
+		bool solutionFound = false;
+		uint64_t nonce = 0; // The nonce which produced the valid hash (only set if a solution was found)
+		std::vector<uint64_t> hashCounts; // The number of hashes generated by each worker thread
+	};
+
+	// The 256-bit proof-of-work target of a block stored as 8 words, the first word holding the most significant 32 bits.
+	// A block hash is valid if its digest, read as a big-endian 256-bit number, is less than or equal to the target.
+	using DifficultyTarget = std::array<uint32_t, 8>;
+
 	// A class that contains data belonging to a block.
+	// The hashes of the block are held in binary, they're only converted to hex when the block is serialized or displayed.
 	class Block
 	{
 	private:
@@ -29,12 +59,22 @@ namespace Volt
 		VOLT_API Block();
 		VOLT_API Block(const Block& block);
 		VOLT_API Block(uint32_t index, const std::string& prevHash, const Vector<Transaction>& txs,
-			uint64_t difficulty, const std::string& blockHash = "", uint64_t timestamp = 0, uint64_t nonce = 0);
+			uint64_t difficulty, const std::string& blockHash = "", uint64_t timestamp = 0, uint64_t nonce = 0, 
+			uint64_t extraNonce = 0);
+		VOLT_API Block(uint32_t index, const DigestField& prevHash, const Vector<Transaction>& txs, uint64_t difficulty,
+			const DigestField& blockHash = DigestField(), uint64_t timestamp = 0, uint64_t nonce = 0, uint64_t extraNonce = 0);
+		VOLT_API Block(uint32_t index, const DigestField& prevHash, Vector<Transaction>&& txs, uint64_t difficulty,
+			const DigestField& blockHash = DigestField(), uint64_t timestamp = 0, uint64_t nonce = 0, uint64_t extraNonce = 0);
+
+		// Takes the data of the other block without copying its transactions or merkle tree, the block moved from can only
+		// be assigned to or destroyed.
+		VOLT_API Block(Block&& block) noexcept;
 
 		VOLT_API ~Block();
 		
-		// Operator overload for assignment operations.
+		// Operator overloads for assignment operations.
 		VOLT_API void operator=(const Block& block);
+		VOLT_API void operator=(Block&& block) noexcept;
 
 		// Checks if the block is valid or not.
 		// If the block is valid then the value of the error code returned will be 'ErrorID::NONE', else
@@ -43,7 +83,10 @@ namespace Volt
 
 		// Creates a new block and fills it with transactions fetched from the mempool, the created block is then returned.
 		// Note that this function does NOT perform any proof-of-work on the block, it only creates and initializes it with
-		// data.
+		// data. The timestamp of the block is set upon creation since it is part of the block header, and the extra nonce
+		// is randomly generated so that miners working on the same template don't search the same space.
+		// 
+		// The difficulty is the expected number of hashes needed to find a valid one (see GetDifficultyTarget()).
 		// 
 		// Also, note that the mining reward will only be inserted into the block if the miner public key is provided, 
 		// if it's not provided then no mining reward transaction will be included in the block.
@@ -68,16 +111,58 @@ namespace Volt
 		// generation of hashes for the block will start at an initial nonce value of 50 then the generation of hashes will
 		// end when either a hash satisfying the difficulty is found or when the nonce value reaches a value of 100.
 		// 
-		// The block passed via 'block' will be modified with the block hash and timestamp being assigned if 
+		// The block passed via 'block' will be modified with the nonce and block hash being assigned if 
 		// a valid hash is successfully found.
 		// 
 		// An error code is returned in the event of a failure occurring.
 		friend extern VOLT_API ErrorCode MineNextBlock(Block& block, uint64_t nonceStart = 0, uint64_t nonceEnd = UINT64_MAX);
 
-		// Generates the hash of the block based on its contents. 
+		// Does proof-of-work on the block using multiple worker threads, assuming that the block data has already been
+		// initialized (this should be done via the CreateBlock() method).
+		// 
+		// The nonce range ['nonceStart', 'nonceEnd'] is split into one partition per worker thread, workers claim chunks of
+		// nonces from their own partition and once it runs dry they steal chunks from the partitions of the other workers.
+		// All workers stop as soon as any one of them finds a hash satisfying the block difficulty.
+		// 
+		// If 'numThreads' is 0 then one worker is used per hardware thread, if it is 1 then the search is done solely on
+		// the calling thread (this is equivalent to the single threaded MineNextBlock() overload above).
+		// 
+		// The winning nonce and the number of hashes generated by each worker are returned via 'result', the block passed
+		// via 'block' is modified the same way as it is by the single threaded MineNextBlock() overload.
+		// 
+		// An error code is returned in the event of a failure occurring.
+		friend extern VOLT_API ErrorCode MineNextBlock(Block& block, uint32_t numThreads, MiningResult& result,
+			uint64_t nonceStart = 0, uint64_t nonceEnd = UINT64_MAX);
+
+		// Appends the transaction to the block, only the nodes of the merkle tree on the path of the new leaf are regenerated.
+		// Note that the nonce and hash of the block are reset since they no longer match the header of the block.
+		friend extern VOLT_API void AppendBlockTransaction(Block& block, const Transaction& tx);
+
+		// Removes the transaction at the index specified from the block, the merkle tree is updated along the way.
+		// Note that the nonce and hash of the block are reset since they no longer match the header of the block.
+		friend extern VOLT_API void RemoveBlockTransaction(Block& block, size_t index);
+
+		// Assigns the timestamp given to the block.
+		// Note that the nonce and hash of the block are reset since they no longer match the header of the block.
+		friend extern VOLT_API void SetBlockTimestamp(Block& block, uint64_t timestamp);
+
+		// Assigns the extra nonce given to the block, giving it a search space disjoint from every other extra nonce value.
+		// Note that the nonce and hash of the block are reset since they no longer match the header of the block.
+		friend extern VOLT_API void SetBlockExtraNonce(Block& block, uint64_t extraNonce);
+
+		// Generates the hash of the block based on its header. 
 		// An error code is returned in the event of a failure occurring.
 		VOLT_API ErrorCode GenerateBlockHash(std::string& outputBlockHash) const;
 
+		// Returns the binary header of the block, which is what the block hash is generated from.
+		VOLT_API BlockHeader GetHeader() const;
+
+		// Generates the merkle proof that the transaction matching the given transaction hash is contained in the block.
+		// The proof can be checked against the block's merkle root via VerifyMerkleProof(), using the leaf hash returned by
+		// GetTransactionLeafHash(). The proof is returned via the second parameter 'proof'.
+		// An error code is returned if something goes wrong e.g. the transaction not being found etc.
+		VOLT_API ErrorCode GenerateTransactionProof(const std::string& txHash, std::vector<MerkleProofStep>& proof) const;
+
 		// Returns the index of the block.
 		VOLT_API const uint32_t& GetIndex() const;
 
@@ -90,18 +175,61 @@ namespace Volt
 		// Returns the nonce value of the block.
 		VOLT_API const uint64_t& GetNonce() const;
 
-		// Returns the block's previous hash.
-		VOLT_API const std::string& GetPreviousBlockHash() const;
+		// Returns the extra nonce value of the block.
+		VOLT_API const uint64_t& GetExtraNonce() const;
+
+		// Returns the hex of the block's previous hash.
+		VOLT_API std::string GetPreviousBlockHash() const;
 
-		// Returns the hash of the block.
-		VOLT_API const std::string& GetBlockHash() const;
+		// Returns the hex of the hash of the block.
+		VOLT_API std::string GetBlockHash() const;
+
+		// Returns the block's previous hash in binary.
+		VOLT_API const DigestField& GetPreviousBlockHashField() const;
+
+		// Returns the hash of the block in binary.
+		VOLT_API const DigestField& GetBlockHashField() const;
 
 		// Returns the transactions contained in the block.
 		VOLT_API const Vector<Transaction>& GetTransactions() const;
+
+		// Returns the root of the merkle tree built from the hashes of the transactions contained in the block.
+		VOLT_API const MerkleHash& GetMerkleRoot() const;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// Does every check done by VerifyBlock() except for verifying the hashes and signitures of the transactions contained,
+	// which the caller must have already done (e.g. in a batch spanning several blocks via VerifyTransactionsBatch()).
+	// An error code is returned if the block isn't valid.
+	extern VOLT_API ErrorCode VerifyBlockStructure(const Block& block, const Chain& chain);
+
+	// Returns the proof-of-work target for the difficulty given, which is the maximum 256-bit value divided by the difficulty.
+	// So on average, 'difficulty' hashes have to be generated to find a valid one (a difficulty of 0 is treated as 1).
+	extern VOLT_API DifficultyTarget GetDifficultyTarget(uint64_t difficulty);
+
+	// Returns TRUE if the digest (given as 8 big-endian words) is less than or equal to the target, else FALSE is returned.
+	extern VOLT_API bool DigestMeetsTarget(const uint32_t(&digestWords)[8], const DifficultyTarget& target);
+
+	// Initializes the nonce search kernel input from the header of the block, the nonce field of the header is what varies
+	// between the lanes of the kernel.
+	// An error code is returned in the event of a failure occurring.
+	extern VOLT_API ErrorCode GetBlockNonceKernelInput(const Block& block, NonceKernelInput& inputOutput);
+
+	// Same as the function above, except the SHA256 midstate of the first 'VOLT_BLOCK_HEADER_MIDSTATE_SIZE' bytes of the 
+	// header is given rather than generated, so callers which keep the midstate cached only pay for the header tail.
+	// An error code is returned in the event of a failure occurring.
+	extern VOLT_API ErrorCode GetBlockNonceKernelInput(const BlockHeader& header, const SHA256Midstate& headerMidstate,
+		NonceKernelInput& inputOutput);
+
+	// Rewrites the timestamp and extra nonce held by the nonce search kernel input of a block, this is how a search space 
+	// is rolled without regenerating the header midstate (both fields lie in the final message block).
+	extern VOLT_API void SetKernelInputSearchSpace(NonceKernelInput& input, uint64_t timestamp, uint64_t extraNonce);
+
+	// Returns the merkle tree leaf hash of the transaction, which is the raw digest held by the transaction's hash. This
+	// commits to every field of the transaction but the signiture, which is safe since signitures must be low-S.
+	extern VOLT_API MerkleHash GetTransactionLeafHash(const Transaction& tx);
+
 	// Returns the (hard-coded) genesis block of the entire blockchain.
 	extern VOLT_API Block GetGenesisBlock();
 
@@ -0,0 +1,241 @@
+#include <core/block_template.h>
+#include <util/random_generation.h>
+#include <util/timestamp.h>
+
+#include <array>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class BlockTemplate::Implementation
+	{
+	public:
+		MemPool& pool;
+		const Chain& chain;
+		uint64_t difficulty;
+		std::string minerPublicKeyHex;
+		std::function<bool(const Transaction&)> txHandler;
+
+		Block block;
+		uint32_t numPoolTxs; // The number of transactions in the block taken from the mempool (excludes the mining reward)
+		uint64_t revision;
+		bool difficultyChanged;
+
+		// The chain tip and mempool version the template was last brought up to date with
+		uint32_t tipHeight;
+		DigestField tipHash;
+		uint64_t poolVersion;
+
+		// The cached header midstate, along with the header prefix it was generated from
+		SHA256Midstate headerMidstate;
+		std::array<uint8_t, VOLT_BLOCK_HEADER_MIDSTATE_SIZE> headerMidstatePrefix;
+		bool headerMidstateValid;
+		NonceKernelInput kernelInput;
+	public:
+		Implementation(MemPool& pool, const Chain& chain, uint64_t difficulty, const ECKeyPair* minerPublicKey,
+			std::function<bool(const Transaction&)> txHandler) :
+			pool(pool), chain(chain), difficulty(difficulty), txHandler(txHandler), numPoolTxs(0), revision(0),
+			difficultyChanged(false), tipHeight(0), poolVersion(0), headerMidstate(), headerMidstatePrefix(),
+			headerMidstateValid(false), kernelInput()
+		{
+			if (minerPublicKey)
+				this->minerPublicKeyHex = minerPublicKey->GetPublicKeyHex();
+		}
+
+		~Implementation() = default;
+
+		// Returns the transactions from the mempool which should be included in the block.
+		std::vector<Transaction> GetCandidateTransactions() const
+		{
+			std::vector<Transaction> txs = Volt::PeekTransactions(this->pool, VOLT_MAX_TRANSACTIONS_PER_BLOCK);
+			if (this->txHandler)
+			{
+				txs.erase(std::remove_if(txs.begin(), txs.end(), [&](const Transaction& tx) { return !this->txHandler(tx); }),
+					txs.end());
+			}
+
+			return txs;
+		}
+
+		// Returns the timestamp for the block, which can't be earlier than the timestamp of the latest block in the chain
+		// (its miner may have rolled it forward).
+		uint64_t GetTimestamp() const
+		{
+			return std::max(Volt::GetTimeSinceEpoch(), this->chain.GetLatestBlock().GetTimestamp());
+		}
+
+		// Appends the mining reward transaction to the block, which also includes the fees paid by the transactions in it.
+		void AppendMiningReward()
+		{
+			if (this->minerPublicKeyHex.empty())
+				return;
+
+			Amount totalFees = 0;
+			for (uint32_t index = 0; index < this->numPoolTxs; index++)
+				totalFees += this->block.GetTransactions()[index].GetFee();
+
+			Transaction tx(TransactionType::MINING_REWARD, Volt::GenerateRandomUint64(0, UINT64_MAX),
+				this->chain.GetMiningRewardAmount(this->block.GetIndex()) + totalFees, 0, Volt::GetTimeSinceEpoch(), "",
+				this->minerPublicKeyHex);
+
+			Volt::AppendBlockTransaction(this->block, tx);
+		}
+
+		// Rebuilds the block from scratch on top of the latest block in the chain.
+		void Rebuild()
+		{
+			const Block& latestBlock = this->chain.GetLatestBlock();
+			std::vector<Transaction> txs = this->GetCandidateTransactions();
+			this->numPoolTxs = (uint32_t)txs.size();
+
+			this->block = Block(latestBlock.GetIndex() + 1, latestBlock.GetBlockHashField(),
+				Vector<Transaction>(std::move(txs)), this->difficulty, DigestField(), this->GetTimestamp(), 0,
+				Volt::GenerateRandomUint64(0, UINT64_MAX));
+
+			this->AppendMiningReward();
+		}
+
+		// Brings the transactions of the block up to date with the mempool, returns TRUE if the block was changed.
+		// New transactions at the back of the mempool are appended incrementally, anything else causes a rebuild.
+		bool UpdateTransactions()
+		{
+			const std::vector<Transaction> txs = this->GetCandidateTransactions();
+			const Vector<Transaction>& blockTxs = this->block.GetTransactions();
+
+			bool isPrefix = this->numPoolTxs <= txs.size();
+			for (uint32_t index = 0; index < this->numPoolTxs && isPrefix; index++)
+				isPrefix = blockTxs[index].GetTxDigestField() == txs[index].GetTxDigestField();
+
+			if (!isPrefix)
+			{
+				this->Rebuild();
+				return true;
+			}
+
+			if (this->numPoolTxs == txs.size())
+				return false;
+
+			// Swap out the mining reward for one which includes the fees of the new transactions
+			if (!this->minerPublicKeyHex.empty())
+				Volt::RemoveBlockTransaction(this->block, this->numPoolTxs);
+
+			for (size_t index = this->numPoolTxs; index < txs.size(); index++)
+				Volt::AppendBlockTransaction(this->block, txs[index]);
+
+			this->numPoolTxs = (uint32_t)txs.size();
+			this->AppendMiningReward();
+
+			Volt::SetBlockTimestamp(this->block, this->GetTimestamp());
+			return true;
+		}
+
+		// Rebuilds the nonce search kernel input, the header midstate is only regenerated if the header prefix changed.
+		ErrorCode UpdateKernelInput()
+		{
+			const BlockHeader header = this->block.GetHeader();
+			if (!this->headerMidstateValid || !std::equal(this->headerMidstatePrefix.begin(), this->headerMidstatePrefix.end(),
+				header.begin()))
+			{
+				ErrorCode error = Volt::GetSHA256Midstate(header.data(), VOLT_BLOCK_HEADER_MIDSTATE_SIZE,
+					this->headerMidstate);
+				if (error)
+				{
+					this->headerMidstateValid = false;
+					return error;
+				}
+
+				std::copy_n(header.begin(), VOLT_BLOCK_HEADER_MIDSTATE_SIZE, this->headerMidstatePrefix.begin());
+				this->headerMidstateValid = true;
+			}
+
+			return Volt::GetBlockNonceKernelInput(header, this->headerMidstate, this->kernelInput);
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BlockTemplate::BlockTemplate(MemPool& pool, const Chain& chain, uint64_t difficulty, const ECKeyPair* minerPublicKey,
+		std::function<bool(const Transaction&)> txHandler) :
+		impl(std::make_unique<Implementation>(pool, chain, difficulty, minerPublicKey, txHandler))
+	{
+		this->impl->tipHeight = chain.GetLatestBlockHeight();
+		this->impl->tipHash = chain.GetLatestBlock().GetBlockHashField();
+		this->impl->poolVersion = pool.GetVersion();
+
+		this->impl->Rebuild();
+		this->impl->UpdateKernelInput();
+	}
+
+	BlockTemplate::~BlockTemplate() = default;
+
+	ErrorCode BlockTemplate::Refresh(bool* templateChanged)
+	{
+		bool changed = false;
+
+		const uint32_t latestHeight = this->impl->chain.GetLatestBlockHeight();
+		const DigestField& latestHash = this->impl->chain.GetLatestBlock().GetBlockHashField();
+
+		if (latestHeight != this->impl->tipHeight || latestHash != this->impl->tipHash)
+		{
+			// New blocks have landed, so remove their transactions from the mempool then build on top of the new tip
+			for (uint32_t height = this->impl->tipHeight + 1; height <= latestHeight; height++)
+				Volt::RemoveTransactions(this->impl->pool, this->impl->chain.GetBlockAtIndexHeight(height).GetTransactions());
+
+			this->impl->tipHeight = latestHeight;
+			this->impl->tipHash = latestHash;
+			this->impl->poolVersion = this->impl->pool.GetVersion();
+
+			this->impl->Rebuild();
+			changed = true;
+		}
+		else if (this->impl->difficultyChanged)
+		{
+			this->impl->poolVersion = this->impl->pool.GetVersion();
+			this->impl->Rebuild();
+			changed = true;
+		}
+		else if (this->impl->pool.GetVersion() != this->impl->poolVersion)
+		{
+			// The version is fetched before the mempool is read so changes made while reading are picked up next refresh
+			this->impl->poolVersion = this->impl->pool.GetVersion();
+			changed = this->impl->UpdateTransactions();
+		}
+
+		this->impl->difficultyChanged = false;
+		if (templateChanged)
+			*templateChanged = changed;
+
+		if (!changed)
+			return ErrorID::NONE;
+
+		this->impl->revision++;
+		return this->impl->UpdateKernelInput();
+	}
+
+	void BlockTemplate::SetDifficulty(uint64_t difficulty)
+	{
+		if (difficulty != this->impl->difficulty)
+		{
+			this->impl->difficulty = difficulty;
+			this->impl->difficultyChanged = true;
+		}
+	}
+
+	const Block& BlockTemplate::GetBlock() const
+	{
+		return this->impl->block;
+	}
+
+	const NonceKernelInput& BlockTemplate::GetKernelInput() const
+	{
+		return this->impl->kernelInput;
+	}
+
+	uint64_t BlockTemplate::GetRevision() const
+	{
+		return this->impl->revision;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,71 @@
+#ifndef VIDIBOLT_CORE_BLOCK_TEMPLATE_H
+#define VIDIBOLT_CORE_BLOCK_TEMPLATE_H
+
+#include <core/block.h>
+#include <core/mem_pool.h>
+#include <core/chain.h>
+#include <crypto/sha256_kernel.h>
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+
+#include <functional>
+#include <memory>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which keeps a candidate block ready for mining, owned by the miner.
+	// Rather than rebuilding the block from scratch for every mining attempt, the template watches the mempool and the chain
+	// tip and updates itself when refreshed:
+	//  - When new transactions arrive in the mempool they are appended to the block, only regenerating the merkle tree
+	//    nodes on their path (the mining reward transaction is swapped for one including the new fees).
+	//  - When a new block lands on the chain the template is rebuilt on top of it, and the transactions contained in the
+	//    landed blocks are removed from the mempool.
+	//
+	// The transactions are peeked from the mempool rather than popped, so they stay in the mempool until a block containing
+	// them lands on the chain. The SHA256 midstate of the header prefix is kept cached and is only regenerated when the
+	// prefix of the header changes.
+	//
+	// Note that the template isn't thread safe, it should be refreshed and read from the same thread.
+	class BlockTemplate
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		// The mempool and chain given must outlive the template.
+		// The mining reward transaction is only included if the miner public key is provided, and transactions picked from
+		// the mempool can be customised via 'txHandler' the same way as with CreateBlock().
+		VOLT_API BlockTemplate(MemPool& pool, const Chain& chain, uint64_t difficulty, const ECKeyPair* minerPublicKey = nullptr,
+			std::function<bool(const Transaction&)> txHandler = nullptr);
+		VOLT_API BlockTemplate(const BlockTemplate& blockTemplate) = delete;
+
+		VOLT_API ~BlockTemplate();
+
+		VOLT_API void operator=(const BlockTemplate& blockTemplate) = delete;
+
+		// Brings the template up to date with the mempool and the chain tip, this is cheap if neither have changed.
+		// Whether the block held by the template changed is returned via 'templateChanged' (if given), a miner should swap
+		// to the new template when it has.
+		//
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode Refresh(bool* templateChanged = nullptr);
+
+		// Sets the difficulty of the template block, the template is marked as changed on the next refresh.
+		VOLT_API void SetDifficulty(uint64_t difficulty);
+
+		// Returns the candidate block held by the template.
+		VOLT_API const Block& GetBlock() const;
+
+		// Returns the nonce search kernel input for the candidate block, which is built from the cached header midstate.
+		VOLT_API const NonceKernelInput& GetKernelInput() const;
+
+		// Returns the number of times the template block has changed since the template was created.
+		VOLT_API uint64_t GetRevision() const;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -24,6 +24,10 @@ namespace Volt
 			blockChain(blockChain)
 		{}
 
+		Implementation(Vector<Block>&& blockChain) :
+			blockChain(std::move(blockChain))
+		{}
+
 		~Implementation() = default;
 
 		void operator=(const Implementation& impl)
@@ -46,6 +50,14 @@ namespace Volt
 		impl(std::make_unique<Implementation>(blockChain))
 	{}
 
+	Chain::Chain(Vector<Block>&& blockChain) :
+		impl(std::make_unique<Implementation>(std::move(blockChain)))
+	{}
+
+	Chain::Chain(Chain&& chain) noexcept :
+		impl(std::move(chain.impl))
+	{}
+
 	Chain::~Chain() = default;
 
 	void Chain::operator=(const Chain& chain)
@@ -53,6 +65,11 @@ namespace Volt
 		this->impl = std::make_unique<Implementation>(*chain.impl);
 	}
 
+	void Chain::operator=(Chain&& chain) noexcept
+	{
+		this->impl = std::move(chain.impl);
+	}
+
 	const Block& Chain::GetLatestBlock() const
 	{
 		return this->impl->blockChain.GetBackElement();
@@ -68,9 +85,21 @@ namespace Volt
 		return this->impl->blockChain;
 	}
 
-	double Chain::GetAddressBalance(const ECKeyPair& publicKey) const
+	Amount Chain::GetAddressBalance(const ECKeyPair& publicKey) const
 	{
-		double balance = 0;
+		CompressedPublicKey compressedPublicKey;
+		if (!publicKey.GetCompressedPublicKey(compressedPublicKey))
+			return 0;
+
+		return this->GetAddressBalance(compressedPublicKey);
+	}
+
+	Amount Chain::GetAddressBalance(const CompressedPublicKey& publicKey) const
+	{
+		// The credits and debits are summed as unsigned integers so the sums wrap around rather than overflow, the balance
+		// of a valid chain always fits in an amount
+		const PublicKeyField publicKeyField = { publicKey, BinaryFieldState::VALID };
+		uint64_t credits = 0, debits = 0;
 
 		for (uint32_t blockIndex = 0; blockIndex < this->impl->blockChain.GetSize(); blockIndex++)
 		{
@@ -80,25 +109,31 @@ namespace Volt
 			{
 				const Transaction& tx = block.GetTransactions()[txIndex];
 
-				if (publicKey.GetPublicKeyHex() == tx.GetSenderKey())
-					balance -= (tx.GetAmount() + tx.GetFee());
-				else if (publicKey.GetPublicKeyHex() == tx.GetRecipientKey())
-					balance += tx.GetAmount();
+				if (publicKeyField == tx.GetSenderKeyField())
+					debits += (uint64_t)tx.GetAmount() + (uint64_t)tx.GetFee();
+				else if (publicKeyField == tx.GetRecipientKeyField())
+					credits += (uint64_t)tx.GetAmount();
 			}
 		}
 
-		return balance;
+		return (Amount)(credits - debits);
 	}
 
-	double Chain::GetMiningRewardAmount(uint32_t atBlockIndex) const
+	Amount Chain::GetMiningRewardAmount(uint32_t atBlockIndex) const
 	{
 		uint32_t blockHeight = (atBlockIndex == UINT32_MAX ? (this->GetLatestBlockHeight() + 1) : (atBlockIndex + 1));
 
-		constexpr double base = 75, decreaseFactor = 1.5;
-		constexpr int decreaseRate = 3435000; // Decrease mining reward by the decrease factor every 3,435,000 blocks
-		const int epochs = (int)(blockHeight) / decreaseRate;
+		// The reward is multiplied by 2/3 (divided by 1.5) every epoch, the integer division rounds it down so every node
+		// gets the exact same reward
+		constexpr Amount base = 75 * (Amount)VOLT_AMOUNT_UNITS_PER_COIN, minimum = 3 * (Amount)VOLT_AMOUNT_UNITS_PER_COIN / 10;
+		constexpr uint32_t decreaseRate = 3435000; // Decrease mining reward by the decrease factor every 3,435,000 blocks
+		const uint32_t epochs = blockHeight / decreaseRate;
+
+		Amount reward = base;
+		for (uint32_t epoch = 0; epoch < epochs && reward > minimum; epoch++)
+			reward = reward * 2 / 3;
 
-		return std::max(base / std::pow(decreaseFactor, epochs), 0.3);
+		return std::max(reward, minimum);
 	}
 
 	uint32_t Chain::GetLatestBlockHeight() const
@@ -113,6 +148,11 @@ namespace Volt
 		return Chain(blockChain);
 	}
 
+	Chain CreateExistingChain(Vector<Block>&& blockChain)
+	{
+		return Chain(std::move(blockChain));
+	}
+
 	ErrorCode PushBlock(Chain& chain, const Block& block)
 	{
 		// The block must be valid for it to be appended to the chain, so we check if it is before appending it to the chain.
@@ -131,18 +171,49 @@ namespace Volt
 		return error;
 	}
 
+	ErrorCode PushBlock(Chain& chain, Block&& block)
+	{
+		ErrorCode error = Volt::VerifyBlock(block, chain);
+		if (!error)
+			chain.impl->blockChain.EmplaceBackElement(std::move(block));
+
+		return error;
+	}
+
 	ErrorCode VerifyChain(const Chain& chain)
 	{
 		// There must be a genesis block in the chain
 		if (chain.GetLatestBlockHeight() < 1)
 			return ErrorID::CHAIN_EMPTY;
 
-		for (uint32_t blockIndex = 0; blockIndex < (uint32_t)chain.impl->blockChain.GetSize(); blockIndex++)
+		const std::vector<Block>& blocks = chain.impl->blockChain.GetVectorObject();
+
+		// Verify the transactions of every block in one batch, so the work is spread across the thread pool even when the
+		// blocks only hold a few transactions each
+		std::vector<const Transaction*> txBatch;
+		std::vector<uint32_t> txBlockIndices;
+
+		for (uint32_t blockIndex = 0; blockIndex < (uint32_t)blocks.size(); blockIndex++)
 		{
-			const Block& block = chain.impl->blockChain[blockIndex];
+			for (const Transaction& tx : blocks[blockIndex].GetTransactions().GetVectorObject())
+			{
+				txBatch.emplace_back(&tx);
+				txBlockIndices.emplace_back(blockIndex);
+			}
+		}
 
-			// Check that the block is valid
-			ErrorCode error = Volt::VerifyBlock(block, chain);
+		size_t failedTxIndex = 0;
+		const ErrorCode txError = Volt::VerifyTransactionsBatch(txBatch, &failedTxIndex);
+
+		for (uint32_t blockIndex = 0; blockIndex < (uint32_t)blocks.size(); blockIndex++)
+		{
+			// The transactions of a block are checked before the rest of it, so an invalid transaction takes precedence
+			// over other problems with the same block
+			if (txError && txBlockIndices[failedTxIndex] == blockIndex)
+				return txError;
+
+			// Check that the rest of the block is valid
+			ErrorCode error = Volt::VerifyBlockStructure(blocks[blockIndex], chain);
 			if (error)
 				return error;
 		}
@@ -153,8 +224,12 @@ namespace Volt
 	ErrorCode FindTransaction(const Chain& chain, const std::string& txHash, Transaction& returnedTx)
 	{
 		// Extract timestamp from the transaction hash string
-		const std::string timestampHex = txHash.substr(SHA_256_DIGEST_LENGTH_HEX, txHash.size() - SHA_256_DIGEST_LENGTH_HEX);
-		uint64_t timestamp = Volt::ConvertHexToUint(timestampHex);
+		if (txHash.size() <= SHA_256_DIGEST_LENGTH_HEX)
+			return ErrorID::TRANSACTION_NOT_FOUND;
+
+		const uint64_t timestamp = Volt::ConvertHexToUint(txHash.data() + SHA_256_DIGEST_LENGTH_HEX,
+			txHash.size() - SHA_256_DIGEST_LENGTH_HEX);
+		const DigestField txDigest = Volt::ConvertHexToDigestField(txHash.data(), SHA_256_DIGEST_LENGTH_HEX);
 
 		// Attempt to find the transaction matching the hash given
 		for (uint32_t blockIndex = 0; blockIndex < (uint32_t)chain.impl->blockChain.GetSize(); blockIndex++)
@@ -169,7 +244,8 @@ namespace Volt
 				{
 					const Transaction& tx = block.GetTransactions()[txIndex];
 
-					if (tx.GetTxHash() == txHash)
+					// The digests are compared first so the hash strings are only generated for the matching transaction
+					if (tx.GetTxDigestField() == txDigest && tx.GetTxHash() == txHash)
 					{
 						returnedTx = tx;
 						return ErrorID::NONE;
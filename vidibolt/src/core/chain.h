@@ -20,22 +20,34 @@ namespace Volt
 		std::unique_ptr<Implementation> impl;
 	private:
 		VOLT_API Chain(const Vector<Block>& blockChain);
+		VOLT_API Chain(Vector<Block>&& blockChain);
 	public:
 		VOLT_API Chain();
 		VOLT_API Chain(const Chain& chain);
 
+		// Takes the blocks of the other chain without copying them, the chain moved from can only be assigned to or destroyed.
+		VOLT_API Chain(Chain&& chain) noexcept;
+
 		VOLT_API ~Chain();
 
-		// Operator overload for assignment operations.
+		// Operator overloads for assignment operations.
 		VOLT_API void operator=(const Chain& chain);
+		VOLT_API void operator=(Chain&& chain) noexcept;
 
 		// Creates new chain object initialized with the given existing vector array of blocks (aka blockchain).
 		friend extern VOLT_API Chain CreateExistingChain(const Vector<Block>& blockChain);
 
+		// Same as the function above, except the blocks are moved into the chain rather than copied.
+		friend extern VOLT_API Chain CreateExistingChain(Vector<Block>&& blockChain);
+
 		// Checks if the block is valid, then appends it to the stored chain if it's valid.
 		// An error code is returned in the event of a failure occurring.
 		friend extern VOLT_API ErrorCode PushBlock(Chain& chain, const Block& block);
 
+		// Same as the function above, except the block is moved onto the chain rather than copied. The block is only moved
+		// from if it's appended, so it's left untouched when an error code is returned.
+		friend extern VOLT_API ErrorCode PushBlock(Chain& chain, Block&& block);
+
 		// Checks if the entire stored blockchain is valid.
 		// If the chain is valid then the value of the error code returned will be 'ErrorID::NONE', else
 		// other possible error codes will be returned depending on the type of failure that occurred.
@@ -57,10 +69,13 @@ namespace Volt
 		VOLT_API const Vector<Block>& GetBlockChain() const;
 
 		// Returns the amount of coins currently being held by a public key address
-		VOLT_API double GetAddressBalance(const ECKeyPair& publicKey) const;
+		VOLT_API Amount GetAddressBalance(const ECKeyPair& publicKey) const;
+
+		// Returns the amount of coins currently being held by the compressed public key given.
+		VOLT_API Amount GetAddressBalance(const CompressedPublicKey& publicKey) const;
 
 		// Returns the current mining reward amount.
-		VOLT_API double GetMiningRewardAmount(uint32_t atBlockIndex = UINT32_MAX) const;
+		VOLT_API Amount GetMiningRewardAmount(uint32_t atBlockIndex = UINT32_MAX) const;
 
 		// Returns the height index of the latest block in the chain.
 		VOLT_API uint32_t GetLatestBlockHeight() const;
@@ -1,46 +1,139 @@
 #include <core/hash_stats.h>
 
+#include <atomic>
 #include <chrono>
-#include <mutex>
 
-namespace Global
+namespace
 {
-	const uint64_t* hashCounter;
-	double currentHashesPerSecond;
+	// The number of per-second buckets kept by each worker slot, this must cover the largest sliding window (60 seconds)
+	// plus the current second.
+	constexpr uint32_t bucketCount = 64;
 
-	std::mutex mutex;
-	std::chrono::system_clock::duration startTime;
+	// The bucket second value used to mark buckets which haven't been written to yet.
+	constexpr uint64_t emptyBucketSecond = UINT64_MAX;
+
+	// Returns the time since the steady clock epoch in nanoseconds.
+	uint64_t GetSteadyTimeNanoseconds()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// The hash counts of a single worker, the buckets form a ring indexed by the second the hashes were recorded in.
+	// Each slot starts on its own cache line so workers never write to the same line as each other.
+	struct alignas(64) HashRateSlot
+	{
+		std::atomic<bool> inUse = false;
+		std::atomic<uint64_t> totalHashCount = 0;
+		std::atomic<uint64_t> bucketSeconds[bucketCount];
+		std::atomic<uint64_t> bucketHashCounts[bucketCount];
+
+		HashRateSlot()
+		{
+			for (uint32_t index = 0; index < bucketCount; index++)
+			{
+				this->bucketSeconds[index] = emptyBucketSecond;
+				this->bucketHashCounts[index] = 0;
+			}
+		}
+	};
+
+	HashRateSlot hashRateSlots[Volt::VOLT_MAX_HASH_RATE_WORKERS];
+	std::atomic<uint32_t> nextSharedSlot = 0;
+
+	// Returns the hash rate over the window of seconds given, the window ends at the current (partial) second.
+	double GetWindowHashRate(uint32_t windowSeconds, uint64_t currentSecond, double currentSecondFraction)
+	{
+		uint64_t windowHashCount = 0;
+		for (const HashRateSlot& slot : hashRateSlots)
+		{
+			for (uint32_t index = 0; index < bucketCount; index++)
+			{
+				const uint64_t second = slot.bucketSeconds[index].load(std::memory_order_acquire);
+				if (second != emptyBucketSecond && second <= currentSecond && currentSecond - second <= windowSeconds)
+					windowHashCount += slot.bucketHashCounts[index].load(std::memory_order_relaxed);
+			}
+		}
+
+		// The window is made up of the full seconds before the current second, plus the elapsed part of the current second
+		return (double)windowHashCount / ((double)windowSeconds + currentSecondFraction);
+	}
 }
 
 namespace Volt
 {
-	void StartHashRateRecord(const uint64_t& hashCounter)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	HashRateRecorder::HashRateRecorder() :
+		slotIndex(0), ownsSlot(false)
 	{
-		std::scoped_lock lock(Global::mutex);
+		// Claim the first free slot in the registry
+		for (uint32_t index = 0; index < VOLT_MAX_HASH_RATE_WORKERS; index++)
+		{
+			bool expected = false;
+			if (hashRateSlots[index].inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+			{
+				this->slotIndex = index;
+				this->ownsSlot = true;
+				return;
+			}
+		}
+
+		// Every slot is in use so share one of them
+		this->slotIndex = nextSharedSlot.fetch_add(1, std::memory_order_relaxed) % VOLT_MAX_HASH_RATE_WORKERS;
+	}
 
-		Global::hashCounter = &hashCounter;
-		Global::startTime = std::chrono::system_clock::now().time_since_epoch();
+	HashRateRecorder::~HashRateRecorder()
+	{
+		// The counts in the slot are left as they are so the totals and rates still include them
+		if (this->ownsSlot)
+			hashRateSlots[this->slotIndex].inUse.store(false, std::memory_order_release);
 	}
 
-	void EndHashRateRecord()
+	void HashRateRecorder::RecordHashes(uint64_t hashCount)
 	{
-		if (Global::hashCounter)
+		HashRateSlot& slot = hashRateSlots[this->slotIndex];
+		const uint64_t currentSecond = GetSteadyTimeNanoseconds() / 1000000000;
+		const uint32_t bucketIndex = (uint32_t)(currentSecond % bucketCount);
+
+		// Reset the bucket if it holds the count of an older second, that second is always outside of every window so 
+		// readers are never affected by the reset
+		if (slot.bucketSeconds[bucketIndex].load(std::memory_order_relaxed) != currentSecond)
 		{
-			std::scoped_lock lock(Global::mutex);
+			slot.bucketHashCounts[bucketIndex].store(0, std::memory_order_relaxed);
+			slot.bucketSeconds[bucketIndex].store(currentSecond, std::memory_order_release);
+		}
+
+		slot.bucketHashCounts[bucketIndex].fetch_add(hashCount, std::memory_order_relaxed);
+		slot.totalHashCount.fetch_add(hashCount, std::memory_order_relaxed);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-			// Get the time elapsed since hash rate counter started
-			std::chrono::system_clock::duration timeNow = std::chrono::system_clock::now().time_since_epoch();
-			double timeElapsed = std::chrono::duration_cast<std::chrono::duration<double>>(timeNow - Global::startTime).count();
+	HashRateStats GetHashRateStats()
+	{
+		const uint64_t timeNow = GetSteadyTimeNanoseconds();
+		const uint64_t currentSecond = timeNow / 1000000000;
+		const double currentSecondFraction = (double)(timeNow % 1000000000) / 1000000000.0;
 
-			// Check if a second has passed, if so then calculate h/s
-			Global::currentHashesPerSecond = (double)*Global::hashCounter / timeElapsed;
-			Global::hashCounter = nullptr;
+		HashRateStats stats;
+		for (const HashRateSlot& slot : hashRateSlots)
+		{
+			stats.totalHashCount += slot.totalHashCount.load(std::memory_order_relaxed);
+			stats.activeWorkers += slot.inUse.load(std::memory_order_relaxed) ? 1 : 0;
 		}
+
+		stats.hashesPerSecond1s = GetWindowHashRate(1, currentSecond, currentSecondFraction);
+		stats.hashesPerSecond10s = GetWindowHashRate(10, currentSecond, currentSecondFraction);
+		stats.hashesPerSecond60s = GetWindowHashRate(60, currentSecond, currentSecondFraction);
+
+		return stats;
 	}
 
 	double GetCurrentHashesPerSecond()
 	{
-		std::scoped_lock lock(Global::mutex);
-		return Global::currentHashesPerSecond;
+		return Volt::GetHashRateStats().hashesPerSecond1s;
 	}
-}
\ No newline at end of file
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -5,14 +5,53 @@
 
 namespace Volt
 {
-	// Starts recording the hash rate via the hash counter provided.
-	extern VOLT_API void StartHashRateRecord(const uint64_t& hashCounter);
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// Ends hash rate recording and does small calculations to get the final hash rate.
-	extern VOLT_API void EndHashRateRecord();
+	// The number of worker slots in the hash rate registry, if more workers than this are recording at once then the extra
+	// workers share slots (the totals are still kept, but the per-second counts of shared slots may be slightly off).
+	constexpr uint32_t VOLT_MAX_HASH_RATE_WORKERS = 128;
 
-	// Returns the latest recorded hash rate.
+	// A struct which holds a snapshot of the hash rate statistics aggregated across every mining worker.
+	struct HashRateStats
+	{
+		uint64_t totalHashCount = 0; // The number of hashes generated since the program started
+		uint32_t activeWorkers = 0; // The number of workers currently recording hashes
+		double hashesPerSecond1s = 0, hashesPerSecond10s = 0, hashesPerSecond60s = 0; // Sliding window hash rates
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which claims a cache-line-padded slot in the global hash rate registry for a single mining worker.
+	// The worker records the hashes it generates into its own slot without any locking, and the slot is released back to
+	// the registry when the recorder is destroyed.
+	class HashRateRecorder
+	{
+	private:
+		uint32_t slotIndex;
+		bool ownsSlot;
+	public:
+		VOLT_API HashRateRecorder();
+		VOLT_API HashRateRecorder(const HashRateRecorder& recorder) = delete;
+
+		VOLT_API ~HashRateRecorder();
+
+		VOLT_API void operator=(const HashRateRecorder& recorder) = delete;
+
+		// Adds the number of hashes given to the worker's slot, this should only be called by the thread owning the 
+		// recorder. Recording once per chunk of nonces (rather than per hash) is enough for the rates to be accurate.
+		VOLT_API void RecordHashes(uint64_t hashCount);
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the hash rate statistics aggregated across every worker slot, this is lock-free so it can be polled at any
+	// rate without slowing down the workers.
+	extern VOLT_API HashRateStats GetHashRateStats();
+
+	// Returns the hash rate over the last second across every worker.
 	extern VOLT_API double GetCurrentHashesPerSecond();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 }
 
 #endif
@@ -3,6 +3,8 @@
 #include <util/timestamp.h>
 #include <util/random_generation.h>
 
+#include <atomic>
+
 namespace Volt
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -11,13 +13,56 @@ namespace Volt
 	{
 	public:
 		Deque<Transaction> pendingTxs;
+		std::atomic<uint64_t> version;
 	public:
-		Implementation() = default;
+		Implementation() :
+			version(0)
+		{}
+
 		Implementation(const Deque<Transaction>& txs) :
-			pendingTxs(txs)
+			pendingTxs(txs), version(0)
 		{}
 
 		~Implementation() = default;
+
+		// Does every check needed for the transaction to be added to the mempool, except for the verification of its hash 
+		// and signiture. An error code is returned if the transaction can't be added.
+		ErrorCode CheckTransaction(const Chain& chain, const Transaction& tx) const
+		{
+			// Check if transaction is already in the mem pool
+			// If it is then return error
+			for (uint32_t i = 0; i < this->pendingTxs.GetSize(); i++)
+			{
+				if (tx == this->pendingTxs[i])
+					return ErrorID::TRANSACTION_ALREADY_IN_MEMPOOL;
+			}
+
+			// Amount being sent in transaction must be larger than 0, and both it and the fee must be valid amounts
+			if (tx.GetAmount() == 0 || !Volt::IsAmountValid(tx.GetAmount()) || !Volt::IsAmountValid(tx.GetFee()))
+				return ErrorID::TRANSACTION_AMOUNT_INVALID;
+
+			// A sender and recipient key must be specified
+			const PublicKeyField& senderKey = tx.GetSenderKeyField();
+			const PublicKeyField& recipientKey = tx.GetRecipientKeyField();
+
+			if (senderKey.state == BinaryFieldState::EMPTY || recipientKey.state == BinaryFieldState::EMPTY)
+				return ErrorID::TRANSACTION_KEY_NOT_SPECIFIED;
+
+			if (senderKey.state == BinaryFieldState::MALFORMED || recipientKey.state == BinaryFieldState::MALFORMED)
+				return ErrorID::ECDSA_PUBLIC_KEY_INVALID;
+
+			// The sender must have a sufficient balance to execute transaction
+			if (chain.GetAddressBalance(senderKey.data) < (tx.GetAmount() + tx.GetFee()))
+				return ErrorID::TRANSACTION_SENDER_BALANCE_INSUFFICIENT;
+
+			// The transaction timestamp must be within 10 mins of current time
+			// or the transaction is written off as expired
+			constexpr uint64_t timeOutCutoff = 600;
+			if (tx.GetTimestamp() < Volt::GetTimeSinceEpoch() - timeOutCutoff)
+				return ErrorID::TRANSACTION_EXPIRED;
+
+			return ErrorID::NONE;
+		}
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +79,10 @@ namespace Volt
 		impl(std::make_unique<Implementation>(pendingTxs))
 	{}
 
+	MemPool::MemPool(MemPool&& pool) noexcept :
+		impl(std::move(pool.impl))
+	{}
+
 	MemPool::~MemPool() = default;
 
 	void MemPool::operator=(const MemPool& pool)
@@ -41,14 +90,24 @@ namespace Volt
 		this->impl = std::make_unique<Implementation>(pool.impl->pendingTxs);
 	}
 
+	void MemPool::operator=(MemPool&& pool) noexcept
+	{
+		this->impl = std::move(pool.impl);
+	}
+
 	uint32_t MemPool::GetPoolSize() const
 	{
 		return (uint32_t)this->impl->pendingTxs.GetSize();
 	}
 
+	uint64_t MemPool::GetVersion() const
+	{
+		return this->impl->version.load(std::memory_order_acquire);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	Transaction CreateNewTransaction(double amount, double fee, const ECKeyPair& senderKeyPair, 
+	Transaction CreateNewTransaction(Amount amount, Amount fee, const ECKeyPair& senderKeyPair, 
 		const ECKeyPair& recipientPublicKey, ErrorCode* error)
 	{
 		Transaction tx(TransactionType::TRANSFER, Volt::GenerateRandomUint64(0, UINT64_MAX), amount, fee,
@@ -60,52 +119,93 @@ namespace Volt
 
 	ErrorCode PushTransaction(MemPool& pool, const Chain& chain, const Transaction& tx)
 	{
-		// Check if transaction is already in the mem pool
-		// If it is then return error
-		const Deque<Transaction>& txsPool = pool.impl->pendingTxs;
-		for (uint32_t i = 0; i < txsPool.GetSize(); i++)
+		ErrorCode error = pool.impl->CheckTransaction(chain, tx);
+		if (error)
+			return error;
+
+		// The signiture of the transaction must be valid
+		error = Volt::VerifyTransaction(tx);
+		if (error)
+			return error;
+
+		// The transaction has been deduced as valid so add it to mempool
+		pool.impl->pendingTxs.PushBackElement(tx);
+		pool.impl->version++;
+
+		return ErrorID::NONE;
+	}
+
+	uint32_t PushTransactions(MemPool& pool, const Chain& chain, const std::vector<Transaction>& txs,
+		std::vector<ErrorCode>* errorsOutput)
+	{
+		std::vector<ErrorCode> errors(txs.size());
+		std::vector<const Transaction*> candidates;
+		std::vector<size_t> candidateIndices;
+
+		// Do the cheap checks first, transactions repeated within the batch are treated as already being in the mempool
+		for (size_t index = 0; index < txs.size(); index++)
 		{
-			if (tx == txsPool[i])
-				return ErrorID::TRANSACTION_ALREADY_IN_MEMPOOL;
+			errors[index] = pool.impl->CheckTransaction(chain, txs[index]);
+			if (errors[index])
+				continue;
+
+			for (const Transaction* candidate : candidates)
+			{
+				if (*candidate == txs[index])
+				{
+					errors[index] = ErrorID::TRANSACTION_ALREADY_IN_MEMPOOL;
+					break;
+				}
+			}
+
+			if (!errors[index])
+			{
+				candidates.emplace_back(&txs[index]);
+				candidateIndices.emplace_back(index);
+			}
 		}
 
-		// Amount being sent in transaction must be larger than 0
-		if (tx.GetAmount() == 0)
-			return ErrorID::TRANSACTION_AMOUNT_INVALID;
+		// Verify the signitures of the remaining transactions in parallel, the batch stops at the first invalid transaction
+		// so verification is resumed after it until every transaction has been checked
+		for (size_t offset = 0; offset < candidates.size(); )
+		{
+			size_t failedIndex = 0;
+			const std::vector<const Transaction*> batch(candidates.begin() + offset, candidates.end());
 
-		// A sender and recipient key must be specified
-		if (tx.GetSenderKey().empty() || tx.GetRecipientKey().empty())
-			return ErrorID::TRANSACTION_KEY_NOT_SPECIFIED;
+			ErrorCode error = Volt::VerifyTransactionsBatch(batch, &failedIndex);
+			if (!error)
+				break;
 
-		// The sender must have a sufficient balance to execute transaction
-		ErrorCode keyPairError;
-		ECKeyPair publicKey(tx.GetSenderKey(), std::string(), &keyPairError);
-		if (keyPairError)
-			return keyPairError;
+			errors[candidateIndices[offset + failedIndex]] = error;
+			offset += failedIndex + 1;
+		}
 
-		if (chain.GetAddressBalance(publicKey) < (tx.GetAmount() + tx.GetFee()))
-			return ErrorID::TRANSACTION_SENDER_BALANCE_INSUFFICIENT;
+		// Add the valid transactions to the mempool in the order given
+		uint32_t numPushedTxs = 0;
+		for (size_t index = 0; index < txs.size(); index++)
+		{
+			if (!errors[index])
+			{
+				pool.impl->pendingTxs.PushBackElement(txs[index]);
+				numPushedTxs++;
+			}
+		}
 
-		// The transaction timestamp must be within 10 mins of current time
-		// or the transaction is written off as expired
-		constexpr uint64_t timeOutCutoff = 600;
-		if (tx.GetTimestamp() < Volt::GetTimeSinceEpoch() - timeOutCutoff)
-			return ErrorID::TRANSACTION_EXPIRED;
+		if (numPushedTxs > 0)
+			pool.impl->version++;
 
-		// The signiture of the transaction must be valid
-		ErrorCode error = Volt::VerifyTransaction(tx);
-		if (error)
-			return error;
+		if (errorsOutput)
+			*errorsOutput = std::move(errors);
 
-		// The transaction has been deduced as valid so add it to mempool
-		pool.impl->pendingTxs.PushBackElement(tx);
-		return ErrorID::NONE;
+		return numPushedTxs;
 	}
 
 	Transaction PopTransactionAtIndex(MemPool& pool, size_t index)
 	{
 		const Transaction tx = pool.impl->pendingTxs[index];
 		pool.impl->pendingTxs.PopElementAtIndex(index);
+		pool.impl->version++;
+
 		return tx;
 	}
 
@@ -114,6 +214,7 @@ namespace Volt
 		// Pop transactions off the mempool queue and insert them intot the transaction vector
 		std::vector<Transaction> poppedTxs;
 		const uint32_t poolSize = (uint32_t)pool.impl->pendingTxs.GetSize();
+		poppedTxs.reserve(std::min(numTxs, poolSize));
 
 		for (uint32_t i = 0; i < numTxs; i++)
 		{
@@ -128,15 +229,56 @@ namespace Volt
 				break;
 		}
 
+		if (!poppedTxs.empty())
+			pool.impl->version++;
+
 		return poppedTxs;
 	}
 
+	std::vector<Transaction> PeekTransactions(const MemPool& pool, uint32_t numTxs)
+	{
+		std::vector<Transaction> peekedTxs;
+		const uint32_t numPeekedTxs = std::min(numTxs, (uint32_t)pool.impl->pendingTxs.GetSize());
+		peekedTxs.reserve(numPeekedTxs);
+
+		for (uint32_t index = 0; index < numPeekedTxs; index++)
+			peekedTxs.emplace_back(pool.impl->pendingTxs[index]);
+
+		return peekedTxs;
+	}
+
+	uint32_t RemoveTransactions(MemPool& pool, const Vector<Transaction>& txs)
+	{
+		uint32_t numRemovedTxs = 0;
+		for (size_t txIndex = 0; txIndex < txs.GetSize(); txIndex++)
+		{
+			for (size_t index = 0; index < pool.impl->pendingTxs.GetSize(); index++)
+			{
+				if (pool.impl->pendingTxs[index].GetTxDigestField() == txs[txIndex].GetTxDigestField())
+				{
+					pool.impl->pendingTxs.PopElementAtIndex(index);
+					numRemovedTxs++;
+					break;
+				}
+			}
+		}
+
+		if (numRemovedTxs > 0)
+			pool.impl->version++;
+
+		return numRemovedTxs;
+	}
+
 	ErrorCode FindTransaction(const MemPool& pool, const std::string& txHash, Transaction& returnedTx)
 	{
+		// The digests are compared first so the hash strings are only generated for the matching transaction
+		const DigestField txDigest = Volt::ConvertHexToDigestField(txHash.data(),
+			std::min(txHash.size(), (size_t)SHA_256_DIGEST_LENGTH_HEX));
+
 		for (uint32_t index = 0; index < pool.GetPoolSize(); index++)
 		{
 			const Transaction& tx = pool.impl->pendingTxs[index];
-			if (tx.GetTxHash() == txHash)
+			if (tx.GetTxDigestField() == txDigest && tx.GetTxHash() == txHash)
 			{
 				returnedTx = tx;
 				return ErrorID::NONE;
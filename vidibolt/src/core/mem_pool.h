@@ -3,6 +3,7 @@
 
 #include <util/volt_api.h>
 #include <util/ts_deque.h>
+#include <util/ts_vector.h>
 #include <core/transaction.h>
 
 #include <vector>
@@ -25,20 +26,32 @@ namespace Volt
 		VOLT_API MemPool(const MemPool& pool);
 		VOLT_API MemPool(const Deque<Transaction>& pendingTxs);
 
+		// Takes the pending transactions of the other mempool without copying them, the mempool moved from can only be
+		// assigned to or destroyed.
+		VOLT_API MemPool(MemPool&& pool) noexcept;
+
 		VOLT_API ~MemPool();
 
-		// Operator overload for assignment operations.
+		// Operator overloads for assignment operations.
 		VOLT_API void operator=(const MemPool& pool);
+		VOLT_API void operator=(MemPool&& pool) noexcept;
 
 		// Creates and initializes new regular transfer transaction, the created and initialized transaction object is returned.
 		// Potential errors are returned via the last parameter 'error'.
-		friend extern VOLT_API Transaction CreateNewTransaction(double amount, double fee, const ECKeyPair& senderKeyPair,
+		friend extern VOLT_API Transaction CreateNewTransaction(Amount amount, Amount fee, const ECKeyPair& senderKeyPair,
 			const ECKeyPair& recipientPublicKey, ErrorCode *error = nullptr);
 
 		// Pushes given transaction into the mempool, also note that the transaction given must be signed and valid.
 		// An error code is returned in the event of a failure occurring.
 		friend extern VOLT_API ErrorCode PushTransaction(MemPool& pool, const Chain& chain, const Transaction& tx);
 
+		// Pushes the batch of transactions given into the mempool, each transaction goes through the same checks as in
+		// PushTransaction() but their signitures are verified in parallel. The valid transactions are added in the order
+		// given, while the error code for each transaction is returned via 'errorsOutput' if given.
+		// Returns the number of transactions that were added.
+		friend extern VOLT_API uint32_t PushTransactions(MemPool& pool, const Chain& chain,
+			const std::vector<Transaction>& txs, std::vector<ErrorCode>* errorsOutput = nullptr);
+
 		// Pops the transaction at the specified index in the queue from the mempool then returns it.
 		friend extern VOLT_API Transaction PopTransactionAtIndex(MemPool& pool, size_t index);
 
@@ -47,6 +60,15 @@ namespace Volt
 		// in the mempool than that specified to be popped (via numTxs).
 		friend extern VOLT_API std::vector<Transaction> PopTransactions(MemPool& pool, uint32_t numTxs);
 
+		// Returns copies of the specified number of transactions at the front of the mempool queue without popping them.
+		// Note that less transactions than specified are returned if there isn't enough pending transactions in the mempool.
+		friend extern VOLT_API std::vector<Transaction> PeekTransactions(const MemPool& pool, uint32_t numTxs);
+
+		// Removes every pending transaction from the mempool which is also in the transactions given, this should be done 
+		// for the transactions of each block that lands on the chain.
+		// Returns the number of transactions that were removed.
+		friend extern VOLT_API uint32_t RemoveTransactions(MemPool& pool, const Vector<Transaction>& txs);
+
 		// Looks through the mempool for the pending transaction matching the given transaction hash.
 		// If the transaction is found, it is returned via the second parameter 'returnedTx'.
 		// An error code is returned if something goes wrong e.g. the transaction not being found etc.
@@ -55,6 +77,10 @@ namespace Volt
 
 		// Returns the number of pending transactions in the mempool.
 		uint32_t GetPoolSize() const;
+
+		// Returns the version of the mempool, this is increased every time a transaction is added to or removed from the
+		// mempool. It allows watchers (e.g. block templates) to cheaply check whether the mempool has changed.
+		VOLT_API uint64_t GetVersion() const;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,169 @@
+#include <core/merkle_tree.h>
+#include <crypto/sha256.h>
+
+namespace
+{
+	// Returns the hash of the parent node of the two child nodes given.
+	Volt::MerkleHash GenerateParentHash(const Volt::MerkleHash& left, const Volt::MerkleHash& right)
+	{
+		uint8_t nodeData[1 + sizeof(Volt::MerkleHash) * 2];
+		nodeData[0] = 0x01; // Prefix separating parent nodes from leaves
+		std::copy(left.begin(), left.end(), nodeData + 1);
+		std::copy(right.begin(), right.end(), nodeData + 1 + left.size());
+
+		Volt::MerkleHash parent = {};
+		Volt::GetSHA256Digest(nodeData, sizeof(nodeData), parent);
+
+		return parent;
+	}
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class MerkleTree::Implementation
+	{
+	public:
+		std::vector<std::vector<MerkleHash>> levels; // The leaves are stored in the first level, the root in the last
+		MerkleHash emptyRoot;
+	public:
+		Implementation() :
+			levels(1), emptyRoot()
+		{}
+
+		Implementation(const Implementation& impl) = default;
+
+		Implementation(const std::vector<MerkleHash>& leaves) :
+			levels({ leaves }), emptyRoot()
+		{
+			this->RegenerateFrom(0);
+		}
+
+		~Implementation() = default;
+
+		// Regenerates every parent node which depends on the leaves from the index given onwards.
+		void RegenerateFrom(size_t leafIndex)
+		{
+			size_t level = 0, changedIndex = leafIndex;
+
+			for (; this->levels[level].size() > 1; level++)
+			{
+				if (this->levels.size() <= level + 1)
+					this->levels.emplace_back();
+
+				const std::vector<MerkleHash>& children = this->levels[level];
+				std::vector<MerkleHash>& parents = this->levels[level + 1];
+				parents.resize((children.size() + 1) / 2);
+
+				for (size_t index = changedIndex / 2; index < parents.size(); index++)
+				{
+					const size_t leftIndex = index * 2;
+					parents[index] = (leftIndex + 1 < children.size()) ? 
+						GenerateParentHash(children[leftIndex], children[leftIndex + 1]) : children[leftIndex];
+				}
+
+				changedIndex /= 2;
+			}
+
+			// Remove levels left over from when the tree was taller
+			this->levels.resize(level + 1);
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	MerkleTree::MerkleTree() :
+		impl(std::make_unique<Implementation>())
+	{}
+
+	MerkleTree::MerkleTree(const MerkleTree& tree) :
+		impl(std::make_unique<Implementation>(*tree.impl))
+	{}
+
+	MerkleTree::MerkleTree(const std::vector<MerkleHash>& leaves) :
+		impl(std::make_unique<Implementation>(leaves))
+	{}
+
+	MerkleTree::MerkleTree(MerkleTree&& tree) noexcept :
+		impl(std::move(tree.impl))
+	{}
+
+	MerkleTree::~MerkleTree() = default;
+
+	void MerkleTree::operator=(const MerkleTree& tree)
+	{
+		this->impl = std::make_unique<Implementation>(*tree.impl);
+	}
+
+	void MerkleTree::operator=(MerkleTree&& tree) noexcept
+	{
+		this->impl = std::move(tree.impl);
+	}
+
+	void MerkleTree::AppendLeaf(const MerkleHash& leaf)
+	{
+		this->impl->levels.front().emplace_back(leaf);
+		this->impl->RegenerateFrom(this->impl->levels.front().size() - 1);
+	}
+
+	void MerkleTree::RemoveLeaf(size_t index)
+	{
+		std::vector<MerkleHash>& leaves = this->impl->levels.front();
+		if (index < leaves.size())
+		{
+			leaves.erase(leaves.begin() + index);
+			this->impl->RegenerateFrom(index);
+		}
+	}
+
+	void MerkleTree::ClearLeaves()
+	{
+		this->impl->levels.assign(1, {});
+	}
+
+	ErrorCode MerkleTree::GenerateProof(size_t index, std::vector<MerkleProofStep>& proof) const
+	{
+		if (index >= this->GetLeafCount())
+			return ErrorID::MERKLE_LEAF_INDEX_INVALID;
+
+		// Walk up from the leaf to the root, collecting the sibling of the node at each level
+		proof.clear();
+		for (size_t level = 0; level + 1 < this->impl->levels.size(); level++)
+		{
+			const std::vector<MerkleHash>& nodes = this->impl->levels[level];
+			const size_t siblingIndex = index ^ 1;
+
+			if (siblingIndex < nodes.size()) // Nodes without a sibling are carried up as they are
+				proof.push_back({ nodes[siblingIndex], siblingIndex < index });
+
+			index /= 2;
+		}
+
+		return ErrorID::NONE;
+	}
+
+	const MerkleHash& MerkleTree::GetRoot() const
+	{
+		const std::vector<MerkleHash>& rootLevel = this->impl->levels.back();
+		return rootLevel.empty() ? this->impl->emptyRoot : rootLevel.front();
+	}
+
+	size_t MerkleTree::GetLeafCount() const
+	{
+		return this->impl->levels.front().size();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool VerifyMerkleProof(const MerkleHash& leaf, const std::vector<MerkleProofStep>& proof, const MerkleHash& root)
+	{
+		MerkleHash node = leaf;
+		for (const MerkleProofStep& step : proof)
+			node = step.siblingOnLeft ? GenerateParentHash(step.siblingHash, node) : GenerateParentHash(node, step.siblingHash);
+
+		return node == root;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
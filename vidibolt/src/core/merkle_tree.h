@@ -0,0 +1,83 @@
+#ifndef VIDIBOLT_CORE_MERKLE_TREE_H
+#define VIDIBOLT_CORE_MERKLE_TREE_H
+
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+
+#include <vector>
+#include <memory>
+#include <array>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The type of the hashes stored in the nodes of a merkle tree.
+	using MerkleHash = std::array<uint8_t, 32>;
+
+	// A struct which holds a single step of a merkle proof, which is the hash of the sibling node on the path from a leaf
+	// to the root of the tree.
+	struct MerkleProofStep
+	{
+		MerkleHash siblingHash;
+		bool siblingOnLeft;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which builds and stores a binary merkle tree over a list of leaf hashes.
+	// Every level of the tree is kept so that appending or removing leaves only regenerates the nodes which are affected,
+	// for example appending a leaf only regenerates the nodes on the path from the new leaf to the root.
+	// 
+	// Each parent node is the SHA256 hash of [ [uint8_t] 0x01, [32 bytes] Left Child, [32 bytes] Right Child ], while a
+	// node without a sibling is carried up to the next level as it is.
+	class MerkleTree
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		VOLT_API MerkleTree();
+		VOLT_API MerkleTree(const MerkleTree& tree);
+		VOLT_API MerkleTree(const std::vector<MerkleHash>& leaves);
+
+		// Takes the nodes of the other tree without copying them, the tree moved from can only be assigned to or destroyed.
+		VOLT_API MerkleTree(MerkleTree&& tree) noexcept;
+
+		VOLT_API ~MerkleTree();
+
+		// Operator overloads for assignment operations.
+		VOLT_API void operator=(const MerkleTree& tree);
+		VOLT_API void operator=(MerkleTree&& tree) noexcept;
+
+		// Appends the leaf hash given to the end of the tree.
+		VOLT_API void AppendLeaf(const MerkleHash& leaf);
+
+		// Removes the leaf at the index specified from the tree.
+		VOLT_API void RemoveLeaf(size_t index);
+
+		// Removes every leaf from the tree.
+		VOLT_API void ClearLeaves();
+
+		// Generates the proof that the leaf at the index specified is part of the tree.
+		// The proof is returned via the second parameter 'proof'.
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode GenerateProof(size_t index, std::vector<MerkleProofStep>& proof) const;
+
+		// Returns the root hash of the tree, the root of an empty tree is a zeroed hash.
+		VOLT_API const MerkleHash& GetRoot() const;
+
+		// Returns the number of leaves in the tree.
+		VOLT_API size_t GetLeafCount() const;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns TRUE if the proof given shows that the leaf is part of the tree with the root given, else FALSE is returned.
+	extern VOLT_API bool VerifyMerkleProof(const MerkleHash& leaf, const std::vector<MerkleProofStep>& proof,
+		const MerkleHash& root);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
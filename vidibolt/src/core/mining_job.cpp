@@ -0,0 +1,497 @@
+#include <core/mining_job.h>
+#include <core/hash_stats.h>
+#include <core/nonce_partition.h>
+#include <crypto/sha256_kernel.h>
+#include <util/data_conversion.h>
+#include <util/timestamp.h>
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+
+namespace
+{
+	// The hash counter of a worker, each counter is kept on its own cache line so the workers don't contend over them.
+	struct alignas(64) WorkerHashCounter
+	{
+		std::atomic<uint64_t> hashCount = 0;
+	};
+
+	// A block template being mined along with everything the workers need to search it.
+	struct MiningTemplate
+	{
+		uint64_t id;
+		Volt::Block block;
+		Volt::NonceKernelInput kernelInput;
+		Volt::DifficultyTarget target, shareTarget;
+		std::vector<Volt::NoncePartition> partitions;
+		uint32_t exhaustedWorkers;
+
+		MiningTemplate(uint64_t id, const Volt::Block& block, uint32_t numPartitions) :
+			id(id), block(block), kernelInput(), target(), shareTarget(), partitions(numPartitions), exhaustedWorkers(0)
+		{}
+	};
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	MiningCancellationToken::MiningCancellationToken() :
+		stopRequested(std::make_shared<std::atomic<bool>>(false))
+	{}
+
+	MiningCancellationToken::MiningCancellationToken(const MiningCancellationToken& token) :
+		stopRequested(token.stopRequested)
+	{}
+
+	MiningCancellationToken::~MiningCancellationToken() = default;
+
+	void MiningCancellationToken::operator=(const MiningCancellationToken& token)
+	{
+		this->stopRequested = token.stopRequested;
+	}
+
+	void MiningCancellationToken::RequestStop()
+	{
+		this->stopRequested->store(true, std::memory_order_relaxed);
+	}
+
+	bool MiningCancellationToken::IsStopRequested() const
+	{
+		return this->stopRequested->load(std::memory_order_relaxed);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class MiningJob::Implementation
+	{
+	public:
+		uint32_t numThreads;
+		uint64_t nonceStart, nonceEnd;
+		MiningCancellationToken token;
+
+		MiningProgressCallback progressCallback;
+		std::chrono::milliseconds progressInterval;
+
+		MiningShareCallback shareCallback;
+		uint64_t shareDifficulty;
+		bool timestampRolling;
+
+		std::vector<std::thread> workers;
+		std::thread progressThread;
+		std::unique_ptr<WorkerHashCounter[]> hashCounters;
+		std::mutex threadsMutex;
+
+		// The state below is guarded by the mutex, apart from the atomics which are read by the workers without locking
+		mutable std::mutex mutex;
+		std::condition_variable stateChanged;
+		std::shared_ptr<MiningTemplate> currentTemplate;
+		std::atomic<uint64_t> currentTemplateID;
+		std::atomic<bool> finished;
+		bool started;
+
+		ErrorCode resultError;
+		Block minedBlock;
+	public:
+		Implementation(uint32_t numThreads) :
+			numThreads(numThreads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : numThreads), nonceStart(0),
+			nonceEnd(UINT64_MAX), progressInterval(1000), shareDifficulty(0), timestampRolling(true), currentTemplateID(0),
+			finished(true), started(false)
+		{}
+
+		~Implementation()
+		{
+			this->Finish(ErrorID::MINING_JOB_CANCELLED);
+			this->JoinThreads();
+		}
+
+		// Creates the search state for the block template given, the template isn't made current by this function.
+		// If the kernel input of the block isn't given then it is generated from the block header.
+		ErrorCode CreateTemplate(const Block& block, const NonceKernelInput* kernelInput, uint64_t id,
+			std::shared_ptr<MiningTemplate>& templateOutput) const
+		{
+			auto miningTemplate = std::make_shared<MiningTemplate>(id, block, this->numThreads);
+
+			if (kernelInput)
+				miningTemplate->kernelInput = *kernelInput;
+			else
+			{
+				ErrorCode error = Volt::GetBlockNonceKernelInput(block, miningTemplate->kernelInput);
+				if (error)
+					return error;
+			}
+
+			miningTemplate->target = Volt::GetDifficultyTarget(block.GetDifficulty());
+			miningTemplate->shareTarget = Volt::GetDifficultyTarget(this->shareDifficulty);
+			Volt::AssignNoncePartitions(miningTemplate->partitions, this->nonceStart, this->nonceEnd);
+
+			templateOutput = miningTemplate;
+			return ErrorID::NONE;
+		}
+
+		// Starts the job on the block given, see MiningJob::Start().
+		ErrorCode Start(const Block& block, const NonceKernelInput* kernelInput, const MiningCancellationToken& token,
+			uint64_t nonceStart, uint64_t nonceEnd)
+		{
+			// Make sure that the min nonce isn't larger than the max nonce
+			if (nonceStart > nonceEnd)
+				return ErrorID::NONCE_MIN_LARGER_THAN_NONCE_MAX;
+
+			if (!this->finished)
+				return ErrorID::MINING_JOB_ALREADY_RUNNING;
+
+			// Clean up the threads of the previous run of the job
+			this->JoinThreads();
+
+			this->nonceStart = nonceStart;
+			this->nonceEnd = nonceEnd;
+			this->token = token;
+
+			std::shared_ptr<MiningTemplate> miningTemplate;
+			ErrorCode error = this->CreateTemplate(block, kernelInput, 0, miningTemplate);
+			if (error)
+				return error;
+
+			{
+				std::scoped_lock lock(this->mutex);
+				this->currentTemplate = miningTemplate;
+				this->currentTemplateID = 0;
+				this->resultError = ErrorID::NONE;
+				this->minedBlock = Block();
+				this->finished = false;
+				this->started = true;
+			}
+
+			// Start up the worker threads and the progress thread (if there's a callback to report to)
+			this->hashCounters = std::make_unique<WorkerHashCounter[]>(this->numThreads);
+			this->workers.reserve(this->numThreads);
+
+			for (uint32_t index = 0; index < this->numThreads; index++)
+				this->workers.emplace_back(&Implementation::RunWorker, this, index);
+
+			if (this->progressCallback)
+				this->progressThread = std::thread(&Implementation::RunProgressReporter, this);
+
+			return ErrorID::NONE;
+		}
+
+		// Swaps the block being mined by the job, see MiningJob::SwapTemplate().
+		ErrorCode SwapTemplate(const Block& block, const NonceKernelInput* kernelInput)
+		{
+			if (this->finished)
+				return ErrorID::MINING_JOB_NOT_RUNNING;
+
+			std::shared_ptr<MiningTemplate> miningTemplate;
+			ErrorCode error = this->CreateTemplate(block, kernelInput, this->currentTemplateID + 1, miningTemplate);
+			if (error)
+				return error;
+
+			std::scoped_lock lock(this->mutex);
+			if (this->finished)
+				return ErrorID::MINING_JOB_NOT_RUNNING;
+
+			// Make sure the template ID is unique even if the template was swapped from multiple threads at once
+			miningTemplate->id = this->currentTemplateID + 1;
+			this->currentTemplate = miningTemplate;
+			this->currentTemplateID.store(miningTemplate->id, std::memory_order_release);
+			this->stateChanged.notify_all();
+
+			return ErrorID::NONE;
+		}
+
+		// Replaces the exhausted template given with a copy that has its timestamp rolled forward, giving the workers a new 
+		// search space over the same nonce range. The timestamp is never rolled past the drift allowed by VerifyBlock().
+		// Returns FALSE if the timestamp can't be rolled any further. The mutex must already be locked by the caller.
+		bool RollSearchSpaceLocked(const MiningTemplate& exhaustedTemplate)
+		{
+			const uint64_t timeNow = Volt::GetTimeSinceEpoch();
+			const uint64_t rolledTimestamp = std::max(exhaustedTemplate.block.GetTimestamp() + 1, timeNow);
+			if (rolledTimestamp > timeNow + VOLT_MAX_BLOCK_TIMESTAMP_DRIFT)
+				return false;
+
+			auto miningTemplate = std::make_shared<MiningTemplate>(exhaustedTemplate.id + 1, exhaustedTemplate.block, 
+				this->numThreads);
+
+			Volt::SetBlockTimestamp(miningTemplate->block, rolledTimestamp);
+			miningTemplate->kernelInput = exhaustedTemplate.kernelInput;
+			Volt::SetKernelInputSearchSpace(miningTemplate->kernelInput, rolledTimestamp, miningTemplate->block.GetExtraNonce());
+
+			miningTemplate->target = exhaustedTemplate.target;
+			miningTemplate->shareTarget = exhaustedTemplate.shareTarget;
+			Volt::AssignNoncePartitions(miningTemplate->partitions, this->nonceStart, this->nonceEnd);
+
+			this->currentTemplate = miningTemplate;
+			this->currentTemplateID.store(miningTemplate->id, std::memory_order_release);
+			this->stateChanged.notify_all();
+
+			return true;
+		}
+
+		// Marks the job as finished with the result given, this does nothing if the job has already finished.
+		void Finish(ErrorCode error)
+		{
+			std::scoped_lock lock(this->mutex);
+			this->FinishLocked(error);
+		}
+
+		// Same as Finish() but expects the mutex to already be locked by the caller.
+		void FinishLocked(ErrorCode error)
+		{
+			if (!this->finished)
+			{
+				this->resultError = error;
+				this->finished = true;
+				this->stateChanged.notify_all();
+			}
+		}
+
+		// Waits for the worker threads and the progress thread to exit.
+		void JoinThreads()
+		{
+			std::scoped_lock lock(this->threadsMutex);
+
+			for (std::thread& worker : this->workers)
+			{
+				if (worker.joinable())
+					worker.join();
+			}
+
+			this->workers.clear();
+
+			if (this->progressThread.joinable())
+				this->progressThread.join();
+		}
+
+		// Returns the total number of hashes generated by the workers since the job was started.
+		uint64_t GetTotalHashCount() const
+		{
+			uint64_t totalHashCount = 0;
+			for (uint32_t index = 0; index < this->numThreads; index++)
+				totalHashCount += this->hashCounters[index].hashCount.load(std::memory_order_relaxed);
+
+			return totalHashCount;
+		}
+
+		// The loop run by each worker thread, chunks of nonces are claimed from the current template (starting with the
+		// worker's own partition) until the job finishes.
+		void RunWorker(uint32_t workerIndex)
+		{
+			const NonceKernel kernel = Volt::GetBestNonceKernel();
+			const uint32_t laneCount = Volt::GetNonceKernelLaneCount(kernel);
+
+			WorkerHashCounter& counter = this->hashCounters[workerIndex];
+			HashRateRecorder hashRateRecorder;
+			std::shared_ptr<MiningTemplate> miningTemplate;
+			uint32_t digests[SHA_256_KERNEL_MAX_LANES][8];
+
+			while (!this->finished.load(std::memory_order_relaxed))
+			{
+				// Move onto the latest template if it has been swapped
+				if (!miningTemplate || miningTemplate->id != this->currentTemplateID.load(std::memory_order_acquire))
+				{
+					std::scoped_lock lock(this->mutex);
+					miningTemplate = this->currentTemplate;
+				}
+
+				uint64_t chunkStart = 0, chunkEnd = 0;
+				bool chunkClaimed = false;
+
+				for (uint32_t offset = 0; offset < this->numThreads && !chunkClaimed; offset++)
+				{
+					chunkClaimed = miningTemplate->partitions[(workerIndex + offset) % this->numThreads].ClaimChunk(
+						chunkStart, chunkEnd);
+				}
+
+				if (!chunkClaimed)
+				{
+					// Every nonce of the template has been claimed, once all the workers have run out of work the timestamp
+					// is rolled forward to get a fresh search space (the job finishes if it can't be rolled any further or
+					// rolling is disabled). Otherwise wait for the template to be swapped
+					std::unique_lock lock(this->mutex);
+					if (miningTemplate->id == this->currentTemplateID && ++miningTemplate->exhaustedWorkers == this->numThreads)
+					{
+						if (!this->timestampRolling || !this->RollSearchSpaceLocked(*miningTemplate))
+							this->FinishLocked(ErrorID::NO_HASH_SOLUTION_FOUND_IN_NONCE_RANGE);
+					}
+
+					this->stateChanged.wait(lock, [&]()
+					{
+						return this->finished || miningTemplate->id != this->currentTemplateID;
+					});
+
+					continue;
+				}
+
+				uint64_t chunkHashCount = 0;
+				for (uint64_t batchStart = chunkStart; ; batchStart += laneCount)
+				{
+					// Stop hashing the chunk if the job has finished, was cancelled or the template was swapped
+					if (this->finished.load(std::memory_order_relaxed))
+						break;
+
+					if (this->token.IsStopRequested())
+					{
+						this->Finish(ErrorID::MINING_JOB_CANCELLED);
+						break;
+					}
+
+					if (miningTemplate->id != this->currentTemplateID.load(std::memory_order_relaxed))
+						break;
+
+					Volt::HashNonceBatch(kernel, miningTemplate->kernelInput, batchStart, digests);
+
+					const uint64_t lanesInChunk = std::min<uint64_t>(laneCount, chunkEnd - batchStart + 1);
+					counter.hashCount.fetch_add(lanesInChunk, std::memory_order_relaxed);
+					chunkHashCount += lanesInChunk;
+
+					for (uint32_t lane = 0; lane < lanesInChunk; lane++)
+					{
+						if (this->shareCallback && Volt::DigestMeetsTarget(digests[lane], miningTemplate->shareTarget))
+							this->shareCallback({ batchStart + lane, miningTemplate->id });
+
+						if (Volt::DigestMeetsTarget(digests[lane], miningTemplate->target))
+						{
+							this->SubmitSolution(*miningTemplate, batchStart + lane, digests[lane]);
+							break;
+						}
+					}
+
+					if (chunkEnd - batchStart < laneCount)
+						break;
+				}
+
+				hashRateRecorder.RecordHashes(chunkHashCount);
+			}
+		}
+
+		// Finishes the job with the solution given, as long as the solution belongs to the current template.
+		void SubmitSolution(const MiningTemplate& miningTemplate, uint64_t nonce, const uint32_t(&digestWords)[8])
+		{
+			DigestField blockHash = { {}, BinaryFieldState::VALID };
+			Volt::ConvertDigestWordsToBytes(digestWords, blockHash.data.data());
+
+			std::scoped_lock lock(this->mutex);
+			if (this->finished || miningTemplate.id != this->currentTemplateID)
+				return;
+
+			const Block& block = miningTemplate.block;
+			this->minedBlock = Block(block.GetIndex(), block.GetPreviousBlockHashField(), block.GetTransactions(),
+				block.GetDifficulty(), blockHash, block.GetTimestamp(), nonce, block.GetExtraNonce());
+
+			this->FinishLocked(ErrorID::NONE);
+		}
+
+		// The loop run by the progress thread, the progress callback is called every interval until the job finishes.
+		void RunProgressReporter()
+		{
+			uint64_t lastHashCount = 0;
+			auto lastReportTime = std::chrono::steady_clock::now();
+			bool jobFinished = false;
+
+			while (!jobFinished)
+			{
+				{
+					std::unique_lock lock(this->mutex);
+					jobFinished = this->stateChanged.wait_for(lock, this->progressInterval, [&]() { return this->finished.load(); });
+				}
+
+				const auto timeNow = std::chrono::steady_clock::now();
+				const double timeElapsed = std::chrono::duration<double>(timeNow - lastReportTime).count();
+
+				MiningProgress progress;
+				progress.noncesTried = this->GetTotalHashCount();
+				progress.hashesPerSecond = timeElapsed > 0 ? (double)(progress.noncesTried - lastHashCount) / timeElapsed : 0;
+				progress.templateID = this->currentTemplateID;
+
+				this->progressCallback(progress);
+
+				lastHashCount = progress.noncesTried;
+				lastReportTime = timeNow;
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	MiningJob::MiningJob(uint32_t numThreads) :
+		impl(std::make_unique<Implementation>(numThreads))
+	{}
+
+	MiningJob::~MiningJob() = default;
+
+	void MiningJob::SetProgressCallback(MiningProgressCallback callback, std::chrono::milliseconds interval)
+	{
+		this->impl->progressCallback = callback;
+		this->impl->progressInterval = interval;
+	}
+
+	void MiningJob::SetShareCallback(uint64_t shareDifficulty, MiningShareCallback callback)
+	{
+		this->impl->shareDifficulty = shareDifficulty;
+		this->impl->shareCallback = callback;
+	}
+
+	void MiningJob::SetTimestampRolling(bool enabled)
+	{
+		this->impl->timestampRolling = enabled;
+	}
+
+	ErrorCode MiningJob::Start(const Block& blockTemplate, const MiningCancellationToken& token, uint64_t nonceStart,
+		uint64_t nonceEnd)
+	{
+		return this->impl->Start(blockTemplate, nullptr, token, nonceStart, nonceEnd);
+	}
+
+	ErrorCode MiningJob::Start(const BlockTemplate& blockTemplate, const MiningCancellationToken& token, uint64_t nonceStart,
+		uint64_t nonceEnd)
+	{
+		return this->impl->Start(blockTemplate.GetBlock(), &blockTemplate.GetKernelInput(), token, nonceStart, nonceEnd);
+	}
+
+	ErrorCode MiningJob::SwapTemplate(const Block& blockTemplate)
+	{
+		return this->impl->SwapTemplate(blockTemplate, nullptr);
+	}
+
+	ErrorCode MiningJob::SwapTemplate(const BlockTemplate& blockTemplate)
+	{
+		return this->impl->SwapTemplate(blockTemplate.GetBlock(), &blockTemplate.GetKernelInput());
+	}
+
+	void MiningJob::Stop()
+	{
+		this->impl->Finish(ErrorID::MINING_JOB_CANCELLED);
+		this->impl->JoinThreads();
+	}
+
+	ErrorCode MiningJob::WaitForResult(Block& minedBlock)
+	{
+		{
+			std::unique_lock lock(this->impl->mutex);
+			if (!this->impl->started)
+				return ErrorID::MINING_JOB_NOT_RUNNING;
+
+			this->impl->stateChanged.wait(lock, [&]() { return this->impl->finished.load(); });
+		}
+
+		this->impl->JoinThreads();
+
+		if (!this->impl->resultError)
+			minedBlock = this->impl->minedBlock;
+
+		return this->impl->resultError;
+	}
+
+	bool MiningJob::IsRunning() const
+	{
+		return !this->impl->finished;
+	}
+
+	uint32_t MiningJob::GetThreadCount() const
+	{
+		return this->impl->numThreads;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
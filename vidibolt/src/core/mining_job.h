@@ -0,0 +1,145 @@
+#ifndef VIDIBOLT_CORE_MINING_JOB_H
+#define VIDIBOLT_CORE_MINING_JOB_H
+
+#include <core/block.h>
+#include <core/block_template.h>
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A token which allows a mining job to be cancelled from any thread.
+	// Copies of a token share the same state, so a copy can be handed to the job while the original is kept by the caller.
+	class MiningCancellationToken
+	{
+	private:
+		std::shared_ptr<std::atomic<bool>> stopRequested;
+	public:
+		VOLT_API MiningCancellationToken();
+		VOLT_API MiningCancellationToken(const MiningCancellationToken& token);
+
+		VOLT_API ~MiningCancellationToken();
+
+		// Operator overload for assignment operations.
+		VOLT_API void operator=(const MiningCancellationToken& token);
+
+		// Requests that the mining job holding the token stops as soon as possible.
+		VOLT_API void RequestStop();
+
+		// Returns TRUE if a stop has been requested, else FALSE is returned.
+		VOLT_API bool IsStopRequested() const;
+	};
+
+	// A struct which holds a snapshot of the progress of a mining job.
+	struct MiningProgress
+	{
+		uint64_t noncesTried = 0; // The number of nonces tried since the job was started (across every template)
+		double hashesPerSecond = 0; // The hash rate measured over the last progress interval
+		uint64_t templateID = 0; // The ID of the template currently being mined, this increases with every swap or roll
+	};
+
+	using MiningProgressCallback = std::function<void(const MiningProgress&)>;
+
+	// A struct which holds a hash found by a mining job which satisfies the share difficulty of the job.
+	struct MiningShare
+	{
+		uint64_t nonce = 0; // The nonce which produced the hash
+		uint64_t templateID = 0; // The ID of the template the share was found for
+	};
+
+	using MiningShareCallback = std::function<void(const MiningShare&)>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which does proof-of-work on a block template asynchronously.
+	// The worker threads are started once and live for the whole job, so the template being mined can be swapped (e.g.
+	// when a new block arrives from a peer) without tearing them down.
+	//
+	// When every nonce of the current template has been tried, the timestamp of the template is rolled forward (up to the
+	// drift allowed by VerifyBlock()) to get a fresh search space over the same nonce range.
+	//
+	// The job finishes when a solution is found, when the timestamp can't be rolled any further (or timestamp rolling has
+	// been disabled) or when the job is cancelled either via its cancellation token or by calling Stop().
+	class MiningJob
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		// If 'numThreads' is 0 then one worker thread is used per hardware thread.
+		VOLT_API MiningJob(uint32_t numThreads = 0);
+		VOLT_API MiningJob(const MiningJob& job) = delete;
+
+		// The job is stopped (if it's running) before it is destroyed.
+		VOLT_API ~MiningJob();
+
+		VOLT_API void operator=(const MiningJob& job) = delete;
+
+		// Sets the function which is called with the progress of the job every interval given, this must be done before
+		// the job is started. The callback is called from a thread owned by the job, and also once more when the job
+		// finishes.
+		VOLT_API void SetProgressCallback(MiningProgressCallback callback,
+			std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+
+		// Sets the function which is called for every hash found which satisfies the share difficulty given (e.g. when 
+		// mining for a pool), this must be done before the job is started. Hashes satisfying the block difficulty are
+		// reported as shares too, as long as they also satisfy the share difficulty.
+		// Note that the callback is called from the worker threads, so it should return quickly.
+		VOLT_API void SetShareCallback(uint64_t shareDifficulty, MiningShareCallback callback);
+
+		// Sets whether the timestamp of the template is rolled forward once every nonce in the range has been tried, this
+		// is enabled by default. When disabled the job finishes as soon as the nonce range has been exhausted (e.g. when
+		// the range was handed out by a pool, which expects to be asked for more work instead).
+		VOLT_API void SetTimestampRolling(bool enabled);
+
+		// Starts mining the block template (which should be created via the CreateBlock() method) over the nonce range
+		// ['nonceStart', 'nonceEnd'], the function returns immediately.
+		// The job can be cancelled at any point via the token given.
+		//
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode Start(const Block& blockTemplate, const MiningCancellationToken& token = MiningCancellationToken(),
+			uint64_t nonceStart = 0, uint64_t nonceEnd = UINT64_MAX);
+
+		// Same as the function above, except the block held by the template is mined using its cached kernel input, so the
+		// header midstate doesn't have to be regenerated.
+		VOLT_API ErrorCode Start(const BlockTemplate& blockTemplate, const MiningCancellationToken& token = 
+			MiningCancellationToken(), uint64_t nonceStart = 0, uint64_t nonceEnd = UINT64_MAX);
+
+		// Swaps the block template being mined while the job is running, the workers move onto the new template as soon
+		// as they finish the batch of nonces they are currently hashing. Solutions found for the old template are dropped.
+		//
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode SwapTemplate(const Block& blockTemplate);
+
+		// Same as the function above, except the block held by the template is mined using its cached kernel input.
+		// This should be called whenever refreshing the template reports that it has changed.
+		VOLT_API ErrorCode SwapTemplate(const BlockTemplate& blockTemplate);
+
+		// Stops the job and waits for the worker threads to exit.
+		VOLT_API void Stop();
+
+		// Waits for the job to finish, if a solution was found then the mined block is returned via 'minedBlock'.
+		//
+		// An error code is returned if no solution was found, 'ErrorID::MINING_JOB_CANCELLED' is returned if the job was
+		// cancelled before a solution was found and 'ErrorID::NO_HASH_SOLUTION_FOUND_IN_NONCE_RANGE' is returned if the
+		// search space ran out.
+		VOLT_API ErrorCode WaitForResult(Block& minedBlock);
+
+		// Returns TRUE if the job has been started and hasn't finished yet, else FALSE is returned.
+		VOLT_API bool IsRunning() const;
+
+		// Returns the number of worker threads used by the job.
+		VOLT_API uint32_t GetThreadCount() const;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
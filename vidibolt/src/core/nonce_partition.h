@@ -0,0 +1,97 @@
+#ifndef VIDIBOLT_CORE_NONCE_PARTITION_H
+#define VIDIBOLT_CORE_NONCE_PARTITION_H
+
+#include <util/volt_api.h>
+
+#include <atomic>
+#include <vector>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The number of nonces claimed by a mining worker at a time.
+	constexpr uint64_t VOLT_NONCE_CHUNK_SIZE = 4096;
+
+	// A contiguous section of the nonce range being searched by the mining workers.
+	// Chunks of nonces are claimed from the partition atomically so idle workers are able to steal work from it.
+	class alignas(64) NoncePartition
+	{
+	private:
+		std::atomic<uint64_t> next;
+		std::atomic<bool> exhausted;
+		uint64_t last;
+	public:
+		NoncePartition() :
+			next(0), exhausted(true), last(0)
+		{}
+
+		~NoncePartition() = default;
+
+		// Assigns the (inclusive) range of nonces held by the partition.
+		void Assign(uint64_t first, uint64_t last)
+		{
+			this->next = first;
+			this->last = last;
+			this->exhausted = false;
+		}
+
+		// Claims the next chunk of nonces in the partition, the range of the claimed chunk is returned via the parameters.
+		// Returns FALSE if every nonce in the partition has already been claimed.
+		bool ClaimChunk(uint64_t& chunkStart, uint64_t& chunkEnd)
+		{
+			while (!this->exhausted.load(std::memory_order_acquire))
+			{
+				uint64_t current = this->next.load(std::memory_order_acquire);
+				const uint64_t chunkLast = (this->last - current >= VOLT_NONCE_CHUNK_SIZE) ?
+					current + VOLT_NONCE_CHUNK_SIZE - 1 : this->last;
+
+				if (chunkLast == this->last)
+				{
+					// This is the final chunk of the partition, only one worker may claim it
+					bool expected = false;
+					if (this->exhausted.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+					{
+						chunkStart = current;
+						chunkEnd = chunkLast;
+						return true;
+					}
+				}
+				else if (this->next.compare_exchange_weak(current, chunkLast + 1, std::memory_order_acq_rel))
+				{
+					chunkStart = current;
+					chunkEnd = chunkLast;
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Splits the (inclusive) nonce range given evenly across the partitions.
+	// Partitions which would start beyond the end of the nonce range are left empty.
+	inline void AssignNoncePartitions(std::vector<NoncePartition>& partitions, uint64_t nonceStart, uint64_t nonceEnd)
+	{
+		const uint64_t numPartitions = partitions.size();
+		const uint64_t nonceSpan = nonceEnd - nonceStart, partitionSize = (nonceSpan / numPartitions) + 1;
+
+		for (uint64_t index = 0; index < numPartitions; index++)
+		{
+			const uint64_t offset = partitionSize * index;
+			if (offset <= nonceSpan)
+			{
+				const uint64_t partitionLast = (index == numPartitions - 1 || nonceSpan - offset < partitionSize) ?
+					nonceEnd : nonceStart + offset + partitionSize - 1;
+
+				partitions[index].Assign(nonceStart + offset, partitionLast);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -1,140 +1,257 @@
 #include <core/transaction.h>
 #include <util/timestamp.h>
 #include <crypto/sha256.h>
+#include <crypto/signiture_cache.h>
+#include <util/thread_pool.h>
 
-namespace Volt
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <type_traits>
+
+namespace
 {
-	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Batches smaller than this are verified on the calling thread, since waking the thread pool would cost more than it
+	// saves.
+	constexpr size_t minParallelBatchSize = 4;
+
+	// The size of the version and length which start every transaction encoding, and the size of the fixed size fields
+	// which follow them.
+	constexpr size_t encodingHeaderSize = 3, encodingFixedFieldsSize = 33;
 
-	class Transaction::Implementation
+	// Writes the unsigned integer given into the buffer in big-endian byte order.
+	template<typename Ty> void WriteBigEndian(uint8_t* buffer, Ty value)
 	{
-	public:
-		TransactionType type;
-		uint64_t id, timestamp;
-		double amount, fee;
+		for (size_t i = 0; i < sizeof(Ty); i++)
+			buffer[i] = (uint8_t)(value >> (8 * (sizeof(Ty) - 1 - i)));
+	}
 
-		std::string senderPK, recipientPK, signiture, txHash;
-	public:
-		Implementation() :
-			type(TransactionType::TRANSFER), id(0), amount(0), timestamp(0), fee(0)
-		{}
+	// Returns the unsigned integer stored in the buffer in big-endian byte order.
+	template<typename Ty> Ty ReadBigEndian(const uint8_t* buffer)
+	{
+		Ty value = 0;
+		for (size_t i = 0; i < sizeof(Ty); i++)
+			value = (Ty)((value << 8) | buffer[i]);
 
-		Implementation(TransactionType type, uint64_t id, double amount, double fee, uint64_t timestamp, 
-			const std::string& senderPK, const std::string& recipientPK, const std::string& signiture, 
-			const std::string& txHash) :
-			type(type), id(id), amount(amount), fee(fee), timestamp(timestamp), senderPK(senderPK), recipientPK(recipientPK), 
-			signiture(signiture), txHash(txHash)
-		{}
+		return value;
+	}
 
-		~Implementation() = default;
+	// Reads the amount stored in the buffer, FALSE is returned if it isn't a valid amount.
+	bool ReadEncodedAmount(const uint8_t* buffer, Volt::Amount& amountOutput)
+	{
+		amountOutput = (Volt::Amount)ReadBigEndian<uint64_t>(buffer);
+		return Volt::IsAmountValid(amountOutput);
+	}
 
-		// Returns a string containing all the transaction data appended together.
-		std::string GetTransactionDataStr() const
+	// Writes the length of the binary field given followed by its bytes (nothing follows the length if it's empty).
+	// Returns the number of bytes written.
+	template<typename Ty> size_t WriteEncodedField(uint8_t* output, const Volt::BinaryField<Ty>& field)
+	{
+		if (field.state != Volt::BinaryFieldState::VALID)
 		{
-			return std::to_string(this->id) + std::to_string(this->amount) + std::to_string(this->timestamp) +
-				this->senderPK + this->recipientPK;
+			output[0] = 0;
+			return 1;
 		}
 
-		// Generates a hash string based on the transaction's data
-		ErrorCode GenerateTxHash(std::string& generatedHash) const
-		{
-			// Combine all transaction data into one string of data
-			const std::string txData = this->GetTransactionDataStr();
-			const std::vector<uint8_t> txDataBytes = Volt::GetRawString(txData);
-
-			// Get the hash from the transaction data then get the hash from the generated
-			// So basically we are doing the hash operation twice
-			std::vector<uint8_t> outputHash;
-			ErrorCode error = Volt::GetSHA256Digest(txDataBytes, outputHash);
-			if (!error)
-			{
-				error = Volt::GetSHA256Digest(outputHash, outputHash); // Get hash from previous generated hash
-				if (!error)
-				{
-					// Convert timestamp string to hex
-					std::string timestampHex = Volt::ConvertUintToHex(this->timestamp);
-					std::transform(timestampHex.begin(), timestampHex.end(), timestampHex.begin(), ::toupper);
+		output[0] = (uint8_t)field.data.size();
+		std::copy(field.data.begin(), field.data.end(), output + 1);
 
-					// Append the converted timestamp hex string to the hash string 
-					generatedHash = Volt::ConvertByteToHexData(outputHash) + timestampHex;
-				}
-			}
+		return 1 + field.data.size();
+	}
 
-			return error;
+	// Reads a binary field written by WriteEncodedField(), the field's length must be 0 or the size of the field.
+	// Returns FALSE if the field isn't valid or runs past the end of the data given.
+	template<typename Ty> bool ReadEncodedField(const uint8_t*& data, const uint8_t* end, Volt::BinaryField<Ty>& field)
+	{
+		if (data == end || (data[0] != 0 && data[0] != field.data.size()) || (size_t)(end - data - 1) < data[0])
+			return false;
+
+		field.data.fill(0);
+		field.state = Volt::BinaryFieldState::EMPTY;
+
+		if (data[0] != 0)
+		{
+			std::copy_n(data + 1, field.data.size(), field.data.begin());
+			field.state = Volt::BinaryFieldState::VALID;
 		}
-	};
 
+		data += 1 + data[0];
+		return true;
+	}
+}
+
+namespace Volt
+{
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	Transaction::Transaction() :
-		impl(std::make_unique<Implementation>())
-	{}
+	static_assert(std::is_trivially_copyable_v<Transaction>, "Transactions must be copied without allocating");
 
-	Transaction::Transaction(const Transaction& tx) :
-		impl(std::make_unique<Implementation>(tx.GetType(), tx.GetID(), tx.GetAmount(), tx.GetFee(), tx.GetTimestamp(), 
-			tx.GetSenderKey(), tx.GetRecipientKey(), tx.GetSigniture(), tx.GetTxHash()))
+	Transaction::Transaction() :
+		id(0), timestamp(0), amount(0), fee(0), txHash(), senderPK(), recipientPK(), signiture(),
+		type(TransactionType::TRANSFER), txHashVerified(false)
 	{}
 
-	Transaction::Transaction(TransactionType type, uint64_t id, double amount, double fee, uint64_t timestamp, 
+	Transaction::Transaction(TransactionType type, uint64_t id, Amount amount, Amount fee, uint64_t timestamp, 
 		const std::string& senderPK, const std::string& recipientPK, ErrorCode* error, const std::string& signiture,
 		const std::string& txHash) :
-		impl(std::make_unique<Implementation>(type, id, amount, fee, timestamp, senderPK, recipientPK, signiture, txHash))
+		id(id), timestamp(timestamp), amount(amount), fee(fee), txHash(),
+		senderPK(Volt::ConvertHexToPublicKeyField(senderPK)), recipientPK(Volt::ConvertHexToPublicKeyField(recipientPK)),
+		signiture(Volt::ConvertHexToSignitureField(signiture)), type(type), txHashVerified(false)
 	{
 		if (txHash.empty())
-			error ? *error = this->impl->GenerateTxHash(this->impl->txHash) : this->impl->GenerateTxHash(this->impl->txHash);
+		{
+			error ? *error = this->GenerateTxHash() : this->GenerateTxHash();
+			return;
+		}
+
+		// The hash given must be the hex digest followed by the hex of the transaction's timestamp, it's kept as given and
+		// only checked against the transaction's data when the transaction is verified. This way transactions loaded from
+		// JSON are only hashed once, by the (batched) verification of the block or chain holding them
+		char timestampHex[VOLT_UINT64_HEX_LENGTH];
+		const size_t timestampHexLength = Volt::ConvertUintToHex(this->timestamp, timestampHex, true);
+
+		this->txHash = Volt::ConvertHexToDigestField(txHash.data(), std::min(txHash.size(),
+			(size_t)SHA_256_DIGEST_LENGTH_HEX));
+
+		if (txHash.size() != SHA_256_DIGEST_LENGTH_HEX + timestampHexLength ||
+			!std::equal(timestampHex, timestampHex + timestampHexLength, txHash.begin() + SHA_256_DIGEST_LENGTH_HEX))
+			this->txHash = { {}, BinaryFieldState::MALFORMED };
+	}
+
+	size_t Transaction::WriteEncoding(uint8_t(&output)[VOLT_TRANSACTION_MAX_ENCODED_SIZE], bool includeSigniture) const
+	{
+		if (this->senderPK.state == BinaryFieldState::MALFORMED || this->recipientPK.state == BinaryFieldState::MALFORMED ||
+			(includeSigniture && this->signiture.state == BinaryFieldState::MALFORMED))
+			return 0;
+
+		output[0] = VOLT_TRANSACTION_ENCODING_VERSION;
+		output[encodingHeaderSize] = (uint8_t)this->type;
+		WriteBigEndian<uint64_t>(output + encodingHeaderSize + 1, this->id);
+		WriteBigEndian<uint64_t>(output + encodingHeaderSize + 9, this->timestamp);
+		WriteBigEndian<uint64_t>(output + encodingHeaderSize + 17, (uint64_t)this->amount);
+		WriteBigEndian<uint64_t>(output + encodingHeaderSize + 25, (uint64_t)this->fee);
+
+		size_t length = encodingHeaderSize + encodingFixedFieldsSize;
+		length += WriteEncodedField(output + length, this->senderPK);
+		length += WriteEncodedField(output + length, this->recipientPK);
+		length += WriteEncodedField(output + length, includeSigniture ? this->signiture : SignitureField());
+
+		WriteBigEndian<uint16_t>(output + 1, (uint16_t)(length - encodingHeaderSize));
+		return length;
+	}
+
+	ErrorCode Transaction::GenerateTxDigest(SHA256Digest& digestOutput) const
+	{
+		uint8_t encoding[VOLT_TRANSACTION_MAX_ENCODED_SIZE];
+		const size_t encodingLength = this->WriteEncoding(encoding, false);
+		if (encodingLength == 0)
+			return ErrorID::ECDSA_PUBLIC_KEY_INVALID;
+
+		SHA256Digest dataDigest;
+		Volt::GetSHA256Digest(encoding, encodingLength, dataDigest);
+
+		return Volt::GetSHA256Digest(dataDigest.data(), dataDigest.size(), digestOutput);
 	}
 
-	Transaction::~Transaction() = default;
+	ErrorCode Transaction::GenerateTxHash()
+	{
+		ErrorCode error = this->GenerateTxDigest(this->txHash.data);
+		this->txHash.state = error ? BinaryFieldState::EMPTY : BinaryFieldState::VALID;
+		this->txHashVerified = !error;
 
-	void Transaction::operator=(const Transaction& tx)
+		return error;
+	}
+
+	bool Transaction::IsTxHashValid() const
 	{
-		this->impl = std::make_unique<Implementation>(tx.GetType(), tx.GetID(), tx.GetAmount(), tx.GetFee(), tx.GetTimestamp(), 
-			tx.GetSenderKey(), tx.GetRecipientKey(), tx.GetSigniture(), tx.GetTxHash());
+		if (this->txHash.state != BinaryFieldState::VALID)
+			return false;
+
+		if (this->txHashVerified)
+			return true;
+
+		SHA256Digest digest;
+		if (this->GenerateTxDigest(digest) || digest != this->txHash.data)
+			return false;
+
+		this->txHashVerified = true;
+		return true;
 	}
 
 	const TransactionType& Transaction::GetType() const
 	{
-		return this->impl->type;
+		return this->type;
 	}
 
 	const uint64_t& Transaction::GetID() const
 	{
-		return this->impl->id;
+		return this->id;
 	}
 
-	const double& Transaction::GetAmount() const
+	const Amount& Transaction::GetAmount() const
 	{
-		return this->impl->amount;
+		return this->amount;
 	}
 
-	const double& Transaction::GetFee() const
+	const Amount& Transaction::GetFee() const
 	{
-		return this->impl->fee;
+		return this->fee;
 	}
 
 	const uint64_t& Transaction::GetTimestamp() const
 	{
-		return this->impl->timestamp;
+		return this->timestamp;
 	}
 
-	const std::string& Transaction::GetSenderKey() const
+	std::string Transaction::GetSenderKey() const
 	{
-		return this->impl->senderPK;
+		return Volt::ConvertPublicKeyFieldToHex(this->senderPK);
 	}
 
-	const std::string& Transaction::GetRecipientKey() const
+	std::string Transaction::GetRecipientKey() const
 	{
-		return this->impl->recipientPK;
+		return Volt::ConvertPublicKeyFieldToHex(this->recipientPK);
 	}
 
-	const std::string& Transaction::GetSigniture() const
+	std::string Transaction::GetSigniture() const
 	{
-		return this->impl->signiture;
+		return Volt::ConvertSignitureFieldToHex(this->signiture);
 	}
 
-	const std::string& Transaction::GetTxHash() const
+	std::string Transaction::GetTxHash() const
 	{
-		return this->impl->txHash;
+		if (this->txHash.state != BinaryFieldState::VALID)
+			return std::string();
+
+		// The hash string is the hex digest followed by the hex timestamp
+		char timestampHex[VOLT_UINT64_HEX_LENGTH];
+		const size_t timestampHexLength = Volt::ConvertUintToHex(this->timestamp, timestampHex, true);
+
+		std::string txHash(SHA_256_DIGEST_LENGTH_HEX + timestampHexLength, '0');
+		Volt::ConvertByteToHexData(this->txHash.data.data(), this->txHash.data.size(), &txHash[0]);
+		std::copy_n(timestampHex, timestampHexLength, &txHash[SHA_256_DIGEST_LENGTH_HEX]);
+
+		return txHash;
+	}
+
+	const PublicKeyField& Transaction::GetSenderKeyField() const
+	{
+		return this->senderPK;
+	}
+
+	const PublicKeyField& Transaction::GetRecipientKeyField() const
+	{
+		return this->recipientPK;
+	}
+
+	const SignitureField& Transaction::GetSignitureField() const
+	{
+		return this->signiture;
+	}
+
+	const DigestField& Transaction::GetTxDigestField() const
+	{
+		return this->txHash;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,23 +259,24 @@ namespace Volt
 	ErrorCode SignTransaction(Transaction& tx, const ECKeyPair& privKey)
 	{
 		// Do the transaction signing operation
-		std::vector<uint8_t> txHashBytes = Volt::ConvertHexToByteData(tx.GetTxHash().substr(0, SHA_256_DIGEST_LENGTH_HEX));
-		std::vector<uint8_t> outputSigniture;
+		const SHA256Digest& txDigest = tx.txHash.data;
 
-		ErrorCode error = Volt::GetSignedSHA256Digest(txHashBytes, privKey, outputSigniture);
+		CompactSigniture outputSigniture;
+		ErrorCode error = Volt::GetSignedSHA256Digest(txDigest.data(), txDigest.size(), privKey, outputSigniture);
 		if (!error)
-			tx.impl->signiture = Volt::ConvertByteToHexData(outputSigniture);
+			tx.signiture = { outputSigniture, BinaryFieldState::VALID };
 
 		return error;
 	}
 
 	ErrorCode VerifyTransaction(const Transaction& tx)
 	{
-		// Verify that the transaction hash is valid
-		std::string generatedHash;
-		tx.impl->GenerateTxHash(generatedHash);
+		// The amount and fee must be valid, this also keeps the sums of them done when verifying a block from overflowing
+		if (!Volt::IsAmountValid(tx.amount) || !Volt::IsAmountValid(tx.fee))
+			return ErrorID::TRANSACTION_AMOUNT_INVALID;
 
-		if (tx.GetTxHash() != generatedHash)
+		// Verify that the transaction hash is valid
+		if (!tx.IsTxHashValid())
 			return ErrorID::TRANSACTION_HASH_INVALID;
 
 		// Do transaction signiture verification process
@@ -166,22 +284,134 @@ namespace Volt
 
 		if (tx.GetType() != TransactionType::MINING_REWARD)
 		{
-			std::vector<uint8_t> txHashBytes = Volt::ConvertHexToByteData(tx.GetTxHash().substr(0, SHA_256_DIGEST_LENGTH_HEX));
-			std::vector<uint8_t> signitureBytes = Volt::ConvertHexToByteData(tx.impl->signiture);
+			if (tx.senderPK.state != BinaryFieldState::VALID)
+				return ErrorID::ECDSA_PUBLIC_KEY_INVALID;
 
-			ECKeyPair pubKey(tx.GetSenderKey(), std::string(), &error);
+			// An empty or malformed signiture can't be valid
+			const SignitureField& signiture = tx.signiture;
+			if (signiture.state != BinaryFieldState::VALID)
+				return ErrorID::SIGNITURE_INVALID;
+
+			const SHA256Digest& txDigest = tx.txHash.data;
+
+			// Skip the verification if the signiture has already been proven valid, e.g. when the transaction was added to
+			// the mempool before the block holding it is verified
+			SignitureCache& signitureCache = Volt::GetSignitureCache();
+			const SignitureCacheKey cacheKey = signitureCache.GetKey(txDigest, signiture.data.data(), signiture.data.size(),
+				tx.senderPK.data);
+
+			if (signitureCache.Contains(cacheKey))
+				return error;
+
+			const auto startTime = std::chrono::steady_clock::now();
+
+			ECKeyPair pubKey(tx.senderPK.data, &error);
 			if (!error) // If no error occurred when creating key pair object, then do signiture verification
-				error = Volt::VerifySHA256Digest(txHashBytes, pubKey, signitureBytes);
+				error = Volt::VerifySHA256Digest(txDigest.data(), txDigest.size(), pubKey, signiture.data);
+
+			if (!error)
+			{
+				const auto verificationTime = std::chrono::steady_clock::now() - startTime;
+				signitureCache.Insert(cacheKey,
+					(uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(verificationTime).count());
+			}
 		}
 
 		return error;
 	}
 
+	ErrorCode VerifyTransactionsBatch(const std::vector<const Transaction*>& txs, size_t* failedIndexOutput)
+	{
+		// The transactions are claimed in increasing order, so once a transaction fails every transaction before it has
+		// already been claimed, and the ones after it can be skipped. This keeps the lowest failing index deterministic
+		std::atomic<size_t> nextIndex = 0, failedIndex = SIZE_MAX;
+		std::mutex failureMutex;
+		ErrorCode failedError;
+
+		auto verifyTransactions = [&]()
+		{
+			for (size_t index = nextIndex++; index < txs.size() && index < failedIndex.load(std::memory_order_relaxed);
+				index = nextIndex++)
+			{
+				ErrorCode error = Volt::VerifyTransaction(*txs[index]);
+				if (error)
+				{
+					std::scoped_lock lock(failureMutex);
+					if (index < failedIndex.load(std::memory_order_relaxed))
+					{
+						failedIndex.store(index, std::memory_order_relaxed);
+						failedError = error;
+					}
+				}
+			}
+		};
+
+		if (txs.size() < minParallelBatchSize)
+			verifyTransactions();
+		else
+			Volt::GetSharedThreadPool().Run(verifyTransactions);
+
+		if (failedError && failedIndexOutput)
+			*failedIndexOutput = failedIndex.load();
+
+		return failedError;
+	}
+
 	std::string SerializeTransaction(const Transaction& tx)
 	{
 		return json::serialize(json::value_from(tx));
 	}
 
+	size_t EncodeTransaction(const Transaction& tx, uint8_t* output)
+	{
+		uint8_t encoding[VOLT_TRANSACTION_MAX_ENCODED_SIZE];
+		const size_t encodingLength = tx.WriteEncoding(encoding, true);
+
+		std::copy(encoding, encoding + encodingLength, output);
+		return encodingLength;
+	}
+
+	ErrorCode DecodeTransaction(const uint8_t* data, size_t dataLength, Transaction& txOutput, size_t* bytesReadOutput)
+	{
+		if (dataLength < encodingHeaderSize)
+			return ErrorID::TRANSACTION_ENCODING_INVALID;
+
+		if (data[0] != VOLT_TRANSACTION_ENCODING_VERSION)
+			return ErrorID::TRANSACTION_ENCODING_VERSION_UNSUPPORTED;
+
+		const size_t encodingLength = encodingHeaderSize + ReadBigEndian<uint16_t>(data + 1);
+		if (encodingLength > dataLength || encodingLength < encodingHeaderSize + encodingFixedFieldsSize)
+			return ErrorID::TRANSACTION_ENCODING_INVALID;
+
+		// The transaction is only written to once the whole encoding has been read
+		Transaction tx;
+		const uint8_t* fields = data + encodingHeaderSize;
+
+		tx.type = (TransactionType)fields[0];
+		tx.id = ReadBigEndian<uint64_t>(fields + 1);
+		tx.timestamp = ReadBigEndian<uint64_t>(fields + 9);
+
+		const uint8_t* fieldsEnd = data + encodingLength;
+		fields += encodingFixedFieldsSize;
+
+		if ((tx.type != TransactionType::TRANSFER && tx.type != TransactionType::MINING_REWARD) ||
+			!ReadEncodedAmount(data + encodingHeaderSize + 17, tx.amount) ||
+			!ReadEncodedAmount(data + encodingHeaderSize + 25, tx.fee) ||
+			!ReadEncodedField(fields, fieldsEnd, tx.senderPK) || !ReadEncodedField(fields, fieldsEnd, tx.recipientPK) ||
+			!ReadEncodedField(fields, fieldsEnd, tx.signiture) || fields != fieldsEnd)
+			return ErrorID::TRANSACTION_ENCODING_INVALID;
+
+		ErrorCode error = tx.GenerateTxHash();
+		if (error)
+			return error;
+
+		txOutput = tx;
+		if (bytesReadOutput)
+			*bytesReadOutput = encodingLength;
+
+		return ErrorID::NONE;
+	}
+
 	void tag_invoke(json::value_from_tag, json::value& obj, const Transaction& tx)
 	{
 		obj = {
@@ -204,13 +434,14 @@ namespace Volt
 		return Transaction {
 			(TransactionType)json::value_to<int>(obj.at("type")),
 			json::value_to<uint64_t>(obj.at("id")),
-			json::value_to<double>(obj.at("amount")),
-			json::value_to<double>(obj.at("fee")),
+			json::value_to<Amount>(obj.at("amount")),
+			json::value_to<Amount>(obj.at("fee")),
 			json::value_to<uint64_t>(obj.at("timestamp")),
 			json::value_to<std::string>(obj.at("sender")),
 			json::value_to<std::string>(obj.at("recipient")),
 			nullptr,
-			json::value_to<std::string>(obj.at("signiture"))
+			json::value_to<std::string>(obj.at("signiture")),
+			json::value_to<std::string>(obj.at("hash"))
 		};
 	}
 
@@ -222,16 +453,16 @@ namespace Volt
 
 	bool operator==(const Transaction& lhs, const Transaction& rhs)
 	{
-		return lhs.GetType() == rhs.GetType() &&
+		return lhs.GetTxDigestField() == rhs.GetTxDigestField() &&
+			lhs.GetType() == rhs.GetType() &&
 			lhs.GetID() == rhs.GetID() &&
 			lhs.GetAmount() == rhs.GetAmount() &&
 			lhs.GetFee() == rhs.GetFee() &&
 			lhs.GetTimestamp() == rhs.GetTimestamp() &&
-			lhs.GetSenderKey() == rhs.GetSenderKey() &&
-			lhs.GetRecipientKey() == rhs.GetRecipientKey() &&
-			lhs.GetSigniture() == rhs.GetSigniture() &&
-			lhs.GetTxHash() == rhs.GetTxHash();
+			lhs.GetSenderKeyField() == rhs.GetSenderKeyField() &&
+			lhs.GetRecipientKeyField() == rhs.GetRecipientKeyField() &&
+			lhs.GetSignitureField() == rhs.GetSignitureField();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-}
\ No newline at end of file
+}
@@ -4,13 +4,21 @@
 #include <util/volt_api.h>
 #include <util/error_identifier.h>
 #include <crypto/ecdsa.h>
+#include <core/binary_field.h>
+#include <core/amount.h>
 
 #include <boost/json.hpp>
 #include <string>
-#include <memory>
+#include <vector>
 
 using namespace boost;
 
+// The version of the binary transaction encoding written by EncodeTransaction(), it's the first byte of every encoding.
+#define VOLT_TRANSACTION_ENCODING_VERSION 2
+
+// The largest number of bytes written by EncodeTransaction().
+#define VOLT_TRANSACTION_MAX_ENCODED_SIZE 169
+
 namespace Volt
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,22 +33,55 @@ namespace Volt
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	// A class that contains the data of a transaction.
+	// The keys, signiture and hash of the transaction are held in binary, they're only converted to hex when the transaction
+	// is serialized or displayed. The signiture is held in its compact form (see CompactSigniture).
+	//
+	// All of the fields are fixed size and held inline, so transactions are trivially copyable and copying or moving one
+	// never allocates. The fields are ordered from the largest alignment to the smallest to keep the padding down.
 	class Transaction
 	{
 	private:
-		class Implementation;
-		std::unique_ptr<Implementation> impl;
+		uint64_t id, timestamp;
+		Amount amount, fee;
+
+		DigestField txHash; // The digest held by the hash, the hex timestamp which follows it isn't stored
+		PublicKeyField senderPK, recipientPK;
+		SignitureField signiture;
+		TransactionType type;
+
+		// TRUE if the hash is known to match the transaction's data, either since it was generated from the data or since a
+		// hash given to the transaction (e.g. from JSON) has been checked. The data can't change, so the hash never has to
+		// be checked again. It's only ever set from FALSE to TRUE, by the first successful check of a given hash.
+		mutable bool txHashVerified;
+
+		// Writes the binary encoding of the transaction into the buffer given (see EncodeTransaction()), the signiture is
+		// left out if 'includeSigniture' is FALSE. Returns the number of bytes written, 0 is returned if one of the keys (or
+		// the signiture if it's included) is malformed, since it can't be encoded.
+		size_t WriteEncoding(uint8_t(&output)[VOLT_TRANSACTION_MAX_ENCODED_SIZE], bool includeSigniture) const;
+
+		// Generates the raw digest of the transaction's data, which is the double SHA256 of the transaction's encoding
+		// without its signiture. An error code is returned if one of the keys is malformed, since it can't be encoded.
+		ErrorCode GenerateTxDigest(SHA256Digest& digestOutput) const;
+
+		// Generates the transaction's hash based on its data.
+		ErrorCode GenerateTxHash();
+
+		// Returns TRUE if the transaction's hash matches the hash generated from its data, else FALSE is returned.
+		// The hash is only generated the first time a hash given to the transaction is checked.
+		bool IsTxHashValid() const;
 	public:
 		VOLT_API Transaction();
-		VOLT_API Transaction(const Transaction& tx);
-		VOLT_API Transaction(TransactionType type, uint64_t id, double amount, double fee, uint64_t timestamp, 
+		Transaction(const Transaction& tx) = default;
+		Transaction(Transaction&& tx) noexcept = default;
+		VOLT_API Transaction(TransactionType type, uint64_t id, Amount amount, Amount fee, uint64_t timestamp, 
 			const std::string& senderPK, const std::string& recipientPK, ErrorCode* error = nullptr, 
 			const std::string& signiture = "", const std::string& txHash = "");
 
-		VOLT_API ~Transaction();
+		~Transaction() = default;
 
-		// Operator overload for assignment operations.
-		VOLT_API void operator=(const Transaction& tx);
+		// Operator overloads for assignment operations.
+		Transaction& operator=(const Transaction& tx) = default;
+		Transaction& operator=(Transaction&& tx) noexcept = default;
 
 		// Signs the transaction with the private key given.
 		// An error code is returned in the event of a failure occurring.
@@ -51,6 +92,11 @@ namespace Volt
 		// other possible error codes will be returned depending on the type of failure that occurred.
 		friend extern VOLT_API ErrorCode VerifyTransaction(const Transaction& tx);
 
+		// Writes and reads the binary encoding of the transaction.
+		friend extern VOLT_API size_t EncodeTransaction(const Transaction& tx, uint8_t* output);
+		friend extern VOLT_API ErrorCode DecodeTransaction(const uint8_t* data, size_t dataLength, Transaction& txOutput,
+			size_t* bytesReadOutput);
+
 		// Returns the type of the transaction.
 		VOLT_API const TransactionType& GetType() const;
 
@@ -58,32 +104,71 @@ namespace Volt
 		VOLT_API const uint64_t& GetID() const;
 
 		// Returns the amount tranferred in the transaction.
-		VOLT_API const double& GetAmount() const;
+		VOLT_API const Amount& GetAmount() const;
 
 		// Returns the fee amount paid in the transaction.
-		VOLT_API const double& GetFee() const;
+		VOLT_API const Amount& GetFee() const;
 
 		// Returns the timestamp of the transaction.
 		VOLT_API const uint64_t& GetTimestamp() const;
 
-		// Returns the public key of the sender in the transaction.
-		VOLT_API const std::string& GetSenderKey() const;
+		// Returns the hex of the public key of the sender in the transaction.
+		VOLT_API std::string GetSenderKey() const;
+
+		// Returns the hex of the public key of the recipient in the transaction.
+		VOLT_API std::string GetRecipientKey() const;
+
+		// Returns the hex of the signiture of the transaction.
+		VOLT_API std::string GetSigniture() const;
 
-		// Returns the public key of the recipient in the transaction.
-		VOLT_API const std::string& GetRecipientKey() const;
+		// Returns the transaction's hash, which is the hex of the transaction's digest followed by the hex of its timestamp.
+		VOLT_API std::string GetTxHash() const;
 
-		// Returns the signiture of the transaction.
-		VOLT_API const std::string& GetSigniture() const;
+		// Returns the binary public key of the sender in the transaction.
+		VOLT_API const PublicKeyField& GetSenderKeyField() const;
 
-		// Returns the transaction's hash.
-		VOLT_API const std::string& GetTxHash() const;
+		// Returns the binary public key of the recipient in the transaction.
+		VOLT_API const PublicKeyField& GetRecipientKeyField() const;
+
+		// Returns the compact signiture of the transaction, which is empty if the transaction hasn't been signed.
+		VOLT_API const SignitureField& GetSignitureField() const;
+
+		// Returns the digest held by the transaction's hash.
+		VOLT_API const DigestField& GetTxDigestField() const;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// Checks whether all of the transactions given are valid, the transactions are verified in parallel on the shared
+	// thread pool (see GetSharedThreadPool()). Verification stops early once an invalid transaction is found.
+	// 
+	// The result is the same as verifying the transactions one by one in order: the error code of the invalid transaction
+	// with the lowest index is returned, and its index is returned via 'failedIndexOutput' if given.
+	extern VOLT_API ErrorCode VerifyTransactionsBatch(const std::vector<const Transaction*>& txs,
+		size_t* failedIndexOutput = nullptr);
+
 	// Returns string containing the transaction data that has been serialized into a JSON format.
+	// JSON is only meant for displaying and exporting transactions, EncodeTransaction() is used for hashing and relaying.
 	extern VOLT_API std::string SerializeTransaction(const Transaction& tx);
 
+	// Writes the canonical binary encoding of the transaction into 'output', which must be able to hold at least
+	// 'VOLT_TRANSACTION_MAX_ENCODED_SIZE' bytes. The hash isn't written since it's generated from the rest of the data.
+	// Returns the number of bytes written, 0 is returned if one of the keys is malformed.
+	//
+	// The encoding is big-endian and made up of:
+	// [uint8_t] Version, [uint16_t] Length of the rest of the encoding, [uint8_t] Type, [uint64_t] ID,
+	// [uint64_t] Timestamp, [int64_t] Amount, [int64_t] Fee (both in base units), then the sender key,
+	// recipient key and signiture, each as a [uint8_t] length (0 if empty) followed by its bytes.
+	// The transaction's digest is the double SHA256 of its encoding with an empty signiture.
+	extern VOLT_API size_t EncodeTransaction(const Transaction& tx, uint8_t* output);
+
+	// Reads the transaction from the binary encoding given, the transaction's hash is generated from its data. Only the
+	// canonical encoding with valid amounts (see IsAmountValid()) is accepted, anything else returns
+	// 'ErrorID::TRANSACTION_ENCODING_INVALID'.
+	// The number of bytes read is written into 'bytesReadOutput' if given, so encodings can be read back to back.
+	extern VOLT_API ErrorCode DecodeTransaction(const uint8_t* data, size_t dataLength, Transaction& txOutput,
+		size_t* bytesReadOutput = nullptr);
+
 	// Operator overload for checking if both the transaction on the left and right hand side are equal.
 	extern VOLT_API bool operator==(const Transaction& lhs, const Transaction& rhs);
 
@@ -0,0 +1,98 @@
+#include <crypto/cpu_features.h>
+
+#include <algorithm>
+#include <iterator>
+
+#ifdef VOLT_CPU_X86
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef VOLT_CPU_X86
+	// Returns the value of the extended control register specified (used to check the OS saves the AVX registers).
+	uint64_t GetExtendedControlRegister(uint32_t index)
+	{
+	#ifdef _MSC_VER
+		return _xgetbv(index);
+	#else
+		uint32_t eax = 0, edx = 0;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+		return ((uint64_t)edx << 32) | eax;
+	#endif
+	}
+
+	// Fills the registers given with the result of the CPUID instruction for the leaf and subleaf specified.
+	// Returns FALSE if the leaf isn't supported by the CPU.
+	bool GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t(&registers)[4])
+	{
+	#ifdef _MSC_VER
+		int maxLeafInfo[4], info[4];
+		__cpuid(maxLeafInfo, 0);
+		if ((uint32_t)maxLeafInfo[0] < leaf)
+			return false;
+
+		__cpuidex(info, (int)leaf, (int)subleaf);
+		std::copy(std::begin(info), std::end(info), registers);
+		return true;
+	#else
+		return __get_cpuid_count(leaf, subleaf, &registers[0], &registers[1], &registers[2], &registers[3]) != 0;
+	#endif
+	}
+
+	// Returns TRUE if the bit specified is set in the register of the CPUID leaf given.
+	bool IsCPUIDBitSet(uint32_t leaf, uint32_t registerIndex, uint32_t bit)
+	{
+		uint32_t registers[4] = {};
+		return GetCPUID(leaf, 0, registers) && (registers[registerIndex] & (1u << bit));
+	}
+#endif
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+namespace Volt
+{
+	bool IsCPUFeatureSupported(CPUFeature feature)
+	{
+	#ifdef VOLT_CPU_X86
+		static const bool ssse3Supported = IsCPUIDBitSet(1, 2, 9);
+		static const bool sse41Supported = IsCPUIDBitSet(1, 2, 19);
+		static const bool shaSupported = IsCPUIDBitSet(7, 1, 29);
+
+		static const bool avx2Supported = []()
+		{
+			uint32_t registers[4] = {};
+			if (!GetCPUID(1, 0, registers))
+				return false;
+
+			// AVX must be supported and the OS must save the YMM registers (checked via OSXSAVE and XCR0)
+			const bool osxsave = registers[2] & (1u << 27), avx = registers[2] & (1u << 28);
+			if (!osxsave || !avx || (GetExtendedControlRegister(0) & 0x6) != 0x6)
+				return false;
+
+			return IsCPUIDBitSet(7, 1, 5);
+		}();
+
+		switch (feature)
+		{
+		case CPUFeature::SSSE3:
+			return ssse3Supported;
+		case CPUFeature::SSE41:
+			return sse41Supported;
+		case CPUFeature::AVX2:
+			return avx2Supported;
+		case CPUFeature::SHA:
+			return shaSupported;
+		}
+	#endif
+
+		return false;
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef VIDIBOLT_CPU_FEATURES_H
+#define VIDIBOLT_CPU_FEATURES_H
+
+#include <util/volt_api.h>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define VOLT_CPU_X86
+
+	// Allows a function to be compiled with the instruction set extensions given, regardless of the flags the rest of the
+	// library is built with. MSVC allows intrinsics of any extension to be used without this.
+	#ifdef _MSC_VER
+		#define VOLT_TARGET_FEATURES(features)
+	#else
+		#define VOLT_TARGET_FEATURES(features) __attribute__((target(features)))
+	#endif
+#endif
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// An enumeration that represents the CPU instruction set extensions used by the optimized code paths.
+	enum class CPUFeature : int
+	{
+		SSSE3,
+		SSE41,
+		AVX2, // Also requires the OS to save the YMM registers
+		SHA   // The x86 SHA extensions (SHA-NI)
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns TRUE if the CPU (and OS) supports the feature given, else FALSE is returned.
+	// The CPUID checks are only ever done once.
+	extern VOLT_API bool IsCPUFeatureSupported(CPUFeature feature);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include <crypto/crypto_context.h>
+#include <openssl/evp.h>
+
+namespace
+{
+	// Deleters which free OpenSSL objects owned by smart pointers.
+	struct DigestContextDeleter
+	{
+		void operator()(EVP_MD_CTX* ctx) const { EVP_MD_CTX_free(ctx); }
+	};
+
+	struct DigestImplementationDeleter
+	{
+		void operator()(EVP_MD* digestImpl) const { EVP_MD_free(digestImpl); }
+	};
+
+	using DigestContextPtr = std::unique_ptr<EVP_MD_CTX, DigestContextDeleter>;
+
+	// Resets the digest context when it goes out of scope, so the context is left clean for the next operation on every
+	// path out of a function. The reset can be skipped if the operation completed and the context can be reused as is.
+	class DigestContextResetGuard
+	{
+	private:
+		EVP_MD_CTX* ctx;
+		bool resetNeeded;
+	public:
+		DigestContextResetGuard(EVP_MD_CTX* ctx) :
+			ctx(ctx), resetNeeded(true)
+		{}
+
+		~DigestContextResetGuard()
+		{
+			if (this->resetNeeded)
+				EVP_MD_CTX_reset(this->ctx);
+		}
+
+		// Skips the reset of the context.
+		void Dismiss()
+		{
+			this->resetNeeded = false;
+		}
+	};
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class CryptoContext::Implementation
+	{
+	public:
+		DigestContextPtr digestCtx, signCtx, verifyCtx;
+	public:
+		Implementation() :
+			digestCtx(EVP_MD_CTX_new()), signCtx(EVP_MD_CTX_new()), verifyCtx(EVP_MD_CTX_new())
+		{}
+
+		~Implementation() = default;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	CryptoContext::CryptoContext() :
+		impl(std::make_unique<Implementation>())
+	{}
+
+	CryptoContext::~CryptoContext() = default;
+
+	ErrorCode CryptoContext::Digest(const uint8_t* message, size_t messageLength, uint8_t* digestOutput)
+	{
+		EVP_MD_CTX* digestCtx = this->impl->digestCtx.get();
+		if (!digestCtx)
+			return ErrorID::CONTEXT_GENERATION_FAILURE;
+
+		const EVP_MD* digestImpl = Volt::GetSHA256Implementation();
+		if (!digestImpl)
+			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+
+		// The digest context keeps the SHA256 implementation initialized between digests, it's only reset on failures
+		DigestContextResetGuard resetGuard(digestCtx);
+
+		if (EVP_DigestInit_ex(digestCtx, digestImpl, nullptr) <= 0)
+			return ErrorID::OPERATION_INIT_FAILURE;
+
+		if (EVP_DigestUpdate(digestCtx, message, messageLength) <= 0)
+			return ErrorID::DIGEST_UPDATE_FAILURE;
+
+		if (EVP_DigestFinal_ex(digestCtx, digestOutput, nullptr) <= 0)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		resetGuard.Dismiss();
+		return ErrorID::NONE;
+	}
+
+	ErrorCode CryptoContext::SignDigest(const uint8_t* message, size_t messageLength, EVP_PKEY* key,
+		uint8_t* signitureOutput, size_t& signitureLength)
+	{
+		EVP_MD_CTX* digestSignCtx = this->impl->signCtx.get();
+		if (!digestSignCtx)
+			return ErrorID::CONTEXT_GENERATION_FAILURE;
+
+		const EVP_MD* digestImpl = Volt::GetSHA256Implementation();
+		if (!digestImpl)
+			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+
+		// The signing context is always reset so it doesn't keep hold of the key once the operation is done
+		DigestContextResetGuard resetGuard(digestSignCtx);
+
+		if (EVP_DigestSignInit(digestSignCtx, nullptr, digestImpl, nullptr, key) <= 0)
+			return ErrorID::OPERATION_INIT_FAILURE;
+
+		if (EVP_DigestSignUpdate(digestSignCtx, message, messageLength) <= 0)
+			return ErrorID::DIGEST_UPDATE_FAILURE;
+
+		// The signiture is written straight into the buffer given, which fails if it's too small to hold it
+		if (EVP_DigestSignFinal(digestSignCtx, signitureOutput, &signitureLength) <= 0)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		return ErrorID::NONE;
+	}
+
+	ErrorCode CryptoContext::VerifyDigest(const uint8_t* message, size_t messageLength, EVP_PKEY* key,
+		const uint8_t* signiture, size_t signitureLength)
+	{
+		EVP_MD_CTX* digestSignVerifyCtx = this->impl->verifyCtx.get();
+		if (!digestSignVerifyCtx)
+			return ErrorID::CONTEXT_GENERATION_FAILURE;
+
+		const EVP_MD* digestImpl = Volt::GetSHA256Implementation();
+		if (!digestImpl)
+			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+
+		// The verification context is always reset so it doesn't keep hold of the key once the operation is done
+		DigestContextResetGuard resetGuard(digestSignVerifyCtx);
+
+		if (EVP_DigestVerifyInit(digestSignVerifyCtx, nullptr, digestImpl, nullptr, key) <= 0)
+			return ErrorID::OPERATION_INIT_FAILURE;
+
+		if (EVP_DigestVerifyUpdate(digestSignVerifyCtx, message, messageLength) <= 0)
+			return ErrorID::DIGEST_UPDATE_FAILURE;
+
+		const int signitureValid = EVP_DigestVerifyFinal(digestSignVerifyCtx, signiture, signitureLength);
+		if (signitureValid < 0)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+		else if (signitureValid == 0)
+			return ErrorID::SIGNITURE_INVALID;
+
+		return ErrorID::NONE;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	CryptoContext& GetThreadCryptoContext()
+	{
+		thread_local CryptoContext context;
+		return context;
+	}
+
+	const EVP_MD* GetSHA256Implementation()
+	{
+		// The fetch is done once, the implementation is freed when the program exits
+		static const std::unique_ptr<EVP_MD, DigestImplementationDeleter> digestImpl(
+			EVP_MD_fetch(nullptr, "SHA256", nullptr));
+
+		return digestImpl.get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
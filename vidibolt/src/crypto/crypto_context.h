@@ -0,0 +1,63 @@
+#ifndef VIDIBOLT_CRYPTO_CONTEXT_H
+#define VIDIBOLT_CRYPTO_CONTEXT_H
+
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+#include <memory>
+
+typedef struct evp_md_st EVP_MD;
+typedef struct evp_pkey_st EVP_PKEY;
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which holds the OpenSSL contexts used for SHA256 digest, signing and verification operations.
+	// Creating OpenSSL contexts and fetching algorithm implementations is expensive (and fetching serializes on OpenSSL's
+	// internal locks), so each thread keeps one context which is reused for every operation done on it. The contexts are
+	// reset after every operation, whether it succeeded or not, and are freed when the thread exits.
+	//
+	// The context of the calling thread is accessed via GetThreadCryptoContext(), contexts must not be shared between
+	// threads.
+	class CryptoContext
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		VOLT_API CryptoContext();
+		VOLT_API CryptoContext(const CryptoContext& context) = delete;
+
+		VOLT_API ~CryptoContext();
+
+		VOLT_API void operator=(const CryptoContext& context) = delete;
+
+		// Generates the SHA256 digest of the message given, the 32-byte digest is written into 'digestOutput'.
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode Digest(const uint8_t* message, size_t messageLength, uint8_t* digestOutput);
+
+		// Generates the signiture of the SHA256 digest of the message given using the private key of 'key'.
+		// 'signitureLength' must hold the size of the 'signitureOutput' buffer, it's set to the length of the signiture.
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode SignDigest(const uint8_t* message, size_t messageLength, EVP_PKEY* key,
+			uint8_t* signitureOutput, size_t& signitureLength);
+
+		// Verifies the signiture of the SHA256 digest of the message given using the public key of 'key'.
+		// Returns 'ErrorID::SIGNITURE_INVALID' if the signiture isn't valid, other error codes are returned on failure.
+		VOLT_API ErrorCode VerifyDigest(const uint8_t* message, size_t messageLength, EVP_PKEY* key,
+			const uint8_t* signiture, size_t signitureLength);
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the crypto context of the calling thread, it's created the first time the thread calls this function.
+	extern VOLT_API CryptoContext& GetThreadCryptoContext();
+
+	// Returns the SHA256 implementation, which is fetched once and shared by every thread.
+	// A null pointer is returned if the implementation couldn't be fetched.
+	extern VOLT_API const EVP_MD* GetSHA256Implementation();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
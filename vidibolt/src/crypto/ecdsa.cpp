@@ -1,11 +1,199 @@
 #include <crypto/ecdsa.h>
+#include <crypto/public_key_cache.h>
+#include <util/data_conversion.h>
 #include <openssl/evp.h>
 #include <openssl/ec.h>
 #include <openssl/ecdsa.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/param_build.h>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <vector>
+
+namespace
+{
+#ifdef VOLT_NATIVE_SECP256K1
+	std::atomic<Volt::ECDSABackend> selectedBackend = Volt::ECDSABackend::NATIVE;
+#else
+	std::atomic<Volt::ECDSABackend> selectedBackend = Volt::ECDSABackend::OPENSSL;
+#endif
+
+	using SignitureObjectPtr = std::unique_ptr<ECDSA_SIG, decltype(&ECDSA_SIG_free)>;
+	using BignumPtr = std::unique_ptr<BIGNUM, decltype(&BN_free)>;
+
+	// Returns (n - 1) / 2, the largest s of a low-S signiture. A null pointer is returned if it couldn't be computed.
+	const BIGNUM* GetHalfCurveOrder()
+	{
+		// The half order is computed once and freed when the program exits
+		static const BignumPtr halfOrder = []()
+		{
+			const EC_GROUP* group = Volt::GetSecp256k1Group();
+			BignumPtr halfOrder(group ? BN_dup(EC_GROUP_get0_order(group)) : nullptr, &BN_free);
+
+			if (halfOrder && BN_rshift1(halfOrder.get(), halfOrder.get()) <= 0)
+				halfOrder.reset();
+
+			return halfOrder;
+		}();
+
+		return halfOrder.get();
+	}
+
+	// Returns TRUE if the number given is in the range [1, n).
+	bool IsInCurveOrderRange(const BIGNUM* num, const BIGNUM* order)
+	{
+		return !BN_is_zero(num) && !BN_is_negative(num) && BN_cmp(num, order) < 0;
+	}
+
+	// Creates a secp256k1 key object from the encoded public key given, along with the private key if one is given.
+	// A null pointer is returned if the public key isn't a valid point or the private key isn't valid.
+	EVP_PKEY* CreateKey(const uint8_t* publicKey, size_t publicKeyLength, const BIGNUM* privateKey)
+	{
+		EVP_PKEY* key = nullptr;
+		OSSL_PARAM_BLD* paramBuilder = OSSL_PARAM_BLD_new();
+		OSSL_PARAM* params = nullptr;
+		EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr);
+
+		if (paramBuilder && keyCtx &&
+			OSSL_PARAM_BLD_push_utf8_string(paramBuilder, OSSL_PKEY_PARAM_GROUP_NAME, "secp256k1", 0) > 0 &&
+			OSSL_PARAM_BLD_push_octet_string(paramBuilder, OSSL_PKEY_PARAM_PUB_KEY, publicKey, publicKeyLength) > 0 &&
+			(!privateKey || OSSL_PARAM_BLD_push_BN(paramBuilder, OSSL_PKEY_PARAM_PRIV_KEY, privateKey) > 0))
+		{
+			params = OSSL_PARAM_BLD_to_param(paramBuilder);
+			if (!params || EVP_PKEY_fromdata_init(keyCtx) <= 0 ||
+				EVP_PKEY_fromdata(keyCtx, &key, privateKey ? EVP_PKEY_KEYPAIR : EVP_PKEY_PUBLIC_KEY, params) <= 0)
+				key = nullptr;
+		}
+
+		OSSL_PARAM_free(params);
+		OSSL_PARAM_BLD_free(paramBuilder);
+		EVP_PKEY_CTX_free(keyCtx);
+
+		return key;
+	}
+
+	// Writes the uncompressed encoding of the public key held by the key object given (0x04 followed by the 32-byte
+	// big-endian x and y coordinates). Every key keeps OpenSSL's default uncompressed conversion form, so the public key
+	// is exported as is. Returns FALSE if the key object doesn't hold a public key.
+	bool GetUncompressedPublicKey(const EVP_PKEY* key, uint8_t(&publicKeyOutput)[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH])
+	{
+		size_t publicKeyLength = 0;
+		return key && EVP_PKEY_get_octet_string_param(key, OSSL_PKEY_PARAM_PUB_KEY, publicKeyOutput,
+			sizeof(publicKeyOutput), &publicKeyLength) > 0 && publicKeyLength == sizeof(publicKeyOutput) &&
+			publicKeyOutput[0] == 0x04;
+	}
+
+	// Returns the private key held by the key object given, which the caller must free via BN_clear_free().
+	// A null pointer is returned if the key object doesn't hold a private key.
+	BIGNUM* GetPrivateKey(const EVP_PKEY* key)
+	{
+		BIGNUM* privateKey = nullptr;
+		if (!key || EVP_PKEY_get_bn_param(key, OSSL_PKEY_PARAM_PRIV_KEY, &privateKey) <= 0)
+			return nullptr;
+
+		return privateKey;
+	}
+}
 
 namespace Volt
 {
+	ECDSABackend GetECDSABackend()
+	{
+		return selectedBackend.load(std::memory_order_relaxed);
+	}
+
+	void SetECDSABackend(ECDSABackend backend)
+	{
+		selectedBackend.store(backend, std::memory_order_relaxed);
+	}
+
+	ErrorCode ConvertDERToCompactSigniture(const uint8_t* signiture, size_t signitureLength,
+		CompactSigniture& signitureOutput)
+	{
+		const EC_GROUP* group = Volt::GetSecp256k1Group();
+		const BIGNUM* halfOrder = GetHalfCurveOrder();
+		if (!group || !halfOrder)
+			return ErrorID::EC_KEY_GROUP_ASSIGNMENT_FAILURE;
+
+		if (signitureLength > ECDSA_MAX_SIGNITURE_LENGTH)
+			return ErrorID::SIGNITURE_INVALID;
+
+		// OpenSSL accepts some encodings which aren't strict DER, so the signiture must also be exactly what it's encoded
+		// back into
+		const uint8_t* signitureEnd = signiture;
+		SignitureObjectPtr signitureObject(d2i_ECDSA_SIG(nullptr, &signitureEnd, (long)signitureLength), &ECDSA_SIG_free);
+		if (!signitureObject || signitureEnd != signiture + signitureLength ||
+			i2d_ECDSA_SIG(signitureObject.get(), nullptr) != (int)signitureLength)
+			return ErrorID::SIGNITURE_INVALID;
+
+		uint8_t encoded[ECDSA_MAX_SIGNITURE_LENGTH];
+		uint8_t* encodedEnd = encoded;
+		i2d_ECDSA_SIG(signitureObject.get(), &encodedEnd);
+
+		if (!std::equal(encoded, encodedEnd, signiture))
+			return ErrorID::SIGNITURE_INVALID;
+
+		const BIGNUM* r;
+		const BIGNUM* s;
+		ECDSA_SIG_get0(signitureObject.get(), &r, &s);
+
+		const BIGNUM* order = EC_GROUP_get0_order(group);
+		if (!IsInCurveOrderRange(r, order) || !IsInCurveOrderRange(s, order))
+			return ErrorID::SIGNITURE_INVALID;
+
+		// (r, n - s) is just as valid as (r, s), so a high s is replaced with the low one
+		BignumPtr lowS(nullptr, &BN_free);
+		if (BN_cmp(s, halfOrder) > 0)
+		{
+			lowS.reset(BN_new());
+			if (!lowS || BN_sub(lowS.get(), order, s) <= 0)
+				return ErrorID::DIGEST_OPERATION_FAILURE;
+
+			s = lowS.get();
+		}
+
+		if (BN_bn2binpad(r, signitureOutput.data(), 32) != 32 || BN_bn2binpad(s, signitureOutput.data() + 32, 32) != 32)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		return ErrorID::NONE;
+	}
+
+	ErrorCode ConvertCompactSignitureToDER(const CompactSigniture& signiture, SignitureBuffer& signitureOutput)
+	{
+		const EC_GROUP* group = Volt::GetSecp256k1Group();
+		const BIGNUM* halfOrder = GetHalfCurveOrder();
+		if (!group || !halfOrder)
+			return ErrorID::EC_KEY_GROUP_ASSIGNMENT_FAILURE;
+
+		BignumPtr r(BN_bin2bn(signiture.data(), 32, nullptr), &BN_free);
+		BignumPtr s(BN_bin2bn(signiture.data() + 32, 32, nullptr), &BN_free);
+		SignitureObjectPtr signitureObject(ECDSA_SIG_new(), &ECDSA_SIG_free);
+		if (!r || !s || !signitureObject)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		const BIGNUM* order = EC_GROUP_get0_order(group);
+		if (!IsInCurveOrderRange(r.get(), order) || !IsInCurveOrderRange(s.get(), order) || BN_cmp(s.get(), halfOrder) > 0)
+			return ErrorID::SIGNITURE_INVALID;
+
+		// The signiture object takes ownership of r and s
+		if (ECDSA_SIG_set0(signitureObject.get(), r.get(), s.get()) <= 0)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		r.release();
+		s.release();
+
+		uint8_t* signitureEnd = signitureOutput.data.data();
+		const int signitureLength = i2d_ECDSA_SIG(signitureObject.get(), &signitureEnd);
+		if (signitureLength <= 0)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		signitureOutput.length = (size_t)signitureLength;
+		return ErrorID::NONE;
+	}
+
 	ECKeyPair::ECKeyPair(ErrorCode* error) :
 		keyPair(nullptr), keyGenCtx(nullptr)
 	{
@@ -38,11 +226,6 @@ namespace Volt
 						if (error)
 							*error = ErrorID::ECDSA_KEY_GENERATION_ERROR;
 					}
-					else
-					{
-						EC_KEY* ecKeyPair = EVP_PKEY_get1_EC_KEY(this->keyPair);
-						EC_KEY_set_conv_form(ecKeyPair, POINT_CONVERSION_COMPRESSED);
-					}
 				}
 			}
 		}
@@ -70,46 +253,55 @@ namespace Volt
 			if (!privateKey.empty())
 				std::transform(privKeyStr.begin(), privKeyStr.end(), privKeyStr.begin(), ::toupper);
 
-			// Create and setup the keypair with the given public key (and private key if one was given)
-			this->keyPair = EVP_PKEY_new();
-
-			EC_GROUP* group = EC_GROUP_new_by_curve_name_ex(nullptr, nullptr, NID_secp256k1);
-			EC_GROUP_set_point_conversion_form(group, POINT_CONVERSION_COMPRESSED);
-			EC_POINT* pubKey = EC_POINT_hex2point(group, pubKeyStr.c_str(), nullptr, nullptr);
-
-			EC_KEY* ecKeyPair = EC_KEY_new();
-			if (EC_KEY_set_group(ecKeyPair, group) <= 0)
+			// Public keys on their own are shared through the public key cache, since they're mostly created for
+			// verifying the transactions of senders who are seen again and again
+			if (privateKey.empty() && pubKeyStr.size() == EC_COMPRESSED_PUBLIC_KEY_LENGTH * 2 &&
+				std::all_of(pubKeyStr.begin(), pubKeyStr.end(), ::isxdigit))
 			{
-				if (error) 
-					*error = ErrorID::EC_KEY_GROUP_ASSIGNMENT_FAILURE;
-			}
-			else
-			{
-				if (EC_KEY_set_public_key(ecKeyPair, pubKey) <= 0)
+				CompressedPublicKey compressedPubKey;
+				Volt::ConvertHexToByteData(pubKeyStr.data(), pubKeyStr.size(), compressedPubKey.data());
+
+				this->keyPair = Volt::GetPublicKeyCache().GetPublicKey(compressedPubKey);
+				if (!this->keyPair)
 				{
+					this->keyPair = EVP_PKEY_new();
 					if (error)
 						*error = ErrorID::EC_KEY_ASSIGNMENT_FAILURE;
 				}
-				else
-				{
-					if (!privateKey.empty())
-					{
-						BIGNUM* privKey = nullptr;
-
-						BN_hex2bn(&privKey, privKeyStr.c_str());
-						if (EC_KEY_set_private_key(ecKeyPair, privKey) <= 0)
-						{
-							if (error)
-								*error = ErrorID::EC_KEY_ASSIGNMENT_FAILURE;
-						}
-					}
 
-					EVP_PKEY_set1_EC_KEY(this->keyPair, ecKeyPair);
-				}
+				return;
+			}
+
+			// Create and setup the keypair with the given public key (and private key if one was given)
+			std::vector<uint8_t> pubKeyBytes(pubKeyStr.size() / 2);
+			BIGNUM* privKey = nullptr;
+
+			if (pubKeyStr.size() % 2 == 0 && Volt::ConvertHexToByteData(pubKeyStr.data(), pubKeyStr.size(),
+				pubKeyBytes.data()) && (privateKey.empty() || BN_hex2bn(&privKey, privKeyStr.c_str()) > 0))
+				this->keyPair = CreateKey(pubKeyBytes.data(), pubKeyBytes.size(), privKey);
+
+			BN_clear_free(privKey);
+
+			if (!this->keyPair)
+			{
+				this->keyPair = EVP_PKEY_new();
+				if (error)
+					*error = ErrorID::EC_KEY_ASSIGNMENT_FAILURE;
 			}
 		}
 	}
 
+	ECKeyPair::ECKeyPair(const CompressedPublicKey& publicKey, ErrorCode* error) :
+		keyPair(Volt::GetPublicKeyCache().GetPublicKey(publicKey)), keyGenCtx(nullptr)
+	{
+		if (!this->keyPair)
+		{
+			this->keyPair = EVP_PKEY_new();
+			if (error)
+				*error = ErrorID::EC_KEY_ASSIGNMENT_FAILURE;
+		}
+	}
+
 	ECKeyPair::~ECKeyPair()
 	{
 		EVP_PKEY_CTX_free(this->keyGenCtx);
@@ -118,55 +310,86 @@ namespace Volt
 
 	std::string ECKeyPair::GetPublicKeyHex() const
 	{
-		// Get the public key (aka EC_POINT*)
-		const EC_KEY* ecKeyPair = EVP_PKEY_get0_EC_KEY(this->keyPair);
-		const EC_POINT* publicKey = EC_KEY_get0_public_key(ecKeyPair);
+		// Public keys are always written in their compressed form
+		CompressedPublicKey publicKey;
+		if (!this->GetCompressedPublicKey(publicKey))
+			return std::string();
 
-		// Get data required for conversion to HEX
-		const EC_GROUP* group = EC_KEY_get0_group(ecKeyPair);
-		const point_conversion_form_t pointConversion = EC_GROUP_get_point_conversion_form(group);
-
-		if (publicKey)
-		{
-			// Convert the EC_POINT* public key to a hexadecimal format
-			std::string publicKeyHex = EC_POINT_point2hex(group, publicKey, pointConversion, nullptr);
-			return  "VPK_" + publicKeyHex;
-		}
+		std::string publicKeyStr(4 + publicKey.size() * 2, '\0');
+		std::copy_n("VPK_", 4, publicKeyStr.begin());
+		Volt::ConvertByteToHexData(publicKey.data(), publicKey.size(), publicKeyStr.data() + 4);
 
-		return std::string();
+		return publicKeyStr;
 	}
 
 	std::string ECKeyPair::GetPrivateKeyHex() const
 	{
-		// Get the public key (aka EC_POINT*)
-		const EC_KEY* ecKeyPair = EVP_PKEY_get0_EC_KEY(this->keyPair);
-		const BIGNUM* privateKey = EC_KEY_get0_private_key(ecKeyPair);
+		BIGNUM* privateKey = GetPrivateKey(this->keyPair);
+		if (!privateKey)
+			return std::string();
 
-		if (privateKey)
-		{
-			// Convert the BIGNUM* private key to a hexadecimal format
-			std::string privateKeyHex = BN_bn2hex(privateKey);
-			return privateKeyHex;
-		}
+		// Convert the BIGNUM* private key to a hexadecimal format
+		char* privateKeyHex = BN_bn2hex(privateKey);
+		const std::string privateKeyStr = privateKeyHex ? privateKeyHex : "";
 
-		return std::string();
+		OPENSSL_clear_free(privateKeyHex, privateKeyStr.size());
+		BN_clear_free(privateKey);
+
+		return privateKeyStr;
 	}
 
-	bool ECKeyPair::HasPublicKey() const
+	bool ECKeyPair::GetCompressedPublicKey(CompressedPublicKey& publicKeyOutput) const
 	{
-		const EC_KEY* ecKeyPair = EVP_PKEY_get0_EC_KEY(this->keyPair);
-		const EC_POINT* publicKey = EC_KEY_get0_public_key(ecKeyPair);
+		uint8_t publicKey[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH];
+		if (!GetUncompressedPublicKey(this->keyPair, publicKey))
+			return false;
 
-		return publicKey ? true : false;
+		// The prefix of a compressed point holds the parity of y
+		publicKeyOutput[0] = 0x02 | (publicKey[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH - 1] & 1);
+		std::copy_n(publicKey + 1, publicKeyOutput.size() - 1, publicKeyOutput.begin() + 1);
+
+		return true;
+	}
+
+	bool ECKeyPair::GetPublicKeyBytes(uint8_t(&publicKeyOutput)[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH]) const
+	{
+		return GetUncompressedPublicKey(this->keyPair, publicKeyOutput);
+	}
+
+	bool ECKeyPair::GetPrivateKeyBytes(uint8_t(&privateKeyOutput)[SECP256K1_PRIVATE_KEY_LENGTH]) const
+	{
+		BIGNUM* privateKey = GetPrivateKey(this->keyPair);
+
+		const bool written = privateKey &&
+			BN_bn2binpad(privateKey, privateKeyOutput, sizeof(privateKeyOutput)) == sizeof(privateKeyOutput);
+
+		BN_clear_free(privateKey);
+		return written;
+	}
+
+	bool ECKeyPair::HasPublicKey() const
+	{
+		size_t publicKeyLength = 0;
+		return this->keyPair &&
+			EVP_PKEY_get_octet_string_param(this->keyPair, OSSL_PKEY_PARAM_PUB_KEY, nullptr, 0, &publicKeyLength) > 0;
 	}
 
 	bool ECKeyPair::HasPrivateKey() const
 	{
-		const EC_KEY* ecKeyPair = EVP_PKEY_get0_EC_KEY(this->keyPair);
-		const BIGNUM* privateKey = EC_KEY_get0_private_key(ecKeyPair);
+		BIGNUM* privateKey = GetPrivateKey(this->keyPair);
+		BN_clear_free(privateKey);
 
 		return privateKey ? true : false;
 	}
 
-	bool ECKeyPair::IsValid() const { return EC_KEY_check_key(EVP_PKEY_get0_EC_KEY(this->keyPair)); }
+	bool ECKeyPair::IsValid() const
+	{
+		// The public key must be on the curve, and it must match the private key if there is one
+		EVP_PKEY_CTX* checkCtx = EVP_PKEY_CTX_new_from_pkey(nullptr, this->keyPair, nullptr);
+		const bool isValid = checkCtx && (this->HasPrivateKey() ? EVP_PKEY_check(checkCtx) :
+			EVP_PKEY_public_check(checkCtx)) > 0;
+
+		EVP_PKEY_CTX_free(checkCtx);
+		return isValid;
+	}
 }
\ No newline at end of file
@@ -3,8 +3,17 @@
 
 #include <util/volt_api.h>
 #include <util/error_identifier.h>
+#include <crypto/secp256k1.h>
+#include <crypto/public_key_cache.h>
 #include <vector>
 #include <string>
+#include <array>
+
+// The maximum length of a DER encoded secp256k1 ECDSA signiture.
+#define ECDSA_MAX_SIGNITURE_LENGTH 72
+
+// The length of a compact secp256k1 ECDSA signiture.
+#define ECDSA_COMPACT_SIGNITURE_LENGTH SECP256K1_COMPACT_SIGNITURE_LENGTH
 
 typedef struct evp_pkey_st EVP_PKEY;
 typedef struct evp_pkey_ctx_st EVP_PKEY_CTX;
@@ -13,6 +22,45 @@ namespace Volt
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// A struct which holds a DER encoded signiture in a fixed size buffer, so signing and verifying doesn't need to allocate
+	// memory for the signiture.
+	struct SignitureBuffer
+	{
+		std::array<uint8_t, ECDSA_MAX_SIGNITURE_LENGTH> data;
+		size_t length;
+	};
+
+	// A compact signiture, which is r followed by s (both 32-byte big-endian) with s always in the lower half of the range
+	// (low-S). Unlike DER, every signiture has exactly one compact encoding, so compact signitures are what transactions
+	// store and send, and they're only converted to DER when OpenSSL needs them.
+	using CompactSigniture = std::array<uint8_t, ECDSA_COMPACT_SIGNITURE_LENGTH>;
+
+	// An enumeration that represents the implementations which ECDSA signitures can be generated and verified with.
+	enum class ECDSABackend : int
+	{
+		OPENSSL, // The generic OpenSSL EC implementation
+		NATIVE   // The in-tree secp256k1 implementation
+	};
+
+	// Returns the ECDSA backend currently used for signing and verification. This is the OpenSSL backend unless the
+	// library was built with 'VOLT_NATIVE_SECP256K1' defined, or the backend was overridden.
+	extern VOLT_API ECDSABackend GetECDSABackend();
+
+	// Overrides the ECDSA backend used for signing and verification by every thread (e.g. for benchmarking or testing).
+	extern VOLT_API void SetECDSABackend(ECDSABackend backend);
+
+	// Converts the DER encoded signiture given into its compact form, a high s is replaced with n - s.
+	// Returns 'ErrorID::SIGNITURE_INVALID' if the signiture isn't strictly DER encoded or r or s isn't in the range [1, n).
+	extern VOLT_API ErrorCode ConvertDERToCompactSigniture(const uint8_t* signiture, size_t signitureLength,
+		CompactSigniture& signitureOutput);
+
+	// Converts the compact signiture given into its DER encoding, for use with OpenSSL.
+	// Returns 'ErrorID::SIGNITURE_INVALID' if r or s isn't in the range [1, n) or s isn't low.
+	extern VOLT_API ErrorCode ConvertCompactSignitureToDER(const CompactSigniture& signiture,
+		SignitureBuffer& signitureOutput);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 	// This class handles generation and storage of EC key pairs.
 	class VOLT_API ECKeyPair
 	{
@@ -28,8 +76,24 @@ namespace Volt
 			std::vector<uint8_t>& signitureDigestOutput);
 		friend VOLT_API ErrorCode VerifySHA256Digest(const std::vector<uint8_t>& originalMessage, const ECKeyPair& key,
 			const std::vector<uint8_t>& signiture);
+		friend VOLT_API ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+			SignitureBuffer& signitureOutput);
+		friend VOLT_API ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength,
+			const ECKeyPair& key, const uint8_t* signiture, size_t signitureLength);
+		friend VOLT_API ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+			CompactSigniture& signitureOutput);
+		friend VOLT_API ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength,
+			const ECKeyPair& key, const CompactSigniture& signiture);
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+		// Writes the uncompressed public key into 'publicKeyOutput', for use with the native secp256k1 backend.
+		// Returns FALSE if the key pair doesn't hold a public key.
+		bool GetPublicKeyBytes(uint8_t(&publicKeyOutput)[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH]) const;
+
+		// Writes the 32-byte big-endian private key into 'privateKeyOutput', for use with the native secp256k1 backend.
+		// Returns FALSE if the key pair doesn't hold a private key.
+		bool GetPrivateKeyBytes(uint8_t(&privateKeyOutput)[SECP256K1_PRIVATE_KEY_LENGTH]) const;
 	public:
 		// Call this constructor if you want a public and private key to be generated automatically.
 		// Also, errors can be caught through passing a pointer to a ErrorCode object via the only parameter 'error'.
@@ -39,6 +103,10 @@ namespace Volt
 	    // Note that a public key must be given, though you don't need to pass a private key.
 		// Also, errors can be caught through passing a pointer to a ErrorCode object via the last parameter 'error'.
 		ECKeyPair(const std::string& publicKey, const std::string& privateKey = "", ErrorCode* error = nullptr);
+
+		// Call this constructor if you only want to set the public key, given as the bytes of the compressed point.
+		// The decoded key is shared through the public key cache (see GetPublicKeyCache()).
+		ECKeyPair(const CompressedPublicKey& publicKey, ErrorCode* error = nullptr);
 		
 		ECKeyPair(const ECKeyPair&) = delete;
 		~ECKeyPair();
@@ -46,6 +114,10 @@ namespace Volt
 		// Returns a string containing the public key in hexadecimal format.
 		std::string GetPublicKeyHex() const;
 
+		// Writes the bytes of the compressed public key into 'publicKeyOutput'.
+		// Returns FALSE if the key pair doesn't hold a public key.
+		bool GetCompressedPublicKey(CompressedPublicKey& publicKeyOutput) const;
+
 		// Returns a string containing the private key in hexadecimal format.
 		std::string GetPrivateKeyHex() const;
 
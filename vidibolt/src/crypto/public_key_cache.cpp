@@ -0,0 +1,237 @@
+#include <crypto/public_key_cache.h>
+#include <util/random_generation.h>
+#include <openssl/evp.h>
+#include <openssl/ec.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	// The number of shards the cache is split into, each with its own lock.
+	constexpr size_t cacheShardCount = 16;
+	static_assert(256 % cacheShardCount == 0, "Shards are picked using a single byte of the public key");
+
+	// The number of 32-bit words of the x-coordinate read by the public key hasher, the rest of the x-coordinate is left
+	// for picking the shard.
+	constexpr size_t hashedWordCount = 6;
+
+	// Hashes a compressed public key using the first words of its x-coordinate. Public keys come from peers, so the words
+	// are hashed with a random salt using NH (the hash used by UMAC) to stop anyone from picking keys which all land in the
+	// same bucket. NH's output is then mixed so its low bits, which MSVC picks buckets with, depend on every input bit.
+	struct CompressedPublicKeyHasher
+	{
+		uint32_t salt[hashedWordCount] = {};
+
+		size_t operator()(const Volt::CompressedPublicKey& publicKey) const
+		{
+			uint32_t words[hashedWordCount];
+			std::memcpy(words, publicKey.data() + 1, sizeof(words));
+
+			uint64_t hash = 0;
+			for (size_t i = 0; i < hashedWordCount; i += 2)
+				hash += (uint64_t)(words[i] + this->salt[i]) * (words[i + 1] + this->salt[i + 1]);
+
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+
+			return (size_t)hash;
+		}
+	};
+
+	// Decodes the compressed public key given into a key object, a null pointer is returned if it isn't a valid point.
+	EVP_PKEY* DecodePublicKey(const Volt::CompressedPublicKey& publicKey)
+	{
+		char groupName[] = "secp256k1";
+		OSSL_PARAM params[] = {
+			OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, groupName, 0),
+			OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_PUB_KEY, (void*)publicKey.data(), publicKey.size()),
+			OSSL_PARAM_construct_end()
+		};
+
+		// The public key is checked to be a point on the curve while it's being decoded
+		EVP_PKEY* key = nullptr;
+		EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr);
+
+		if (!keyCtx || EVP_PKEY_fromdata_init(keyCtx) <= 0 ||
+			EVP_PKEY_fromdata(keyCtx, &key, EVP_PKEY_PUBLIC_KEY, params) <= 0)
+			key = nullptr;
+
+		EVP_PKEY_CTX_free(keyCtx);
+		return key;
+	}
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class PublicKeyCache::Implementation
+	{
+	public:
+		// A shard of the cache, the keys are kept in order of use with the most recently used key at the front.
+		struct Shard
+		{
+			using Entry = std::pair<CompressedPublicKey, EVP_PKEY*>;
+
+			std::mutex mutex;
+			std::list<Entry> entries;
+			std::unordered_map<CompressedPublicKey, std::list<Entry>::iterator, CompressedPublicKeyHasher> index;
+		};
+
+		std::vector<Shard> shards;
+		size_t shardCapacity;
+		std::atomic<uint64_t> hits, misses;
+	public:
+		Implementation(size_t capacity) :
+			shards(cacheShardCount), shardCapacity(std::max<size_t>(capacity / cacheShardCount, 1)), hits(0), misses(0)
+		{
+			// Fall back onto the weaker random generator if OpenSSL can't provide random bytes
+			CompressedPublicKeyHasher hasher;
+			if (RAND_bytes((uint8_t*)hasher.salt, sizeof(hasher.salt)) <= 0)
+			{
+				for (uint32_t& word : hasher.salt)
+					word = Volt::GenerateRandomUint32(0, UINT32_MAX);
+			}
+
+			for (Shard& shard : this->shards)
+				shard.index = decltype(shard.index)(0, hasher);
+		}
+
+		~Implementation()
+		{
+			this->Clear();
+		}
+
+		// Returns the shard the public key given belongs to. The shard is picked using the last byte of the x-coordinate,
+		// which the hasher doesn't read, so the keys of a shard don't all share the same low bits of their hashes.
+		Shard& GetShard(const CompressedPublicKey& publicKey)
+		{
+			return this->shards[publicKey.back() % this->shards.size()];
+		}
+
+		void Clear()
+		{
+			for (Shard& shard : this->shards)
+			{
+				std::scoped_lock lock(shard.mutex);
+				for (Shard::Entry& entry : shard.entries)
+					EVP_PKEY_free(entry.second);
+
+				shard.entries.clear();
+				shard.index.clear();
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PublicKeyCache::PublicKeyCache(size_t capacity) :
+		impl(std::make_unique<Implementation>(capacity))
+	{}
+
+	PublicKeyCache::~PublicKeyCache() = default;
+
+	EVP_PKEY* PublicKeyCache::GetPublicKey(const CompressedPublicKey& publicKey)
+	{
+		Implementation::Shard& shard = this->impl->GetShard(publicKey);
+		{
+			std::scoped_lock lock(shard.mutex);
+
+			auto entryIt = shard.index.find(publicKey);
+			if (entryIt != shard.index.end())
+			{
+				// Move the key to the front of the list since it's now the most recently used key
+				shard.entries.splice(shard.entries.begin(), shard.entries, entryIt->second);
+				this->impl->hits.fetch_add(1, std::memory_order_relaxed);
+
+				EVP_PKEY* key = entryIt->second->second;
+				EVP_PKEY_up_ref(key);
+				return key;
+			}
+		}
+
+		// Decode the key outside of the lock, since it's by far the most expensive part
+		this->impl->misses.fetch_add(1, std::memory_order_relaxed);
+
+		EVP_PKEY* key = DecodePublicKey(publicKey);
+		if (!key)
+			return nullptr;
+
+		std::scoped_lock lock(shard.mutex);
+
+		// Another thread may have cached the same key in the meantime, in which case the cached key is used
+		auto entryIt = shard.index.find(publicKey);
+		if (entryIt != shard.index.end())
+		{
+			EVP_PKEY_free(key);
+			key = entryIt->second->second;
+		}
+		else
+		{
+			shard.entries.emplace_front(publicKey, key);
+			shard.index.emplace(publicKey, shard.entries.begin());
+
+			// Evict the least recently used key once the shard is full, the key stays alive while it's still being used
+			if (shard.entries.size() > this->impl->shardCapacity)
+			{
+				EVP_PKEY_free(shard.entries.back().second);
+				shard.index.erase(shard.entries.back().first);
+				shard.entries.pop_back();
+			}
+		}
+
+		EVP_PKEY_up_ref(key);
+		return key;
+	}
+
+	PublicKeyCacheStats PublicKeyCache::GetStats() const
+	{
+		PublicKeyCacheStats stats = { this->impl->hits.load(), this->impl->misses.load(), 0 };
+		for (Implementation::Shard& shard : this->impl->shards)
+		{
+			std::scoped_lock lock(shard.mutex);
+			stats.size += shard.entries.size();
+		}
+
+		return stats;
+	}
+
+	void PublicKeyCache::Clear()
+	{
+		this->impl->Clear();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PublicKeyCache& GetPublicKeyCache()
+	{
+		static PublicKeyCache cache(VOLT_PUBLIC_KEY_CACHE_CAPACITY);
+		return cache;
+	}
+
+	const EC_GROUP* GetSecp256k1Group()
+	{
+		// The group is created once and freed when the program exits
+		static const std::unique_ptr<EC_GROUP, decltype(&EC_GROUP_free)> group = []()
+		{
+			EC_GROUP* group = EC_GROUP_new_by_curve_name_ex(nullptr, nullptr, NID_secp256k1);
+			if (group)
+				EC_GROUP_set_point_conversion_form(group, POINT_CONVERSION_COMPRESSED);
+
+			return std::unique_ptr<EC_GROUP, decltype(&EC_GROUP_free)>(group, &EC_GROUP_free);
+		}();
+
+		return group.get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,74 @@
+#ifndef VIDIBOLT_PUBLIC_KEY_CACHE_H
+#define VIDIBOLT_PUBLIC_KEY_CACHE_H
+
+#include <util/volt_api.h>
+
+#include <memory>
+#include <array>
+
+// The length of a compressed secp256k1 public key.
+#define EC_COMPRESSED_PUBLIC_KEY_LENGTH 33
+
+// The number of decoded public keys kept by the shared public key cache.
+#define VOLT_PUBLIC_KEY_CACHE_CAPACITY 8192
+
+typedef struct evp_pkey_st EVP_PKEY;
+typedef struct ec_group_st EC_GROUP;
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The bytes of a compressed secp256k1 public key.
+	using CompressedPublicKey = std::array<uint8_t, EC_COMPRESSED_PUBLIC_KEY_LENGTH>;
+
+	// A struct which holds the statistics of a public key cache.
+	struct PublicKeyCacheStats
+	{
+		uint64_t hits, misses;
+		size_t size;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which caches decoded public keys, so the keys of senders who make many transactions are only decoded once.
+	// The cache is bounded, the least recently used keys are evicted once it's full. It's split into shards which each
+	// have their own lock, so threads verifying transactions in parallel rarely contend with each other.
+	class PublicKeyCache
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		VOLT_API PublicKeyCache(size_t capacity);
+		VOLT_API PublicKeyCache(const PublicKeyCache& cache) = delete;
+
+		VOLT_API ~PublicKeyCache();
+
+		VOLT_API void operator=(const PublicKeyCache& cache) = delete;
+
+		// Returns the decoded key for the compressed public key given, the key is decoded and cached if it isn't cached.
+		// The reference count of the key returned is increased, so the caller must free it via EVP_PKEY_free().
+		// A null pointer is returned if the public key isn't a valid secp256k1 point.
+		VOLT_API EVP_PKEY* GetPublicKey(const CompressedPublicKey& publicKey);
+
+		// Returns the number of cache hits and misses so far, along with the number of keys cached.
+		VOLT_API PublicKeyCacheStats GetStats() const;
+
+		// Removes every key from the cache.
+		VOLT_API void Clear();
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the public key cache shared by the whole program, which holds 'VOLT_PUBLIC_KEY_CACHE_CAPACITY' keys.
+	extern VOLT_API PublicKeyCache& GetPublicKeyCache();
+
+	// Returns the secp256k1 group shared by the whole program, which uses the compressed point conversion form.
+	// A null pointer is returned if the group couldn't be created.
+	extern VOLT_API const EC_GROUP* GetSecp256k1Group();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -0,0 +1,1589 @@
+#include <crypto/secp256k1.h>
+#include <crypto/sha256.h>
+#include <openssl/crypto.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Multi-word arithmetic, the numbers are held as little-endian arrays of 64-bit words
+
+	// Returns the low 64 bits of the product of the words given, the high 64 bits are written into 'high'.
+	inline uint64_t MultiplyWide(uint64_t a, uint64_t b, uint64_t& high)
+	{
+#if defined(_MSC_VER)
+		return _umul128(a, b, &high);
+#else
+		const unsigned __int128 product = (unsigned __int128)a * b;
+		high = (uint64_t)(product >> 64);
+
+		return (uint64_t)product;
+#endif
+	}
+
+	// Returns the sum of the words given and the carry, the carry is updated with the carry of the sum.
+	inline uint64_t AddWithCarry(uint64_t a, uint64_t b, uint64_t& carry)
+	{
+#if defined(_MSC_VER) || defined(__x86_64__)
+		unsigned long long result;
+		carry = _addcarry_u64((unsigned char)carry, a, b, &result);
+
+		return result;
+#else
+		const unsigned __int128 sum = (unsigned __int128)a + b + carry;
+		carry = (uint64_t)(sum >> 64);
+
+		return (uint64_t)sum;
+#endif
+	}
+
+	// Returns the difference of the words given minus the borrow, the borrow is updated with the borrow of the difference.
+	inline uint64_t SubtractWithBorrow(uint64_t a, uint64_t b, uint64_t& borrow)
+	{
+#if defined(_MSC_VER) || defined(__x86_64__)
+		unsigned long long result;
+		borrow = _subborrow_u64((unsigned char)borrow, a, b, &result);
+
+		return result;
+#else
+		const unsigned __int128 difference = (unsigned __int128)a - b - borrow;
+		borrow = (uint64_t)(difference >> 64) & 1;
+
+		return (uint64_t)difference;
+#endif
+	}
+
+	// A 192-bit accumulator which column sums of word products are gathered in.
+	struct Accumulator
+	{
+		uint64_t c0, c1, c2;
+
+		// Adds the product of the words given to the accumulator.
+		inline void MultiplyAdd(uint64_t a, uint64_t b)
+		{
+			uint64_t high, carry = 0;
+			const uint64_t low = MultiplyWide(a, b, high);
+
+			this->c0 = AddWithCarry(this->c0, low, carry);
+			this->c1 = AddWithCarry(this->c1, high, carry);
+			this->c2 += carry;
+		}
+
+		// Adds twice the product of the words given to the accumulator.
+		inline void MultiplyAddDouble(uint64_t a, uint64_t b)
+		{
+			this->MultiplyAdd(a, b);
+			this->MultiplyAdd(a, b);
+		}
+
+		// Adds the word given to the accumulator.
+		inline void Add(uint64_t a)
+		{
+			uint64_t carry = 0;
+			this->c0 = AddWithCarry(this->c0, a, carry);
+			this->c1 = AddWithCarry(this->c1, 0, carry);
+			this->c2 += carry;
+		}
+
+		// Returns the lowest word of the accumulator and shifts the accumulator down by one word.
+		inline uint64_t Extract()
+		{
+			const uint64_t word = this->c0;
+			this->c0 = this->c1;
+			this->c1 = this->c2;
+			this->c2 = 0;
+
+			return word;
+		}
+	};
+
+	// Writes the 512-bit product of the 256-bit numbers given into 'output', column by column.
+	inline void Multiply256(uint64_t(&output)[8], const uint64_t(&a)[4], const uint64_t(&b)[4])
+	{
+		Accumulator accumulator = { 0, 0, 0 };
+
+		accumulator.MultiplyAdd(a[0], b[0]);
+		output[0] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[0], b[1]);
+		accumulator.MultiplyAdd(a[1], b[0]);
+		output[1] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[0], b[2]);
+		accumulator.MultiplyAdd(a[1], b[1]);
+		accumulator.MultiplyAdd(a[2], b[0]);
+		output[2] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[0], b[3]);
+		accumulator.MultiplyAdd(a[1], b[2]);
+		accumulator.MultiplyAdd(a[2], b[1]);
+		accumulator.MultiplyAdd(a[3], b[0]);
+		output[3] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[1], b[3]);
+		accumulator.MultiplyAdd(a[2], b[2]);
+		accumulator.MultiplyAdd(a[3], b[1]);
+		output[4] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[2], b[3]);
+		accumulator.MultiplyAdd(a[3], b[2]);
+		output[5] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[3], b[3]);
+		output[6] = accumulator.Extract();
+		output[7] = accumulator.Extract();
+	}
+
+	// Writes the 512-bit square of the 256-bit number given into 'output', the symmetric products are only computed once.
+	inline void Square256(uint64_t(&output)[8], const uint64_t(&a)[4])
+	{
+		Accumulator accumulator = { 0, 0, 0 };
+
+		accumulator.MultiplyAdd(a[0], a[0]);
+		output[0] = accumulator.Extract();
+		accumulator.MultiplyAddDouble(a[0], a[1]);
+		output[1] = accumulator.Extract();
+		accumulator.MultiplyAddDouble(a[0], a[2]);
+		accumulator.MultiplyAdd(a[1], a[1]);
+		output[2] = accumulator.Extract();
+		accumulator.MultiplyAddDouble(a[0], a[3]);
+		accumulator.MultiplyAddDouble(a[1], a[2]);
+		output[3] = accumulator.Extract();
+		accumulator.MultiplyAddDouble(a[1], a[3]);
+		accumulator.MultiplyAdd(a[2], a[2]);
+		output[4] = accumulator.Extract();
+		accumulator.MultiplyAddDouble(a[2], a[3]);
+		output[5] = accumulator.Extract();
+		accumulator.MultiplyAdd(a[3], a[3]);
+		output[6] = accumulator.Extract();
+		output[7] = accumulator.Extract();
+	}
+
+	// Returns a mask with every bit set if the condition given (0 or 1) is set, else a mask of zero is returned.
+	inline uint64_t GetMask(uint64_t condition)
+	{
+		return 0 - condition;
+	}
+
+	// Returns the bits of the number given starting at the offset given, up to 63 bits can be read at once.
+	inline uint32_t GetBits(const uint64_t(&words)[4], size_t offset, size_t count)
+	{
+		const size_t wordIndex = offset / 64, shift = offset % 64;
+		if (wordIndex >= 4)
+			return 0;
+
+		uint64_t value = words[wordIndex] >> shift;
+		if (shift + count > 64 && wordIndex + 1 < 4)
+			value |= words[wordIndex + 1] << (64 - shift);
+
+		return (uint32_t)(value & ((1ULL << count) - 1));
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Field elements, which are integers modulo p = 2^256 - 2^32 - 977
+
+	// A field element, which is always fully reduced.
+	struct FieldElement
+	{
+		uint64_t n[4];
+	};
+
+	// Returns the field element with the 32-bit words given, most significant first.
+	constexpr FieldElement MakeFieldElement(uint32_t d7, uint32_t d6, uint32_t d5, uint32_t d4, uint32_t d3, uint32_t d2,
+		uint32_t d1, uint32_t d0)
+	{
+		return { { ((uint64_t)d1 << 32) | d0, ((uint64_t)d3 << 32) | d2, ((uint64_t)d5 << 32) | d4,
+			((uint64_t)d7 << 32) | d6 } };
+	}
+
+	// 2^256 - p, so 2^256 = fieldC (mod p).
+	constexpr uint64_t fieldC = 0x1000003D1ULL;
+
+	// The cube root of unity in the field, multiplying the x-coordinate of a point by it multiplies the point by lambda.
+	constexpr FieldElement fieldBeta = MakeFieldElement(0x7AE96A2B, 0x657C0710, 0x6E64479E, 0xAC3434E9, 0x9CF04975,
+		0x12F58995, 0xC1396C28, 0x719501EE);
+
+	constexpr FieldElement fieldZero = { { 0, 0, 0, 0 } };
+	constexpr FieldElement fieldOne = { { 1, 0, 0, 0 } };
+	constexpr FieldElement fieldCurveB = { { 7, 0, 0, 0 } };
+	constexpr FieldElement fieldCurveB3 = { { 21, 0, 0, 0 } };
+
+	// Sets 'r' to 'a' where the mask is set, the mask must be all zeros or all ones.
+	inline void FieldSelect(FieldElement& r, const FieldElement& a, uint64_t mask)
+	{
+		r.n[0] = (r.n[0] & ~mask) | (a.n[0] & mask);
+		r.n[1] = (r.n[1] & ~mask) | (a.n[1] & mask);
+		r.n[2] = (r.n[2] & ~mask) | (a.n[2] & mask);
+		r.n[3] = (r.n[3] & ~mask) | (a.n[3] & mask);
+	}
+
+	// Reduces the number given (with the overflow bit of bit 256) below p, the number must be less than 2p.
+	inline void FieldNormalize(FieldElement& r, uint64_t overflow)
+	{
+		// The number is at least p if adding 2^256 - p to it overflows
+		FieldElement reduced;
+		uint64_t carry = 0;
+		reduced.n[0] = AddWithCarry(r.n[0], fieldC, carry);
+		reduced.n[1] = AddWithCarry(r.n[1], 0, carry);
+		reduced.n[2] = AddWithCarry(r.n[2], 0, carry);
+		reduced.n[3] = AddWithCarry(r.n[3], 0, carry);
+
+		FieldSelect(r, reduced, GetMask(carry | overflow));
+	}
+
+	inline void FieldAdd(FieldElement& r, const FieldElement& a, const FieldElement& b)
+	{
+		FieldElement result;
+		uint64_t carry = 0;
+		result.n[0] = AddWithCarry(a.n[0], b.n[0], carry);
+		result.n[1] = AddWithCarry(a.n[1], b.n[1], carry);
+		result.n[2] = AddWithCarry(a.n[2], b.n[2], carry);
+		result.n[3] = AddWithCarry(a.n[3], b.n[3], carry);
+
+		FieldNormalize(result, carry);
+		r = result;
+	}
+
+	inline void FieldSubtract(FieldElement& r, const FieldElement& a, const FieldElement& b)
+	{
+		uint64_t borrow = 0;
+		r.n[0] = SubtractWithBorrow(a.n[0], b.n[0], borrow);
+		r.n[1] = SubtractWithBorrow(a.n[1], b.n[1], borrow);
+		r.n[2] = SubtractWithBorrow(a.n[2], b.n[2], borrow);
+		r.n[3] = SubtractWithBorrow(a.n[3], b.n[3], borrow);
+
+		// Adding p back when the difference went negative is the same as subtracting 2^256 - p, which can't borrow again
+		const uint64_t correction = fieldC & GetMask(borrow);
+		borrow = 0;
+		r.n[0] = SubtractWithBorrow(r.n[0], correction, borrow);
+		r.n[1] = SubtractWithBorrow(r.n[1], 0, borrow);
+		r.n[2] = SubtractWithBorrow(r.n[2], 0, borrow);
+		r.n[3] = SubtractWithBorrow(r.n[3], 0, borrow);
+	}
+
+	inline void FieldNegate(FieldElement& r, const FieldElement& a)
+	{
+		FieldSubtract(r, fieldZero, a);
+	}
+
+	// Reduces the 512-bit number given modulo p.
+	inline void FieldReduceWide(FieldElement& r, const uint64_t(&wide)[8])
+	{
+		// The result is built in a local so it stays in registers until it's fully reduced
+		FieldElement result;
+
+		// 2^256 = fieldC (mod p), so the high half is folded into the low half by multiplying it by fieldC
+		Accumulator accumulator = { wide[0], 0, 0 };
+		accumulator.MultiplyAdd(wide[4], fieldC);
+		result.n[0] = accumulator.Extract();
+		accumulator.Add(wide[1]);
+		accumulator.MultiplyAdd(wide[5], fieldC);
+		result.n[1] = accumulator.Extract();
+		accumulator.Add(wide[2]);
+		accumulator.MultiplyAdd(wide[6], fieldC);
+		result.n[2] = accumulator.Extract();
+		accumulator.Add(wide[3]);
+		accumulator.MultiplyAdd(wide[7], fieldC);
+		result.n[3] = accumulator.Extract();
+
+		// The result is at most 290 bits, so the bits above 256 are folded again
+		uint64_t high, carry = 0;
+		const uint64_t low = MultiplyWide(accumulator.c0, fieldC, high);
+
+		result.n[0] = AddWithCarry(result.n[0], low, carry);
+		result.n[1] = AddWithCarry(result.n[1], high, carry);
+		result.n[2] = AddWithCarry(result.n[2], 0, carry);
+		result.n[3] = AddWithCarry(result.n[3], 0, carry);
+
+		// If that overflowed the low words are tiny, so subtracting p once (via the overflow) is enough either way
+		FieldNormalize(result, carry);
+		r = result;
+	}
+
+	inline void FieldMultiply(FieldElement& r, const FieldElement& a, const FieldElement& b)
+	{
+		uint64_t wide[8];
+		Multiply256(wide, a.n, b.n);
+		FieldReduceWide(r, wide);
+	}
+
+	inline void FieldSquare(FieldElement& r, const FieldElement& a)
+	{
+		uint64_t wide[8];
+		Square256(wide, a.n);
+		FieldReduceWide(r, wide);
+	}
+
+	// Squares the field element given 'count' times.
+	inline void FieldSquareRepeated(FieldElement& r, const FieldElement& a, size_t count)
+	{
+		r = a;
+		for (size_t i = 0; i < count; i++)
+			FieldSquare(r, r);
+	}
+
+	inline bool FieldIsZero(const FieldElement& a)
+	{
+		return (a.n[0] | a.n[1] | a.n[2] | a.n[3]) == 0;
+	}
+
+	inline bool FieldEquals(const FieldElement& a, const FieldElement& b)
+	{
+		return ((a.n[0] ^ b.n[0]) | (a.n[1] ^ b.n[1]) | (a.n[2] ^ b.n[2]) | (a.n[3] ^ b.n[3])) == 0;
+	}
+
+	inline bool FieldIsOdd(const FieldElement& a)
+	{
+		return a.n[0] & 1;
+	}
+
+	// Reads a 32-byte big-endian field element, FALSE is returned if it isn't less than p.
+	bool FieldSetBytes(FieldElement& r, const uint8_t* bytes)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			r.n[3 - i] = 0;
+			for (size_t j = 0; j < 8; j++)
+				r.n[3 - i] = (r.n[3 - i] << 8) | bytes[i * 8 + j];
+		}
+
+		uint64_t carry = 0;
+		for (size_t i = 0; i < 4; i++)
+			AddWithCarry(r.n[i], i == 0 ? fieldC : 0, carry);
+
+		return carry == 0;
+	}
+
+	// Writes the field element as a 32-byte big-endian number.
+	void FieldGetBytes(uint8_t* bytes, const FieldElement& a)
+	{
+		for (size_t i = 0; i < 4; i++)
+			for (size_t j = 0; j < 8; j++)
+				bytes[i * 8 + j] = (uint8_t)(a.n[3 - i] >> (56 - j * 8));
+	}
+
+	// Computes the powers a^(2^k - 1) shared by the inverse and square root addition chains, the result is a^(2^223 - 1).
+	// a^(2^2 - 1) and a^(2^22 - 1) are written into 'x2' and 'x22' since the chains need them too.
+	void FieldPowerChain(FieldElement& x223, FieldElement& x2, FieldElement& x22, const FieldElement& a)
+	{
+		FieldElement x3, x6, x9, x11, x44, x88, x176, x220, t;
+
+		FieldSquare(t, a);
+		FieldMultiply(x2, t, a);
+		FieldSquare(t, x2);
+		FieldMultiply(x3, t, a);
+		FieldSquareRepeated(t, x3, 3);
+		FieldMultiply(x6, t, x3);
+		FieldSquareRepeated(t, x6, 3);
+		FieldMultiply(x9, t, x3);
+		FieldSquareRepeated(t, x9, 2);
+		FieldMultiply(x11, t, x2);
+		FieldSquareRepeated(t, x11, 11);
+		FieldMultiply(x22, t, x11);
+		FieldSquareRepeated(t, x22, 22);
+		FieldMultiply(x44, t, x22);
+		FieldSquareRepeated(t, x44, 44);
+		FieldMultiply(x88, t, x44);
+		FieldSquareRepeated(t, x88, 88);
+		FieldMultiply(x176, t, x88);
+		FieldSquareRepeated(t, x176, 44);
+		FieldMultiply(x220, t, x44);
+		FieldSquareRepeated(t, x220, 3);
+		FieldMultiply(x223, t, x3);
+	}
+
+	// Sets 'r' to the inverse of 'a' via a^(p - 2), the addition chain is fixed so this is constant-time.
+	void FieldInverse(FieldElement& r, const FieldElement& a)
+	{
+		FieldElement x223, x2, x22, t;
+		FieldPowerChain(x223, x2, x22, a);
+
+		FieldSquareRepeated(t, x223, 23);
+		FieldMultiply(t, t, x22);
+		FieldSquareRepeated(t, t, 5);
+		FieldMultiply(t, t, a);
+		FieldSquareRepeated(t, t, 3);
+		FieldMultiply(t, t, x2);
+		FieldSquareRepeated(t, t, 2);
+		FieldMultiply(r, t, a);
+	}
+
+	// Sets 'r' to a square root of 'a' via a^((p + 1) / 4), FALSE is returned if 'a' isn't a square.
+	bool FieldSquareRoot(FieldElement& r, const FieldElement& a)
+	{
+		FieldElement x223, x2, x22, t;
+		FieldPowerChain(x223, x2, x22, a);
+
+		FieldSquareRepeated(t, x223, 23);
+		FieldMultiply(t, t, x22);
+		FieldSquareRepeated(t, t, 6);
+		FieldMultiply(t, t, x2);
+		FieldSquareRepeated(r, t, 2);
+
+		FieldSquare(t, r);
+		return FieldEquals(t, a);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Scalars, which are integers modulo the group order n
+
+	// A scalar, which is always fully reduced.
+	struct Scalar
+	{
+		uint64_t n[4];
+	};
+
+	// Returns the scalar with the 32-bit words given, most significant first.
+	constexpr Scalar MakeScalar(uint32_t d7, uint32_t d6, uint32_t d5, uint32_t d4, uint32_t d3, uint32_t d2, uint32_t d1,
+		uint32_t d0)
+	{
+		return { { ((uint64_t)d1 << 32) | d0, ((uint64_t)d3 << 32) | d2, ((uint64_t)d5 << 32) | d4,
+			((uint64_t)d7 << 32) | d6 } };
+	}
+
+	constexpr Scalar scalarOrder = MakeScalar(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0xBAAEDCE6, 0xAF48A03B,
+		0xBFD25E8C, 0xD0364141);
+
+	// 2^256 - n, so 2^256 = scalarC (mod n).
+	constexpr uint64_t scalarC[3] = { 0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 1 };
+
+	// The constants used to split a scalar into two 128-bit halves with the GLV endomorphism.
+	constexpr Scalar scalarMinusLambda = MakeScalar(0xAC9C52B3, 0x3FA3CF1F, 0x5AD9E3FD, 0x77ED9BA4, 0xA880B9FC, 0x8EC739C2,
+		0xE0CFC810, 0xB51283CF);
+	constexpr Scalar scalarMinusB1 = MakeScalar(0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xE4437ED6, 0x010E8828,
+		0x6F547FA9, 0x0ABFE4C3);
+	constexpr Scalar scalarMinusB2 = MakeScalar(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x8A280AC5, 0x0774346D,
+		0xD765CDA8, 0x3DB1562C);
+	constexpr Scalar scalarG1 = MakeScalar(0x3086D221, 0xA7D46BCD, 0xE86C90E4, 0x9284EB15, 0x3DAA8A14, 0x71E8CA7F,
+		0xE893209A, 0x45DBB031);
+	constexpr Scalar scalarG2 = MakeScalar(0xE4437ED6, 0x010E8828, 0x6F547FA9, 0x0ABFE4C4, 0x221208AC, 0x9DF506C6,
+		0x1571B4AE, 0x8AC47F71);
+
+	inline void ScalarSelect(Scalar& r, const Scalar& a, uint64_t mask)
+	{
+		r.n[0] = (r.n[0] & ~mask) | (a.n[0] & mask);
+		r.n[1] = (r.n[1] & ~mask) | (a.n[1] & mask);
+		r.n[2] = (r.n[2] & ~mask) | (a.n[2] & mask);
+		r.n[3] = (r.n[3] & ~mask) | (a.n[3] & mask);
+	}
+
+	// Reduces the number given (with the overflow bit of bit 256) below n, the number must be less than 2n.
+	// Returns 1 if the number was reduced, else 0 is returned.
+	inline uint64_t ScalarNormalize(Scalar& r, uint64_t overflow)
+	{
+		Scalar reduced;
+		uint64_t carry = 0;
+		reduced.n[0] = AddWithCarry(r.n[0], scalarC[0], carry);
+		reduced.n[1] = AddWithCarry(r.n[1], scalarC[1], carry);
+		reduced.n[2] = AddWithCarry(r.n[2], scalarC[2], carry);
+		reduced.n[3] = AddWithCarry(r.n[3], 0, carry);
+
+		const uint64_t reduce = carry | overflow;
+		ScalarSelect(r, reduced, GetMask(reduce));
+
+		return reduce;
+	}
+
+	inline void ScalarAdd(Scalar& r, const Scalar& a, const Scalar& b)
+	{
+		uint64_t carry = 0;
+		r.n[0] = AddWithCarry(a.n[0], b.n[0], carry);
+		r.n[1] = AddWithCarry(a.n[1], b.n[1], carry);
+		r.n[2] = AddWithCarry(a.n[2], b.n[2], carry);
+		r.n[3] = AddWithCarry(a.n[3], b.n[3], carry);
+
+		ScalarNormalize(r, carry);
+	}
+
+	inline bool ScalarIsZero(const Scalar& a)
+	{
+		return (a.n[0] | a.n[1] | a.n[2] | a.n[3]) == 0;
+	}
+
+	inline void ScalarNegate(Scalar& r, const Scalar& a)
+	{
+		const uint64_t nonZeroMask = GetMask(!ScalarIsZero(a));
+
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < 4; i++)
+			r.n[i] = SubtractWithBorrow(scalarOrder.n[i], a.n[i], borrow) & nonZeroMask;
+	}
+
+	// (n - 1) / 2, the largest s of a low-S signiture.
+	constexpr Scalar scalarHalfOrder = MakeScalar(0x7FFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x5D576E73, 0x57A4501D,
+		0xDFE92F46, 0x681B20A0);
+
+	// Returns TRUE if the scalar given is above (n - 1) / 2, in constant time.
+	inline bool ScalarIsHigh(const Scalar& a)
+	{
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < 4; i++)
+			SubtractWithBorrow(scalarHalfOrder.n[i], a.n[i], borrow);
+
+		return borrow;
+	}
+
+	// Reduces the 512-bit number given modulo n.
+	void ScalarReduceWide(Scalar& r, const uint64_t(&wide)[8])
+	{
+		// 2^256 = scalarC (mod n) and scalarC is 129 bits (its top word is 1), so each fold of the words above 256 bits
+		// shrinks the number by ~127 bits. The first fold leaves at most 386 bits
+		Accumulator accumulator = { wide[0], 0, 0 };
+		uint64_t folded[7];
+
+		accumulator.MultiplyAdd(wide[4], scalarC[0]);
+		folded[0] = accumulator.Extract();
+		accumulator.Add(wide[1]);
+		accumulator.MultiplyAdd(wide[5], scalarC[0]);
+		accumulator.MultiplyAdd(wide[4], scalarC[1]);
+		folded[1] = accumulator.Extract();
+		accumulator.Add(wide[2]);
+		accumulator.MultiplyAdd(wide[6], scalarC[0]);
+		accumulator.MultiplyAdd(wide[5], scalarC[1]);
+		accumulator.Add(wide[4]);
+		folded[2] = accumulator.Extract();
+		accumulator.Add(wide[3]);
+		accumulator.MultiplyAdd(wide[7], scalarC[0]);
+		accumulator.MultiplyAdd(wide[6], scalarC[1]);
+		accumulator.Add(wide[5]);
+		folded[3] = accumulator.Extract();
+		accumulator.MultiplyAdd(wide[7], scalarC[1]);
+		accumulator.Add(wide[6]);
+		folded[4] = accumulator.Extract();
+		accumulator.Add(wide[7]);
+		folded[5] = accumulator.Extract();
+		folded[6] = accumulator.c0;
+
+		// The second fold leaves at most 260 bits
+		uint64_t foldedAgain[5];
+
+		accumulator = { folded[0], 0, 0 };
+		accumulator.MultiplyAdd(folded[4], scalarC[0]);
+		foldedAgain[0] = accumulator.Extract();
+		accumulator.Add(folded[1]);
+		accumulator.MultiplyAdd(folded[5], scalarC[0]);
+		accumulator.MultiplyAdd(folded[4], scalarC[1]);
+		foldedAgain[1] = accumulator.Extract();
+		accumulator.Add(folded[2]);
+		accumulator.MultiplyAdd(folded[6], scalarC[0]);
+		accumulator.MultiplyAdd(folded[5], scalarC[1]);
+		accumulator.Add(folded[4]);
+		foldedAgain[2] = accumulator.Extract();
+		accumulator.Add(folded[3]);
+		accumulator.MultiplyAdd(folded[6], scalarC[1]);
+		accumulator.Add(folded[5]);
+		foldedAgain[3] = accumulator.Extract();
+		accumulator.Add(folded[6]);
+		foldedAgain[4] = accumulator.c0;
+
+		// The last fold leaves at most 257 bits, which one conditional subtraction of n reduces
+		uint64_t carry = 0, high0, high1;
+		const uint64_t low0 = MultiplyWide(foldedAgain[4], scalarC[0], high0);
+		const uint64_t low1 = MultiplyWide(foldedAgain[4], scalarC[1], high1);
+
+		r.n[0] = AddWithCarry(foldedAgain[0], low0, carry);
+		r.n[1] = AddWithCarry(foldedAgain[1], low1, carry);
+		r.n[2] = AddWithCarry(foldedAgain[2], foldedAgain[4], carry);
+		r.n[3] = AddWithCarry(foldedAgain[3], 0, carry);
+
+		uint64_t highCarry = 0;
+		r.n[1] = AddWithCarry(r.n[1], high0, highCarry);
+		r.n[2] = AddWithCarry(r.n[2], high1, highCarry);
+		r.n[3] = AddWithCarry(r.n[3], 0, highCarry);
+
+		ScalarNormalize(r, carry | highCarry);
+	}
+
+	inline void ScalarMultiply(Scalar& r, const Scalar& a, const Scalar& b)
+	{
+		uint64_t wide[8];
+		Multiply256(wide, a.n, b.n);
+		ScalarReduceWide(r, wide);
+	}
+
+	inline void ScalarSquare(Scalar& r, const Scalar& a)
+	{
+		uint64_t wide[8];
+		Square256(wide, a.n);
+		ScalarReduceWide(r, wide);
+	}
+
+	// Sets 'r' to the inverse of 'a' via a^(n - 2) using a fixed 4-bit window. The exponent is public, so the sequence of
+	// operations doesn't depend on 'a' and this is constant-time.
+	void ScalarInverse(Scalar& r, const Scalar& a)
+	{
+		Scalar exponent = scalarOrder, powers[16];
+		exponent.n[0] -= 2;
+
+		powers[0] = { { 1, 0, 0, 0 } };
+		powers[1] = a;
+		for (size_t i = 2; i < 16; i++)
+			ScalarMultiply(powers[i], powers[i - 1], a);
+
+		Scalar result = powers[0];
+		for (int window = 63; window >= 0; window--)
+		{
+			for (size_t i = 0; i < 4; i++)
+				ScalarSquare(result, result);
+
+			ScalarMultiply(result, result, powers[GetBits(exponent.n, window * 4, 4)]);
+		}
+
+		r = result;
+		OPENSSL_cleanse(powers, sizeof(powers));
+	}
+
+	// Reads a 32-byte big-endian number as a scalar reduced modulo n, returns TRUE if the number wasn't less than n.
+	bool ScalarSetBytes(Scalar& r, const uint8_t* bytes)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			r.n[3 - i] = 0;
+			for (size_t j = 0; j < 8; j++)
+				r.n[3 - i] = (r.n[3 - i] << 8) | bytes[i * 8 + j];
+		}
+
+		return ScalarNormalize(r, 0);
+	}
+
+	void ScalarGetBytes(uint8_t* bytes, const Scalar& a)
+	{
+		for (size_t i = 0; i < 4; i++)
+			for (size_t j = 0; j < 8; j++)
+				bytes[i * 8 + j] = (uint8_t)(a.n[3 - i] >> (56 - j * 8));
+	}
+
+	// Returns the 128 most significant bits of the 512-bit product of the numbers given shifted right by 384 bits, rounded
+	// to the nearest integer.
+	Scalar ScalarMultiplyShift384(const Scalar& a, const Scalar& b)
+	{
+		uint64_t wide[8];
+		Multiply256(wide, a.n, b.n);
+
+		Scalar r = { { wide[6], wide[7], 0, 0 } };
+		uint64_t carry = 0;
+		r.n[0] = AddWithCarry(r.n[0], wide[5] >> 63, carry);
+		r.n[1] = AddWithCarry(r.n[1], 0, carry);
+
+		return r;
+	}
+
+	// Splits the scalar given into 'r1' and 'r2' such that k = r1 + r2 * lambda (mod n), where r1 and r2 are both less than
+	// 2^128 in absolute value (i.e. they're either below 2^128 or above n - 2^128).
+	void ScalarSplitLambda(Scalar& r1, Scalar& r2, const Scalar& k)
+	{
+		Scalar c1 = ScalarMultiplyShift384(k, scalarG1), c2 = ScalarMultiplyShift384(k, scalarG2);
+
+		ScalarMultiply(c1, c1, scalarMinusB1);
+		ScalarMultiply(c2, c2, scalarMinusB2);
+		ScalarAdd(r2, c1, c2);
+		ScalarMultiply(r1, r2, scalarMinusLambda);
+		ScalarAdd(r1, r1, k);
+	}
+
+	// Makes the scalar given positive and less than 2^128 if it's a negative split half, returns TRUE if it was negated.
+	bool ScalarMakeShort(Scalar& a)
+	{
+		if ((a.n[2] | a.n[3]) == 0)
+			return false;
+
+		ScalarNegate(a, a);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Points on the curve y^2 = x^3 + 7
+
+	// A point in affine coordinates.
+	struct AffinePoint
+	{
+		FieldElement x, y;
+		bool infinity;
+	};
+
+	// A point in Jacobian coordinates, where x = X / Z^2 and y = Y / Z^3.
+	struct JacobianPoint
+	{
+		FieldElement x, y, z;
+		bool infinity;
+	};
+
+	// A point in homogeneous projective coordinates, where x = X / Z and y = Y / Z. The point at infinity is (0 : 1 : 0),
+	// so these can be added with the complete formulas without checking for special cases.
+	struct ProjectivePoint
+	{
+		FieldElement x, y, z;
+	};
+
+	constexpr AffinePoint generatorPoint = {
+		MakeFieldElement(0x79BE667E, 0xF9DCBBAC, 0x55A06295, 0xCE870B07, 0x029BFCDB, 0x2DCE28D9, 0x59F2815B, 0x16F81798),
+		MakeFieldElement(0x483ADA77, 0x26A3C465, 0x5DA4FBFC, 0x0E1108A8, 0xFD17B448, 0xA6855419, 0x9C47D08F, 0xFB10D4B8),
+		false
+	};
+
+	// Returns TRUE if the affine point given is on the curve.
+	bool IsOnCurve(const AffinePoint& a)
+	{
+		FieldElement lhs, rhs;
+		FieldSquare(lhs, a.y);
+		FieldSquare(rhs, a.x);
+		FieldMultiply(rhs, rhs, a.x);
+		FieldAdd(rhs, rhs, fieldCurveB);
+
+		return FieldEquals(lhs, rhs);
+	}
+
+	inline JacobianPoint ToJacobian(const AffinePoint& a)
+	{
+		return { a.x, a.y, fieldOne, a.infinity };
+	}
+
+	// Sets 'r' to 2a.
+	void PointDouble(JacobianPoint& r, const JacobianPoint& a)
+	{
+		// secp256k1 has no points of order 2, so y is never zero and the result is only infinity if a is
+		if (a.infinity)
+		{
+			r.infinity = true;
+			return;
+		}
+
+		FieldElement xx, yy, yyyy, d, e, f, x3, y3, z3;
+
+		FieldSquare(xx, a.x);
+		FieldSquare(yy, a.y);
+		FieldSquare(yyyy, yy);
+
+		// d = 2 * ((x + yy)^2 - xx - yyyy)
+		FieldAdd(d, a.x, yy);
+		FieldSquare(d, d);
+		FieldSubtract(d, d, xx);
+		FieldSubtract(d, d, yyyy);
+		FieldAdd(d, d, d);
+
+		// e = 3 * xx, f = e^2
+		FieldAdd(e, xx, xx);
+		FieldAdd(e, e, xx);
+		FieldSquare(f, e);
+
+		// x3 = f - 2d
+		FieldSubtract(x3, f, d);
+		FieldSubtract(x3, x3, d);
+
+		// y3 = e * (d - x3) - 8 * yyyy
+		FieldSubtract(y3, d, x3);
+		FieldMultiply(y3, y3, e);
+		FieldAdd(yyyy, yyyy, yyyy);
+		FieldAdd(yyyy, yyyy, yyyy);
+		FieldAdd(yyyy, yyyy, yyyy);
+		FieldSubtract(y3, y3, yyyy);
+
+		// z3 = 2 * y * z
+		FieldMultiply(z3, a.y, a.z);
+		FieldAdd(z3, z3, z3);
+
+		r = { x3, y3, z3, false };
+	}
+
+	// Sets 'r' to a + b, where u1 = x1 * z2^2 and s1 = y1 * z2^3 have already been computed for 'a', and u2 and s2 for 'b'.
+	void PointAddScaled(JacobianPoint& r, const JacobianPoint& a, const FieldElement& u1, const FieldElement& s1,
+		const FieldElement& u2, const FieldElement& s2, const FieldElement& zProduct)
+	{
+		FieldElement h, rr, hh, hhh, v, x3, y3, z3;
+
+		FieldSubtract(h, u2, u1);
+		FieldSubtract(rr, s2, s1);
+
+		if (FieldIsZero(h))
+		{
+			// The points have the same x-coordinate, so they're either equal or each other's negation
+			if (FieldIsZero(rr))
+				PointDouble(r, a);
+			else
+				r.infinity = true;
+
+			return;
+		}
+
+		FieldSquare(hh, h);
+		FieldMultiply(hhh, h, hh);
+		FieldMultiply(v, u1, hh);
+
+		// x3 = rr^2 - hhh - 2v
+		FieldSquare(x3, rr);
+		FieldSubtract(x3, x3, hhh);
+		FieldSubtract(x3, x3, v);
+		FieldSubtract(x3, x3, v);
+
+		// y3 = rr * (v - x3) - s1 * hhh
+		FieldSubtract(y3, v, x3);
+		FieldMultiply(y3, y3, rr);
+		FieldMultiply(hhh, hhh, s1);
+		FieldSubtract(y3, y3, hhh);
+
+		// z3 = z1 * z2 * h
+		FieldMultiply(z3, zProduct, h);
+
+		r = { x3, y3, z3, false };
+	}
+
+	// Sets 'r' to a + b, where b is an affine point.
+	void PointAddAffine(JacobianPoint& r, const JacobianPoint& a, const AffinePoint& b)
+	{
+		if (b.infinity)
+		{
+			r = a;
+			return;
+		}
+
+		if (a.infinity)
+		{
+			r = ToJacobian(b);
+			return;
+		}
+
+		FieldElement zz, u2, s2;
+		FieldSquare(zz, a.z);
+		FieldMultiply(u2, b.x, zz);
+		FieldMultiply(s2, b.y, zz);
+		FieldMultiply(s2, s2, a.z);
+
+		PointAddScaled(r, a, a.x, a.y, u2, s2, a.z);
+	}
+
+	// Sets 'r' to a + b.
+	void PointAdd(JacobianPoint& r, const JacobianPoint& a, const JacobianPoint& b)
+	{
+		if (b.infinity)
+		{
+			r = a;
+			return;
+		}
+
+		if (a.infinity)
+		{
+			r = b;
+			return;
+		}
+
+		FieldElement z1z1, z2z2, u1, u2, s1, s2, zProduct;
+		FieldSquare(z1z1, a.z);
+		FieldSquare(z2z2, b.z);
+		FieldMultiply(u1, a.x, z2z2);
+		FieldMultiply(u2, b.x, z1z1);
+		FieldMultiply(s1, a.y, z2z2);
+		FieldMultiply(s1, s1, b.z);
+		FieldMultiply(s2, b.y, z1z1);
+		FieldMultiply(s2, s2, a.z);
+		FieldMultiply(zProduct, a.z, b.z);
+
+		PointAddScaled(r, a, u1, s1, u2, s2, zProduct);
+	}
+
+	// Sets 'r' to a + b using the complete addition formulas for a = 0 curves (Renes, Costello and Batina, algorithm 7),
+	// which have no special cases and so run in constant time.
+	void PointAddComplete(ProjectivePoint& r, const ProjectivePoint& a, const ProjectivePoint& b)
+	{
+		FieldElement t0, t1, t2, t3, t4, x3, y3, z3;
+
+		FieldMultiply(t0, a.x, b.x);
+		FieldMultiply(t1, a.y, b.y);
+		FieldMultiply(t2, a.z, b.z);
+		FieldAdd(t3, a.x, a.y);
+		FieldAdd(t4, b.x, b.y);
+		FieldMultiply(t3, t3, t4);
+		FieldAdd(t4, t0, t1);
+		FieldSubtract(t3, t3, t4);
+		FieldAdd(t4, a.y, a.z);
+		FieldAdd(x3, b.y, b.z);
+		FieldMultiply(t4, t4, x3);
+		FieldAdd(x3, t1, t2);
+		FieldSubtract(t4, t4, x3);
+		FieldAdd(x3, a.x, a.z);
+		FieldAdd(y3, b.x, b.z);
+		FieldMultiply(x3, x3, y3);
+		FieldAdd(y3, t0, t2);
+		FieldSubtract(y3, x3, y3);
+		FieldAdd(x3, t0, t0);
+		FieldAdd(t0, x3, t0);
+		FieldMultiply(t2, fieldCurveB3, t2);
+		FieldAdd(z3, t1, t2);
+		FieldSubtract(t1, t1, t2);
+		FieldMultiply(y3, fieldCurveB3, y3);
+		FieldMultiply(x3, t4, y3);
+		FieldMultiply(t2, t3, t1);
+		FieldSubtract(x3, t2, x3);
+		FieldMultiply(y3, y3, t0);
+		FieldMultiply(t1, t1, z3);
+		FieldAdd(y3, t1, y3);
+		FieldMultiply(t0, t0, t3);
+		FieldMultiply(z3, z3, t4);
+		FieldAdd(z3, z3, t0);
+
+		r = { x3, y3, z3 };
+	}
+
+	// Converts the Jacobian points given into affine points, using one field inversion for all of them.
+	void BatchToAffine(AffinePoint* output, const JacobianPoint* points, size_t numPoints)
+	{
+		// Montgomery's trick, the inverse of every z-coordinate is recovered from the inverse of their product
+		std::vector<FieldElement> prefixProducts(numPoints);
+		FieldElement product = fieldOne;
+
+		for (size_t i = 0; i < numPoints; i++)
+		{
+			prefixProducts[i] = product;
+			if (!points[i].infinity)
+				FieldMultiply(product, product, points[i].z);
+		}
+
+		FieldElement inverse;
+		FieldInverse(inverse, product);
+
+		for (size_t i = numPoints; i-- > 0;)
+		{
+			if (points[i].infinity)
+			{
+				output[i] = { fieldZero, fieldZero, true };
+				continue;
+			}
+
+			FieldElement zInverse, zInverse2, zInverse3;
+			FieldMultiply(zInverse, inverse, prefixProducts[i]);
+			FieldMultiply(inverse, inverse, points[i].z);
+
+			FieldSquare(zInverse2, zInverse);
+			FieldMultiply(zInverse3, zInverse2, zInverse);
+			FieldMultiply(output[i].x, points[i].x, zInverse2);
+			FieldMultiply(output[i].y, points[i].y, zInverse3);
+			output[i].infinity = false;
+		}
+	}
+
+	// Reads a compressed or uncompressed public key, FALSE is returned if it isn't a valid point.
+	bool ParsePublicKey(AffinePoint& r, const uint8_t* publicKey, size_t publicKeyLength)
+	{
+		r.infinity = false;
+
+		if (publicKeyLength == SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH && publicKey[0] == 0x04)
+		{
+			return FieldSetBytes(r.x, publicKey + 1) && FieldSetBytes(r.y, publicKey + 33) && IsOnCurve(r);
+		}
+		else if (publicKeyLength == SECP256K1_COMPRESSED_PUBLIC_KEY_LENGTH &&
+			(publicKey[0] == 0x02 || publicKey[0] == 0x03))
+		{
+			if (!FieldSetBytes(r.x, publicKey + 1))
+				return false;
+
+			// y = sqrt(x^3 + 7), picking the root with the parity given by the prefix
+			FieldElement rhs;
+			FieldSquare(rhs, r.x);
+			FieldMultiply(rhs, rhs, r.x);
+			FieldAdd(rhs, rhs, fieldCurveB);
+
+			if (!FieldSquareRoot(r.y, rhs))
+				return false;
+
+			if (FieldIsOdd(r.y) != (publicKey[0] == 0x03))
+				FieldNegate(r.y, r.y);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Precomputed generator tables
+
+	// The wNAF windows used for the generator and public key multiples, the tables hold 2^(window - 2) odd multiples.
+	constexpr int generatorWindow = 8;
+	constexpr int publicKeyWindow = 5;
+	constexpr size_t generatorTableSize = 1 << (generatorWindow - 2);
+	constexpr size_t publicKeyTableSize = 1 << (publicKeyWindow - 2);
+
+	// The number of wNAF digits of a scalar below 2^128, one more digit is needed for the final carry.
+	constexpr int wnafLength = 130;
+
+	// The number of 4-bit teeth in the signing comb, and the number of entries per tooth.
+	constexpr size_t combTeeth = 64;
+	constexpr size_t combEntries = 16;
+
+	struct GeneratorTables
+	{
+		// The odd multiples G, 3G, 5G, ... and the same multiples of 2^128 * G
+		AffinePoint oddMultiples[generatorTableSize], oddMultiplesHigh[generatorTableSize];
+
+		// comb[i][j] = j * 16^i * G, used for constant-time multiplication of G
+		ProjectivePoint comb[combTeeth][combEntries];
+	};
+
+	// Writes the odd multiples P, 3P, 5P, ... of the point given into 'output'.
+	void GetOddMultiples(JacobianPoint* output, size_t numMultiples, const JacobianPoint& point)
+	{
+		JacobianPoint doubled;
+		PointDouble(doubled, point);
+
+		output[0] = point;
+		for (size_t i = 1; i < numMultiples; i++)
+			PointAdd(output[i], output[i - 1], doubled);
+	}
+
+	std::unique_ptr<GeneratorTables> BuildGeneratorTables()
+	{
+		std::unique_ptr<GeneratorTables> tables = std::make_unique<GeneratorTables>();
+
+		// The odd multiples of G and of 2^128 * G for verification
+		JacobianPoint generatorHigh = ToJacobian(generatorPoint);
+		for (size_t i = 0; i < 128; i++)
+			PointDouble(generatorHigh, generatorHigh);
+
+		std::vector<JacobianPoint> multiples(generatorTableSize * 2);
+		GetOddMultiples(multiples.data(), generatorTableSize, ToJacobian(generatorPoint));
+		GetOddMultiples(multiples.data() + generatorTableSize, generatorTableSize, generatorHigh);
+
+		std::vector<AffinePoint> affineMultiples(multiples.size());
+		BatchToAffine(affineMultiples.data(), multiples.data(), multiples.size());
+
+		std::copy(affineMultiples.begin(), affineMultiples.begin() + generatorTableSize, tables->oddMultiples);
+		std::copy(affineMultiples.begin() + generatorTableSize, affineMultiples.end(), tables->oddMultiplesHigh);
+
+		// The comb for signing
+		std::vector<JacobianPoint> combPoints(combTeeth * combEntries);
+		JacobianPoint tooth = ToJacobian(generatorPoint);
+
+		for (size_t i = 0; i < combTeeth; i++)
+		{
+			combPoints[i * combEntries].infinity = true;
+			for (size_t j = 1; j < combEntries; j++)
+				PointAdd(combPoints[i * combEntries + j], combPoints[i * combEntries + j - 1], tooth);
+
+			for (size_t j = 0; j < 4; j++)
+				PointDouble(tooth, tooth);
+		}
+
+		std::vector<AffinePoint> affineCombPoints(combPoints.size());
+		BatchToAffine(affineCombPoints.data(), combPoints.data(), combPoints.size());
+
+		for (size_t i = 0; i < affineCombPoints.size(); i++)
+		{
+			const AffinePoint& point = affineCombPoints[i];
+			tables->comb[i / combEntries][i % combEntries] = point.infinity ?
+				ProjectivePoint{ fieldZero, fieldOne, fieldZero } : ProjectivePoint{ point.x, point.y, fieldOne };
+		}
+
+		return tables;
+	}
+
+	// Returns the generator tables, which are built the first time this is called.
+	const GeneratorTables& GetGeneratorTables()
+	{
+		static const std::unique_ptr<GeneratorTables> tables = BuildGeneratorTables();
+		return *tables;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Scalar multiplication
+
+	// Writes the wNAF representation of the scalar given (which must be below 2^128) into 'wnaf', every non-zero digit is
+	// odd and less than 2^(window - 1) in absolute value. Returns the number of digits up to the last non-zero digit.
+	int GetWNAF(int(&wnaf)[wnafLength], const Scalar& a, int window)
+	{
+		int carry = 0, lastSetBit = -1;
+		for (int& digit : wnaf)
+			digit = 0;
+
+		for (int bit = 0; bit < wnafLength;)
+		{
+			if ((int)GetBits(a.n, bit, 1) == carry)
+			{
+				bit++;
+				continue;
+			}
+
+			const int numBits = std::min(window, wnafLength - bit);
+			int word = (int)GetBits(a.n, bit, numBits) + carry;
+
+			carry = (word >> (window - 1)) & 1;
+			word -= carry << window;
+
+			wnaf[bit] = word;
+			lastSetBit = bit;
+			bit += numBits;
+		}
+
+		return lastSetBit + 1;
+	}
+
+	// Adds the odd multiple of the wNAF digit given from the Jacobian table given to 'r', negating it if needed.
+	inline void AddTableEntry(JacobianPoint& r, const JacobianPoint* table, int digit, bool negate)
+	{
+		JacobianPoint entry = table[(std::abs(digit) - 1) / 2];
+		if ((digit < 0) != negate)
+			FieldNegate(entry.y, entry.y);
+
+		PointAdd(r, r, entry);
+	}
+
+	// Adds the odd multiple of the wNAF digit given from the affine table given to 'r', negating it if needed.
+	inline void AddTableEntry(JacobianPoint& r, const AffinePoint* table, int digit)
+	{
+		AffinePoint entry = table[(std::abs(digit) - 1) / 2];
+		if (digit < 0)
+			FieldNegate(entry.y, entry.y);
+
+		PointAddAffine(r, r, entry);
+	}
+
+	// Sets 'r' to u1 * G + u2 * Q, this is variable-time and must only be used with public data.
+	void MultiplyDouble(JacobianPoint& r, const Scalar& u1, const AffinePoint& publicKey, const Scalar& u2)
+	{
+		const GeneratorTables& tables = GetGeneratorTables();
+
+		// Split u2 with the endomorphism, lambda * Q is just Q with its x-coordinate multiplied by beta
+		Scalar k1, k2;
+		ScalarSplitLambda(k1, k2, u2);
+		const bool negateK1 = ScalarMakeShort(k1), negateK2 = ScalarMakeShort(k2);
+
+		JacobianPoint publicKeyMultiples[publicKeyTableSize], publicKeyLambdaMultiples[publicKeyTableSize];
+		GetOddMultiples(publicKeyMultiples, publicKeyTableSize, ToJacobian(publicKey));
+
+		for (size_t i = 0; i < publicKeyTableSize; i++)
+		{
+			publicKeyLambdaMultiples[i] = publicKeyMultiples[i];
+			FieldMultiply(publicKeyLambdaMultiples[i].x, publicKeyLambdaMultiples[i].x, fieldBeta);
+		}
+
+		// Split u1 into its low and high 128 bits, which are multiplied with G and 2^128 * G
+		const Scalar u1Low = { { u1.n[0], u1.n[1], 0, 0 } }, u1High = { { u1.n[2], u1.n[3], 0, 0 } };
+
+		int wnafK1[wnafLength], wnafK2[wnafLength], wnafLow[wnafLength], wnafHigh[wnafLength];
+		const int numDigits = std::max({ GetWNAF(wnafK1, k1, publicKeyWindow), GetWNAF(wnafK2, k2, publicKeyWindow),
+			GetWNAF(wnafLow, u1Low, generatorWindow), GetWNAF(wnafHigh, u1High, generatorWindow) });
+
+		// Strauss' method, the multiples of every scalar are added in as the shared doubling chain passes their digits
+		r.infinity = true;
+		for (int i = numDigits - 1; i >= 0; i--)
+		{
+			PointDouble(r, r);
+
+			if (wnafK1[i])
+				AddTableEntry(r, publicKeyMultiples, wnafK1[i], negateK1);
+			if (wnafK2[i])
+				AddTableEntry(r, publicKeyLambdaMultiples, wnafK2[i], negateK2);
+			if (wnafLow[i])
+				AddTableEntry(r, tables.oddMultiples, wnafLow[i]);
+			if (wnafHigh[i])
+				AddTableEntry(r, tables.oddMultiplesHigh, wnafHigh[i]);
+		}
+	}
+
+	// Sets 'r' to k * G in constant time, every comb entry is read for every tooth so the memory access pattern doesn't
+	// depend on k either.
+	void MultiplyGenerator(ProjectivePoint& r, const Scalar& k)
+	{
+		const GeneratorTables& tables = GetGeneratorTables();
+		r = { fieldZero, fieldOne, fieldZero };
+
+		for (size_t i = 0; i < combTeeth; i++)
+		{
+			const uint64_t index = GetBits(k.n, i * 4, 4);
+
+			ProjectivePoint entry = { fieldZero, fieldZero, fieldZero };
+			for (uint64_t j = 0; j < combEntries; j++)
+			{
+				const uint64_t mask = GetMask(((j ^ index) - 1) >> 63);
+				FieldSelect(entry.x, tables.comb[i][j].x, mask);
+				FieldSelect(entry.y, tables.comb[i][j].y, mask);
+				FieldSelect(entry.z, tables.comb[i][j].z, mask);
+			}
+
+			PointAddComplete(r, r, entry);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DER encoding
+
+	// Reads a DER encoded integer into a 32-byte big-endian buffer, only the minimal encoding of a positive integer that
+	// fits in 32 bytes is accepted (the same as OpenSSL).
+	bool ParseDERInteger(const uint8_t*& data, const uint8_t* end, uint8_t(&output)[32])
+	{
+		if (end - data < 2 || data[0] != 0x02)
+			return false;
+
+		size_t length = data[1];
+		data += 2;
+
+		if (length == 0 || length > 33 || (size_t)(end - data) < length)
+			return false;
+
+		// Negative numbers and needless leading zeros aren't allowed
+		if ((data[0] & 0x80) || (length > 1 && data[0] == 0 && !(data[1] & 0x80)))
+			return false;
+
+		if (data[0] == 0)
+		{
+			data++;
+			length--;
+		}
+
+		if (length > 32)
+			return false;
+
+		std::fill(std::begin(output), std::end(output), 0);
+		std::copy(data, data + length, output + (32 - length));
+		data += length;
+
+		return true;
+	}
+
+	// Reads a DER encoded signiture, FALSE is returned if it isn't strictly encoded or r or s isn't in the range [1, n).
+	bool ParseDERSigniture(Scalar& r, Scalar& s, const uint8_t* signiture, size_t signitureLength)
+	{
+		if (signitureLength < 8 || signitureLength > ECDSA_MAX_SIGNITURE_LENGTH || signiture[0] != 0x30 ||
+			signiture[1] != signitureLength - 2)
+			return false;
+
+		const uint8_t* data = signiture + 2;
+		const uint8_t* end = signiture + signitureLength;
+		uint8_t rBytes[32], sBytes[32];
+
+		if (!ParseDERInteger(data, end, rBytes) || !ParseDERInteger(data, end, sBytes) || data != end)
+			return false;
+
+		return !ScalarSetBytes(r, rBytes) && !ScalarSetBytes(s, sBytes) && !ScalarIsZero(r) && !ScalarIsZero(s);
+	}
+
+	// Writes the DER encoding of the 32-byte big-endian integer given, returns the number of bytes written.
+	size_t EncodeDERInteger(uint8_t* output, const uint8_t(&value)[32])
+	{
+		size_t start = 0;
+		while (start < 31 && value[start] == 0)
+			start++;
+
+		const bool padded = value[start] & 0x80;
+		const size_t length = 32 - start + padded;
+
+		output[0] = 0x02;
+		output[1] = (uint8_t)length;
+		output[2] = 0;
+		std::copy(value + start, value + 32, output + 2 + padded);
+
+		return 2 + length;
+	}
+
+	size_t EncodeDERSigniture(uint8_t(&output)[ECDSA_MAX_SIGNITURE_LENGTH], const Scalar& r, const Scalar& s)
+	{
+		uint8_t rBytes[32], sBytes[32];
+		ScalarGetBytes(rBytes, r);
+		ScalarGetBytes(sBytes, s);
+
+		size_t length = 2;
+		length += EncodeDERInteger(output + length, rBytes);
+		length += EncodeDERInteger(output + length, sBytes);
+
+		output[0] = 0x30;
+		output[1] = (uint8_t)(length - 2);
+
+		return length;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Compact encoding
+
+	// Reads a compact signiture (r followed by s, both 32-byte big-endian), FALSE is returned if r or s isn't in the range
+	// [1, n) or s isn't low.
+	bool ParseCompactSigniture(Scalar& r, Scalar& s, const uint8_t* signiture)
+	{
+		return !ScalarSetBytes(r, signiture) && !ScalarSetBytes(s, signiture + 32) && !ScalarIsZero(r) &&
+			!ScalarIsZero(s) && !ScalarIsHigh(s);
+	}
+
+	void EncodeCompactSigniture(uint8_t* output, const Scalar& r, const Scalar& s)
+	{
+		ScalarGetBytes(output, r);
+		ScalarGetBytes(output + 32, s);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Deterministic nonces (RFC 6979)
+
+	// A piece of the data given to ComputeHMAC().
+	struct DataPiece
+	{
+		const uint8_t* data;
+		size_t length;
+	};
+
+	// Writes the HMAC-SHA256 of the pieces of data given (concatenated) with the 32-byte key given into 'output'.
+	void ComputeHMAC(uint8_t(&output)[32], const uint8_t(&key)[32], std::initializer_list<DataPiece> pieces)
+	{
+		uint8_t paddedKey[SHA_256_BLOCK_LENGTH];
+		Volt::SHA256Digest innerDigest;
+		Volt::SHA256Hasher hasher;
+
+		for (size_t i = 0; i < SHA_256_BLOCK_LENGTH; i++)
+			paddedKey[i] = (i < 32 ? key[i] : 0) ^ 0x36;
+
+		hasher.Update(paddedKey, sizeof(paddedKey));
+		for (const DataPiece& piece : pieces)
+			hasher.Update(piece.data, piece.length);
+		hasher.Finalize(innerDigest);
+
+		for (size_t i = 0; i < SHA_256_BLOCK_LENGTH; i++)
+			paddedKey[i] = (i < 32 ? key[i] : 0) ^ 0x5C;
+
+		Volt::SHA256Digest outerDigest;
+		hasher.Update(paddedKey, sizeof(paddedKey));
+		hasher.Update(innerDigest.data(), innerDigest.size());
+		hasher.Finalize(outerDigest);
+
+		std::copy(outerDigest.begin(), outerDigest.end(), output);
+
+		OPENSSL_cleanse(paddedKey, sizeof(paddedKey));
+		OPENSSL_cleanse(innerDigest.data(), innerDigest.size());
+		OPENSSL_cleanse(outerDigest.data(), outerDigest.size());
+	}
+
+	// Generates the nonces for signing a digest with a private key, as the HMAC-DRBG from RFC 6979 section 3.2.
+	class NonceGenerator
+	{
+	private:
+		uint8_t key[32], value[32];
+	public:
+		NonceGenerator(const uint8_t* privateKey, const uint8_t* digest)
+		{
+			std::fill(std::begin(this->value), std::end(this->value), 0x01);
+			std::fill(std::begin(this->key), std::end(this->key), 0x00);
+
+			for (const uint8_t separator : { 0x00, 0x01 })
+			{
+				ComputeHMAC(this->key, this->key, { { this->value, 32 }, { &separator, 1 }, { privateKey, 32 },
+					{ digest, 32 } });
+				ComputeHMAC(this->value, this->key, { { this->value, 32 } });
+			}
+		}
+
+		~NonceGenerator()
+		{
+			OPENSSL_cleanse(this->key, sizeof(this->key));
+			OPENSSL_cleanse(this->value, sizeof(this->value));
+		}
+
+		// Sets 'nonce' to the next nonce, which is in the range [1, n).
+		void Generate(Scalar& nonce)
+		{
+			while (true)
+			{
+				ComputeHMAC(this->value, this->key, { { this->value, 32 } });
+				if (!ScalarSetBytes(nonce, this->value) && !ScalarIsZero(nonce))
+					break;
+
+				const uint8_t separator = 0x00;
+				ComputeHMAC(this->key, this->key, { { this->value, 32 }, { &separator, 1 } });
+				ComputeHMAC(this->value, this->key, { { this->value, 32 } });
+			}
+
+			// Step the generator, so a retried signiture gets a different nonce
+			const uint8_t separator = 0x00;
+			ComputeHMAC(this->key, this->key, { { this->value, 32 }, { &separator, 1 } });
+			ComputeHMAC(this->value, this->key, { { this->value, 32 } });
+		}
+	};
+
+	// Reads the private key given, FALSE is returned if it isn't in the range [1, n).
+	bool ParsePrivateKey(Scalar& r, const uint8_t* privateKey)
+	{
+		return !ScalarSetBytes(r, privateKey) && !ScalarIsZero(r);
+	}
+
+	// Signs the 32-byte digest given with the private key given, FALSE is returned if the private key isn't valid.
+	bool SignDigest(Scalar& r, Scalar& s, const uint8_t* digest, const uint8_t* privateKey)
+	{
+		Scalar secret;
+		if (!ParsePrivateKey(secret, privateKey))
+			return false;
+
+		// The digest is reduced modulo n, and the reduced digest is what's given to the nonce generator
+		Scalar message;
+		uint8_t messageBytes[32];
+		ScalarSetBytes(message, digest);
+		ScalarGetBytes(messageBytes, message);
+
+		NonceGenerator nonceGenerator(privateKey, messageBytes);
+		Scalar nonce;
+
+		do
+		{
+			nonceGenerator.Generate(nonce);
+
+			// r is the x-coordinate of k * G reduced modulo n
+			ProjectivePoint noncePoint;
+			MultiplyGenerator(noncePoint, nonce);
+
+			FieldElement zInverse, x;
+			FieldInverse(zInverse, noncePoint.z);
+			FieldMultiply(x, noncePoint.x, zInverse);
+
+			uint8_t xBytes[32];
+			FieldGetBytes(xBytes, x);
+			ScalarSetBytes(r, xBytes);
+
+			// s = k^-1 * (e + r * d)
+			Scalar nonceInverse;
+			ScalarInverse(nonceInverse, nonce);
+			ScalarMultiply(s, r, secret);
+			ScalarAdd(s, s, message);
+			ScalarMultiply(s, s, nonceInverse);
+
+			OPENSSL_cleanse(&nonceInverse, sizeof(nonceInverse));
+		} while (ScalarIsZero(r) || ScalarIsZero(s));
+
+		OPENSSL_cleanse(&secret, sizeof(secret));
+		OPENSSL_cleanse(&nonce, sizeof(nonce));
+
+		return true;
+	}
+
+	// Returns TRUE if (r, s) is a valid signiture of the 32-byte digest given for the public key given.
+	bool VerifyDigest(const uint8_t* digest, const AffinePoint& publicKeyPoint, const Scalar& r, const Scalar& s)
+	{
+		// u1 = e * s^-1 and u2 = r * s^-1, the signiture is valid if the x-coordinate of u1 * G + u2 * Q is r (mod n)
+		Scalar message, sInverse, u1, u2;
+		ScalarSetBytes(message, digest);
+		ScalarInverse(sInverse, s);
+		ScalarMultiply(u1, message, sInverse);
+		ScalarMultiply(u2, r, sInverse);
+
+		JacobianPoint result;
+		MultiplyDouble(result, u1, publicKeyPoint, u2);
+
+		if (result.infinity)
+			return false;
+
+		// Compare in Jacobian coordinates to avoid an inversion, x = X / Z^2 so x = r is X = r * Z^2. Since p < 2n, the
+		// x-coordinate can also be r + n when that's still less than p
+		FieldElement rField, zz, expected;
+		FieldSquare(zz, result.z);
+
+		uint8_t rBytes[32];
+		ScalarGetBytes(rBytes, r);
+		FieldSetBytes(rField, rBytes);
+
+		FieldMultiply(expected, rField, zz);
+		if (FieldEquals(expected, result.x))
+			return true;
+
+		Scalar rPlusOrder;
+		uint64_t carry = 0;
+		for (size_t i = 0; i < 4; i++)
+			rPlusOrder.n[i] = AddWithCarry(r.n[i], scalarOrder.n[i], carry);
+
+		ScalarGetBytes(rBytes, rPlusOrder);
+		if (!carry && FieldSetBytes(rField, rBytes))
+		{
+			FieldMultiply(expected, rField, zz);
+			if (FieldEquals(expected, result.x))
+				return true;
+		}
+
+		return false;
+	}
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ErrorCode SignSecp256k1Digest(const uint8_t* digest, const uint8_t* privateKey, uint8_t* signitureOutput,
+		size_t& signitureLength)
+	{
+		Scalar r, s;
+		if (!SignDigest(r, s, digest, privateKey))
+			return ErrorID::ECDSA_KEY_PAIR_ERROR;
+
+		uint8_t encoded[ECDSA_MAX_SIGNITURE_LENGTH];
+		const size_t encodedLength = EncodeDERSigniture(encoded, r, s);
+
+		if (signitureLength < encodedLength)
+			return ErrorID::DIGEST_OPERATION_FAILURE;
+
+		std::copy(encoded, encoded + encodedLength, signitureOutput);
+		signitureLength = encodedLength;
+
+		return ErrorID::NONE;
+	}
+
+	ErrorCode SignSecp256k1DigestCompact(const uint8_t* digest, const uint8_t* privateKey, uint8_t* signitureOutput)
+	{
+		Scalar r, s;
+		if (!SignDigest(r, s, digest, privateKey))
+			return ErrorID::ECDSA_KEY_PAIR_ERROR;
+
+		// (r, n - s) is just as valid as (r, s), so only the low one is used
+		Scalar negatedS;
+		ScalarNegate(negatedS, s);
+		ScalarSelect(s, negatedS, GetMask(ScalarIsHigh(s)));
+
+		EncodeCompactSigniture(signitureOutput, r, s);
+		return ErrorID::NONE;
+	}
+
+	ErrorCode VerifySecp256k1Digest(const uint8_t* digest, const uint8_t* publicKey, size_t publicKeyLength,
+		const uint8_t* signiture, size_t signitureLength)
+	{
+		AffinePoint publicKeyPoint;
+		if (!ParsePublicKey(publicKeyPoint, publicKey, publicKeyLength))
+			return ErrorID::ECDSA_PUBLIC_KEY_INVALID;
+
+		Scalar r, s;
+		if (!ParseDERSigniture(r, s, signiture, signitureLength) || !VerifyDigest(digest, publicKeyPoint, r, s))
+			return ErrorID::SIGNITURE_INVALID;
+
+		return ErrorID::NONE;
+	}
+
+	ErrorCode VerifySecp256k1DigestCompact(const uint8_t* digest, const uint8_t* publicKey, size_t publicKeyLength,
+		const uint8_t* signiture)
+	{
+		AffinePoint publicKeyPoint;
+		if (!ParsePublicKey(publicKeyPoint, publicKey, publicKeyLength))
+			return ErrorID::ECDSA_PUBLIC_KEY_INVALID;
+
+		Scalar r, s;
+		if (!ParseCompactSigniture(r, s, signiture) || !VerifyDigest(digest, publicKeyPoint, r, s))
+			return ErrorID::SIGNITURE_INVALID;
+
+		return ErrorID::NONE;
+	}
+
+	ErrorCode GetSecp256k1PublicKey(const uint8_t* privateKey,
+		uint8_t(&publicKeyOutput)[SECP256K1_COMPRESSED_PUBLIC_KEY_LENGTH])
+	{
+		Scalar secret;
+		if (!ParsePrivateKey(secret, privateKey))
+			return ErrorID::ECDSA_KEY_PAIR_ERROR;
+
+		ProjectivePoint publicKey;
+		MultiplyGenerator(publicKey, secret);
+		OPENSSL_cleanse(&secret, sizeof(secret));
+
+		FieldElement zInverse, x, y;
+		FieldInverse(zInverse, publicKey.z);
+		FieldMultiply(x, publicKey.x, zInverse);
+		FieldMultiply(y, publicKey.y, zInverse);
+
+		publicKeyOutput[0] = FieldIsOdd(y) ? 0x03 : 0x02;
+		FieldGetBytes(publicKeyOutput + 1, x);
+
+		return ErrorID::NONE;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,61 @@
+#ifndef VIDIBOLT_SECP256K1_H
+#define VIDIBOLT_SECP256K1_H
+
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+
+// The lengths of the raw secp256k1 keys used by the native backend.
+#define SECP256K1_PRIVATE_KEY_LENGTH 32
+#define SECP256K1_COMPRESSED_PUBLIC_KEY_LENGTH 33
+#define SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH 65
+
+// The length of a compact signiture, which is r followed by s (both 32-byte big-endian).
+#define SECP256K1_COMPACT_SIGNITURE_LENGTH 64
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The native secp256k1 backend, which is an in-tree implementation of ECDSA over secp256k1 that doesn't go through
+	// OpenSSL's generic EC code.
+	//
+	// Verification uses the GLV endomorphism to split the public key scalar into two 128-bit halves, and the generator
+	// scalar is split in half too and multiplied with precomputed tables of odd multiples of G and 2^128*G. All four
+	// scalars are then multiplied at once using wNAF (Strauss' method), so only ~128 point doublings are needed.
+	//
+	// Signing uses a deterministic nonce (RFC 6979) and is constant-time: the nonce is multiplied with a precomputed comb
+	// table of G using complete addition formulas and constant-time table lookups, and the scalar inverses are done via
+	// fixed exponentiation. The signitures are either DER encoded, the same as OpenSSL's, or compact. Compact signitures are
+	// always low-S (s <= (n - 1) / 2), so every signiture has exactly one valid compact encoding.
+
+	// Signs the 32-byte digest given with the 32-byte big-endian private key given.
+	// 'signitureLength' must hold the size of the 'signitureOutput' buffer, it's set to the length of the signiture.
+	// An error code is returned if the private key isn't valid or the buffer is too small.
+	extern VOLT_API ErrorCode SignSecp256k1Digest(const uint8_t* digest, const uint8_t* privateKey,
+		uint8_t* signitureOutput, size_t& signitureLength);
+
+	// Signs the 32-byte digest given with the 32-byte big-endian private key given, the 64-byte low-S compact signiture is
+	// written into 'signitureOutput'. An error code is returned if the private key isn't valid.
+	extern VOLT_API ErrorCode SignSecp256k1DigestCompact(const uint8_t* digest, const uint8_t* privateKey,
+		uint8_t* signitureOutput);
+
+	// Verifies the DER encoded signiture of the 32-byte digest given, the public key can be compressed (33 bytes) or
+	// uncompressed (65 bytes). Returns 'ErrorID::SIGNITURE_INVALID' if the signiture isn't valid, or
+	// 'ErrorID::ECDSA_PUBLIC_KEY_INVALID' if the public key isn't a valid secp256k1 point.
+	extern VOLT_API ErrorCode VerifySecp256k1Digest(const uint8_t* digest, const uint8_t* publicKey, size_t publicKeyLength,
+		const uint8_t* signiture, size_t signitureLength);
+
+	// Same as the function above, except the signiture is the 64-byte compact encoding. Signitures which aren't low-S are
+	// rejected with 'ErrorID::SIGNITURE_INVALID'.
+	extern VOLT_API ErrorCode VerifySecp256k1DigestCompact(const uint8_t* digest, const uint8_t* publicKey,
+		size_t publicKeyLength, const uint8_t* signiture);
+
+	// Writes the compressed public key of the 32-byte big-endian private key given into 'publicKeyOutput'.
+	// An error code is returned if the private key isn't valid.
+	extern VOLT_API ErrorCode GetSecp256k1PublicKey(const uint8_t* privateKey,
+		uint8_t(&publicKeyOutput)[SECP256K1_COMPRESSED_PUBLIC_KEY_LENGTH]);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -1,138 +1,316 @@
 #include <crypto/sha256.h>
-#include <openssl/evp.h>
+#include <crypto/sha256_native.h>
+#include <crypto/crypto_context.h>
+#include <crypto/cpu_features.h>
+#include <openssl/crypto.h>
+#include <iterator>
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+	// The SHA256 backend used for generating digests.
+	std::atomic<Volt::SHA256Backend> selectedBackend = Volt::GetBestSHA256Backend();
+
+	// Returns the in-tree backend used for midstate operations, which is the selected backend unless it's OpenSSL. In
+	// that case SHA-NI is used if the CPU supports it, else the scalar backend is used.
+	Volt::SHA256Backend GetNativeBackend()
+	{
+		static const Volt::SHA256Backend bestNativeBackend = Volt::IsSHA256BackendSupported(Volt::SHA256Backend::SHA_NI) ?
+			Volt::SHA256Backend::SHA_NI : Volt::SHA256Backend::SCALAR;
+
+		const Volt::SHA256Backend backend = selectedBackend.load(std::memory_order_relaxed);
+		return backend == Volt::SHA256Backend::OPENSSL ? bestNativeBackend : backend;
+	}
+}
 
 namespace Volt
 {
-	ErrorCode GetSHA256Digest(const std::vector<uint8_t>& message, std::vector<uint8_t>& digestOutput)
+	SHA256Backend GetBestSHA256Backend()
 	{
-		// Make sure the message data array isn't empty
-		if (message.empty())
-			return ErrorID::MESSAGE_EMPTY;
+		// Without the SHA extensions OpenSSL's assembly is faster than the scalar in-tree backend
+		static const SHA256Backend bestBackend = IsSHA256BackendSupported(SHA256Backend::SHA_NI) ? SHA256Backend::SHA_NI :
+			SHA256Backend::OPENSSL;
 
-		EVP_MD_CTX* digestCtx = nullptr;
-		EVP_MD* digestImpl = nullptr;
+		return bestBackend;
+	}
 
-		// Initialize the digest context, fetch the SHA256 implementation
-		// then initialize the digest operation
-		digestCtx = EVP_MD_CTX_new();
-		if (!digestCtx)
-			return ErrorID::CONTEXT_GENERATION_FAILURE;
+	bool IsSHA256BackendSupported(SHA256Backend backend)
+	{
+		switch (backend)
+		{
+		case SHA256Backend::OPENSSL:
+		case SHA256Backend::SCALAR:
+			return true;
+		case SHA256Backend::SHA_NI:
+			return IsCPUFeatureSupported(CPUFeature::SHA) && IsCPUFeatureSupported(CPUFeature::SSE41);
+		}
+
+		return false;
+	}
 
-		digestImpl = EVP_MD_fetch(nullptr, "SHA256", nullptr);
-		if (!digestImpl)
-			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+	SHA256Backend GetSHA256Backend()
+	{
+		return selectedBackend.load(std::memory_order_relaxed);
+	}
 
-		if (EVP_DigestInit_ex(digestCtx, digestImpl, nullptr) <= 0)
-			return ErrorID::OPERATION_INIT_FAILURE;
+	ErrorCode SetSHA256Backend(SHA256Backend backend)
+	{
+		if (!IsSHA256BackendSupported(backend))
+			return ErrorID::SHA256_BACKEND_NOT_SUPPORTED;
 
-		// Give the digest operation the message data passed and get the result
-		if (EVP_DigestUpdate(digestCtx, message.data(), message.size() * sizeof(uint8_t)) <= 0)
-			return ErrorID::DIGEST_UPDATE_FAILURE;
+		selectedBackend.store(backend, std::memory_order_relaxed);
+		return ErrorID::NONE;
+	}
 
-		std::vector<uint8_t> digest;
-		digest.resize(EVP_MD_get_size(digestImpl), '0');
+	ErrorCode GetSHA256Digest(const std::vector<uint8_t>& message, std::vector<uint8_t>& digestOutput)
+	{
+		SHA256Digest digest;
 
-		if (EVP_DigestFinal_ex(digestCtx, digest.data(), nullptr) <= 0)
-			return ErrorID::DIGEST_OPERATION_FAILURE;
+		ErrorCode error = Volt::GetSHA256Digest(message.data(), message.size(), digest);
+		if (error)
+			return error;
 
-		// Free allocated resources
-		EVP_MD_CTX_free(digestCtx);
-		EVP_MD_free(digestImpl);
+		digestOutput.assign(digest.begin(), digest.end());
+		return ErrorID::NONE;
+	}
+
+	ErrorCode GetSHA256Digest(const uint8_t* message, size_t messageLength, SHA256Digest& digestOutput)
+	{
+		// Make sure the message data array isn't empty
+		if (messageLength == 0)
+			return ErrorID::MESSAGE_EMPTY;
+
+		const SHA256Backend backend = selectedBackend.load(std::memory_order_relaxed);
+		if (backend == SHA256Backend::OPENSSL)
+			return Volt::GetThreadCryptoContext().Digest(message, messageLength, digestOutput.data());
+
+		uint32_t state[8];
+		std::copy(std::begin(SHA_256_INITIAL_STATE), std::end(SHA_256_INITIAL_STATE), state);
+		Volt::FinalizeSHA256Digest(backend, state, 0, message, messageLength, digestOutput.data());
 
-		digestOutput = digest;
 		return ErrorID::NONE;
 	}
 
 	ErrorCode GetSignedSHA256Digest(const std::vector<uint8_t>& message, const ECKeyPair& key,
 		std::vector<uint8_t>& signitureDigestOutput)
+	{
+		SignitureBuffer signiture;
+
+		ErrorCode error = Volt::GetSignedSHA256Digest(message.data(), message.size(), key, signiture);
+		if (error)
+			return error;
+
+		signitureDigestOutput.assign(signiture.data.begin(), signiture.data.begin() + signiture.length);
+		return ErrorID::NONE;
+	}
+
+	ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+		SignitureBuffer& signitureOutput)
 	{
 		// Make sure a private key is assigned to the key pair given
 		if (!key.HasPrivateKey())
 			return ErrorID::ECDSA_PRIVATE_KEY_REQUIRED;
 
 		// Make sure the message data array isn't empty
-		if (message.empty())
+		if (messageLength == 0)
 			return ErrorID::MESSAGE_EMPTY;
 
-		EVP_MD_CTX* digestSignCtx = nullptr;
-		EVP_MD* digestImpl = nullptr;
+		signitureOutput.length = signitureOutput.data.size();
+
+		if (Volt::GetECDSABackend() == ECDSABackend::NATIVE)
+		{
+			uint8_t privateKey[SECP256K1_PRIVATE_KEY_LENGTH];
+			if (!key.GetPrivateKeyBytes(privateKey))
+				return ErrorID::ECDSA_PRIVATE_KEY_REQUIRED;
 
-		// Initialize the signiture digest context, fetch the SHA256 implementation
-		// then initialize the signiture digest operation
-		digestSignCtx = EVP_MD_CTX_new();
-		if (!digestSignCtx)
-			return ErrorID::CONTEXT_GENERATION_FAILURE;
+			SHA256Digest digest;
+			Volt::GetSHA256Digest(message, messageLength, digest);
 
-		digestImpl = EVP_MD_fetch(nullptr, "SHA256", nullptr);
-		if (!digestImpl)
-			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+			ErrorCode error = Volt::SignSecp256k1Digest(digest.data(), privateKey, signitureOutput.data.data(),
+				signitureOutput.length);
 
-		if (EVP_DigestSignInit(digestSignCtx, nullptr, digestImpl, nullptr, key.keyPair) <= 0)
-			return ErrorID::OPERATION_INIT_FAILURE;
+			OPENSSL_cleanse(privateKey, sizeof(privateKey));
+			return error;
+		}
+
+		return Volt::GetThreadCryptoContext().SignDigest(message, messageLength, key.keyPair, signitureOutput.data.data(),
+			signitureOutput.length);
+	}
+
+	ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+		CompactSigniture& signitureOutput)
+	{
+		// Make sure a private key is assigned to the key pair given
+		if (!key.HasPrivateKey())
+			return ErrorID::ECDSA_PRIVATE_KEY_REQUIRED;
 
-		// Give the signiture digest operation themessage data passed and get the length of the signiture
-		size_t signitureLength = 0;
+		// Make sure the message data array isn't empty
+		if (messageLength == 0)
+			return ErrorID::MESSAGE_EMPTY;
 
-		if (EVP_DigestSignUpdate(digestSignCtx, message.data(), message.size() * sizeof(uint8_t)) <= 0)
-			return ErrorID::DIGEST_UPDATE_FAILURE;
+		if (Volt::GetECDSABackend() == ECDSABackend::NATIVE)
+		{
+			uint8_t privateKey[SECP256K1_PRIVATE_KEY_LENGTH];
+			if (!key.GetPrivateKeyBytes(privateKey))
+				return ErrorID::ECDSA_PRIVATE_KEY_REQUIRED;
 
-		if (EVP_DigestSignFinal(digestSignCtx, nullptr, &signitureLength) <= 0)
-			return ErrorID::DIGEST_OPERATION_FAILURE;
+			SHA256Digest digest;
+			Volt::GetSHA256Digest(message, messageLength, digest);
 
-		// Get the resulting signed digest
-		std::vector<uint8_t> signedDigest;
-		signedDigest.resize(signitureLength, '0');
+			ErrorCode error = Volt::SignSecp256k1DigestCompact(digest.data(), privateKey, signitureOutput.data());
 
-		if (EVP_DigestSignFinal(digestSignCtx, signedDigest.data(), &signitureLength) <= 0)
-			return ErrorID::DIGEST_OPERATION_FAILURE;
+			OPENSSL_cleanse(privateKey, sizeof(privateKey));
+			return error;
+		}
 
-		signedDigest.resize(signitureLength);
+		SignitureBuffer signiture;
+		signiture.length = signiture.data.size();
 
-		// Free allocated resources
-		EVP_MD_CTX_free(digestSignCtx);
-		EVP_MD_free(digestImpl);
+		ErrorCode error = Volt::GetThreadCryptoContext().SignDigest(message, messageLength, key.keyPair,
+			signiture.data.data(), signiture.length);
+		if (error)
+			return error;
 
-		signitureDigestOutput = signedDigest;
-		return ErrorID::NONE;
+		return Volt::ConvertDERToCompactSigniture(signiture.data.data(), signiture.length, signitureOutput);
 	}
 
 	ErrorCode VerifySHA256Digest(const std::vector<uint8_t>& originalMessage, const ECKeyPair& key,
 		const std::vector<uint8_t>& signiture)
+	{
+		return Volt::VerifySHA256Digest(originalMessage.data(), originalMessage.size(), key, signiture.data(),
+			signiture.size());
+	}
+
+	ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength, const ECKeyPair& key,
+		const uint8_t* signiture, size_t signitureLength)
+	{
+		// Make sure a public key is assigned to the key pair given
+		if (!key.HasPublicKey())
+			return ErrorID::ECDSA_PUBLIC_KEY_REQUIRED;
+
+		if (Volt::GetECDSABackend() == ECDSABackend::NATIVE)
+		{
+			uint8_t publicKey[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH];
+			if (!key.GetPublicKeyBytes(publicKey))
+				return ErrorID::ECDSA_PUBLIC_KEY_REQUIRED;
+
+			SHA256Digest digest;
+			Volt::GetSHA256Digest(originalMessage, messageLength, digest);
+
+			return Volt::VerifySecp256k1Digest(digest.data(), publicKey, sizeof(publicKey), signiture, signitureLength);
+		}
+
+		return Volt::GetThreadCryptoContext().VerifyDigest(originalMessage, messageLength, key.keyPair, signiture,
+			signitureLength);
+	}
+
+	ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength, const ECKeyPair& key,
+		const CompactSigniture& signiture)
 	{
 		// Make sure a public key is assigned to the key pair given
 		if (!key.HasPublicKey())
 			return ErrorID::ECDSA_PUBLIC_KEY_REQUIRED;
 
-		EVP_MD_CTX* digestSignVerifyCtx = nullptr;
-		EVP_MD* digestImpl = nullptr;
+		if (Volt::GetECDSABackend() == ECDSABackend::NATIVE)
+		{
+			uint8_t publicKey[SECP256K1_UNCOMPRESSED_PUBLIC_KEY_LENGTH];
+			if (!key.GetPublicKeyBytes(publicKey))
+				return ErrorID::ECDSA_PUBLIC_KEY_REQUIRED;
 
-		// Initialize the signiture verification digest context, fetch the SHA256 implementation
-		// then initialize the signiture verification digest operation
-		digestSignVerifyCtx = EVP_MD_CTX_new();
-		if (!digestSignVerifyCtx)
-			return ErrorID::CONTEXT_GENERATION_FAILURE;
+			SHA256Digest digest;
+			Volt::GetSHA256Digest(originalMessage, messageLength, digest);
 
-		digestImpl = EVP_MD_fetch(nullptr, "SHA256", nullptr);
-		if (!digestImpl)
-			return ErrorID::OPERATION_IMPL_FETCH_FAILURE;
+			return Volt::VerifySecp256k1DigestCompact(digest.data(), publicKey, sizeof(publicKey), signiture.data());
+		}
 
-		if (EVP_DigestVerifyInit(digestSignVerifyCtx, nullptr, digestImpl, nullptr, key.keyPair) <= 0)
-			return ErrorID::OPERATION_INIT_FAILURE;
+		SignitureBuffer derSigniture;
+		ErrorCode error = Volt::ConvertCompactSignitureToDER(signiture, derSigniture);
+		if (error)
+			return error;
 
-		// Give the signiture verification digest operation themessage data passed and get the length of the signiture
-		if (EVP_DigestVerifyUpdate(digestSignVerifyCtx, originalMessage.data(), originalMessage.size() * sizeof(uint8_t)) <= 0)
-			return ErrorID::DIGEST_UPDATE_FAILURE;
+		return Volt::GetThreadCryptoContext().VerifyDigest(originalMessage, messageLength, key.keyPair,
+			derSigniture.data.data(), derSigniture.length);
+	}
 
-		int signitureValid = EVP_DigestVerifyFinal(digestSignVerifyCtx, signiture.data(), signiture.size());
-		if (signitureValid < 0)
-			return ErrorID::DIGEST_OPERATION_FAILURE;
-		else if (signitureValid == 0)
-			return ErrorID::SIGNITURE_INVALID;
+	ErrorCode GetSHA256Midstate(const uint8_t* prefix, size_t prefixLength, SHA256Midstate& midstateOutput)
+	{
+		// The midstate can only be taken at the boundary of a 64-byte message block
+		if (prefixLength % SHA_256_BLOCK_LENGTH != 0)
+			return ErrorID::MIDSTATE_PREFIX_LENGTH_INVALID;
 
-		// Free allocated resources
-		EVP_MD_CTX_free(digestSignVerifyCtx);
-		EVP_MD_free(digestImpl);
+		std::copy(std::begin(SHA_256_INITIAL_STATE), std::end(SHA_256_INITIAL_STATE), midstateOutput.state);
+		if (prefixLength > 0)
+			Volt::CompressSHA256Blocks(GetNativeBackend(), midstateOutput.state, prefix, prefixLength / SHA_256_BLOCK_LENGTH);
 
+		midstateOutput.bytesProcessed = prefixLength;
 		return ErrorID::NONE;
 	}
+
+	ErrorCode GetSHA256DigestFromMidstate(const SHA256Midstate& midstate, const uint8_t* tail, size_t tailLength,
+		uint8_t* digestOutput)
+	{
+		// Continue from the state the digest was in after processing the message prefix
+		uint32_t state[8];
+		std::copy(std::begin(midstate.state), std::end(midstate.state), state);
+
+		Volt::FinalizeSHA256Digest(GetNativeBackend(), state, midstate.bytesProcessed, tail, tailLength, digestOutput);
+		return ErrorID::NONE;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SHA256Hasher::SHA256Hasher() :
+		bufferLength(0), bytesProcessed(0)
+	{
+		std::copy(std::begin(SHA_256_INITIAL_STATE), std::end(SHA_256_INITIAL_STATE), this->state);
+	}
+
+	void SHA256Hasher::Update(const uint8_t* data, size_t length)
+	{
+		const SHA256Backend backend = GetNativeBackend();
+
+		// Fill up the partial block left over from the last update first
+		if (this->bufferLength > 0)
+		{
+			const size_t copyLength = std::min(length, SHA_256_BLOCK_LENGTH - this->bufferLength);
+			std::copy_n(data, copyLength, this->buffer + this->bufferLength);
+			this->bufferLength += copyLength;
+			data += copyLength;
+			length -= copyLength;
+
+			if (this->bufferLength < SHA_256_BLOCK_LENGTH)
+				return;
+
+			Volt::CompressSHA256Blocks(backend, this->state, this->buffer, 1);
+			this->bytesProcessed += SHA_256_BLOCK_LENGTH;
+			this->bufferLength = 0;
+		}
+
+		// Process the whole blocks directly from the data given and keep hold of the rest
+		const size_t wholeBlocks = length / SHA_256_BLOCK_LENGTH;
+		if (wholeBlocks > 0)
+		{
+			Volt::CompressSHA256Blocks(backend, this->state, data, wholeBlocks);
+			this->bytesProcessed += wholeBlocks * SHA_256_BLOCK_LENGTH;
+		}
+
+		this->bufferLength = length - wholeBlocks * SHA_256_BLOCK_LENGTH;
+		std::copy_n(data + wholeBlocks * SHA_256_BLOCK_LENGTH, this->bufferLength, this->buffer);
+	}
+
+	void SHA256Hasher::Update(const std::string& str)
+	{
+		this->Update((const uint8_t*)str.data(), str.size());
+	}
+
+	void SHA256Hasher::Finalize(SHA256Digest& digestOutput)
+	{
+		Volt::FinalizeSHA256Digest(GetNativeBackend(), this->state, this->bytesProcessed, this->buffer, this->bufferLength,
+			digestOutput.data());
+
+		*this = SHA256Hasher();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 }
\ No newline at end of file
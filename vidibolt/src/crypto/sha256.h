@@ -2,26 +2,125 @@
 #define VIDIBOLT_SHA256_H
 
 #define SHA_256_DIGEST_LENGTH_HEX 64
+#define SHA_256_DIGEST_LENGTH 32
+#define SHA_256_BLOCK_LENGTH 64
 
 #include <util/data_conversion.h>
 #include <util/error_identifier.h>
 #include <util/volt_api.h>
 #include <crypto/ecdsa.h>
 #include <vector>
+#include <array>
 
 namespace Volt
 {
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The type of a raw SHA256 digest.
+	using SHA256Digest = std::array<uint8_t, SHA_256_DIGEST_LENGTH>;
+
+	// A struct which holds the intermediate state of a SHA256 digest operation after some whole 64-byte blocks of a message
+	// have been processed, this allows the hashing of a common message prefix to be done only once.
+	struct SHA256Midstate
+	{
+		uint32_t state[8];
+		uint64_t bytesProcessed;
+	};
+
+	// An enumeration that represents the implementations which SHA256 digests can be generated with.
+	enum class SHA256Backend : int
+	{
+		OPENSSL, // The generic OpenSSL EVP implementation
+		SCALAR,  // The portable in-tree implementation, supported by every CPU
+		SHA_NI   // The in-tree implementation using the x86 SHA extensions
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the fastest SHA256 backend supported by the CPU, this is detected once at runtime. This is SHA-NI if the CPU
+	// supports it, else OpenSSL.
+	extern VOLT_API SHA256Backend GetBestSHA256Backend();
+
+	// Returns TRUE if the CPU supports the SHA256 backend given, else FALSE is returned.
+	extern VOLT_API bool IsSHA256BackendSupported(SHA256Backend backend);
+
+	// Returns the SHA256 backend currently used for generating digests, this is the best backend unless overridden.
+	extern VOLT_API SHA256Backend GetSHA256Backend();
+
+	// Overrides the SHA256 backend used for generating digests by every thread (e.g. for benchmarking or testing).
+	// Note that midstate and incremental operations always use an in-tree implementation, so they use SHA-NI or the
+	// scalar backend while the OpenSSL backend is selected.
+	// An error code is returned if the backend isn't supported by the CPU.
+	extern VOLT_API ErrorCode SetSHA256Backend(SHA256Backend backend);
+
 	// Returns resulting hash byte data from the SHA256 digest operation.
 	extern VOLT_API ErrorCode GetSHA256Digest(const std::vector<uint8_t>& message, std::vector<uint8_t>& digestOutput);
 
+	// Returns resulting hash byte data from the SHA256 digest operation, no memory is allocated.
+	extern VOLT_API ErrorCode GetSHA256Digest(const uint8_t* message, size_t messageLength, SHA256Digest& digestOutput);
+
 	// Returns resulting signiture byte data from the SHA256 digest signing operation.
 	extern VOLT_API ErrorCode GetSignedSHA256Digest(const std::vector<uint8_t>& message, const ECKeyPair& key,
 		std::vector<uint8_t>& signitureDigestOutput);
 
+	// Returns resulting signiture byte data from the SHA256 digest signing operation, written into a fixed size buffer.
+	extern VOLT_API ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+		SignitureBuffer& signitureOutput);
+
+	// Returns the low-S compact signiture of the SHA256 digest of the message given. The OpenSSL backend's DER signiture is
+	// converted into its compact form, so both backends give signitures which are encoded the same way.
+	extern VOLT_API ErrorCode GetSignedSHA256Digest(const uint8_t* message, size_t messageLength, const ECKeyPair& key,
+		CompactSigniture& signitureOutput);
+
 	// Returns an error code with a value of 'ErrorID::NONE' if the signiture was valid, else other
 	// possible error codes are returned on failure.
 	extern VOLT_API ErrorCode VerifySHA256Digest(const std::vector<uint8_t>& originalMessage, const ECKeyPair& key,
 		const std::vector<uint8_t>& signiture);
+
+	// Returns an error code with a value of 'ErrorID::NONE' if the signiture was valid, else other
+	// possible error codes are returned on failure.
+	extern VOLT_API ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength,
+		const ECKeyPair& key, const uint8_t* signiture, size_t signitureLength);
+
+	// Same as the function above, except the signiture is compact and must be low-S. The native backend verifies it as is,
+	// it's only converted into DER for the OpenSSL backend.
+	extern VOLT_API ErrorCode VerifySHA256Digest(const uint8_t* originalMessage, size_t messageLength,
+		const ECKeyPair& key, const CompactSigniture& signiture);
+
+	// Returns the intermediate SHA256 state after processing the message prefix given, the length of the prefix must be a 
+	// multiple of 64 bytes.
+	extern VOLT_API ErrorCode GetSHA256Midstate(const uint8_t* prefix, size_t prefixLength, SHA256Midstate& midstateOutput);
+
+	// Returns the SHA256 digest of a message made up of the prefix which the midstate was generated from followed by the
+	// tail data given. The 32-byte digest is written into 'digestOutput'.
+	extern VOLT_API ErrorCode GetSHA256DigestFromMidstate(const SHA256Midstate& midstate, const uint8_t* tail, size_t tailLength,
+		uint8_t* digestOutput);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which generates the SHA256 digest of a message given in pieces, so a message made up of several fields
+	// doesn't need to be copied into one buffer before hashing. The state is held inline, so no memory is allocated.
+	class SHA256Hasher
+	{
+	private:
+		uint32_t state[8];
+		uint8_t buffer[SHA_256_BLOCK_LENGTH];
+		size_t bufferLength;
+		uint64_t bytesProcessed;
+	public:
+		VOLT_API SHA256Hasher();
+
+		// Appends the data given to the message being hashed.
+		VOLT_API void Update(const uint8_t* data, size_t length);
+
+		// Appends the characters of the string given to the message being hashed.
+		VOLT_API void Update(const std::string& str);
+
+		// Writes the digest of the message into 'digestOutput', the hasher is reset afterwards so it can be reused.
+		VOLT_API void Finalize(SHA256Digest& digestOutput);
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 }
 
 #endif
@@ -0,0 +1,287 @@
+#include <crypto/sha256_kernel.h>
+#include <crypto/sha256_native.h>
+#include <crypto/cpu_features.h>
+
+#include <algorithm>
+#include <iterator>
+
+#ifdef VOLT_CPU_X86
+	#include <immintrin.h>
+#endif
+
+namespace
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	inline uint32_t RotateRight(uint32_t value, uint32_t amount)
+	{
+		return (value >> amount) | (value << (32 - amount));
+	}
+
+	// Hashes a single nonce, this is the fallback kernel used when no SIMD extensions are supported.
+	void HashNonceScalar(const Volt::NonceKernelInput& input, uint64_t nonce, uint32_t(*digestsOutput)[8])
+	{
+		uint32_t w[64];
+		std::copy(std::begin(input.finalBlock), std::end(input.finalBlock), w);
+		w[input.nonceWordIndex] = (uint32_t)(nonce >> 32);
+		w[input.nonceWordIndex + 1] = (uint32_t)nonce;
+
+		for (uint32_t i = 16; i < 64; i++)
+		{
+			const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = input.midstate[0], b = input.midstate[1], c = input.midstate[2], d = input.midstate[3],
+			e = input.midstate[4], f = input.midstate[5], g = input.midstate[6], h = input.midstate[7];
+
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			const uint32_t t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + ((e & (f ^ g)) ^ g) +
+				Volt::SHA_256_ROUND_CONSTANTS[i] + w[i];
+			const uint32_t t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) | (c & (a | b)));
+
+			h = g; g = f; f = e; e = d + t1;
+			d = c; c = b; b = a; a = t1 + t2;
+		}
+
+		const uint32_t finalState[8] = { a, b, c, d, e, f, g, h };
+		for (uint32_t i = 0; i < 8; i++)
+			digestsOutput[0][i] = input.midstate[i] + finalState[i];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef VOLT_CPU_X86
+	// Hashes 4 consecutive nonces at once using 128-bit vectors.
+	VOLT_TARGET_FEATURES("sse4.1") void HashNonceSSE41(const Volt::NonceKernelInput& input, uint64_t firstNonce,
+		uint32_t(*digestsOutput)[8])
+	{
+		#define ADD(x, y) _mm_add_epi32(x, y)
+		#define XOR(x, y) _mm_xor_si128(x, y)
+		#define ROTR(x, n) _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+
+		// Load the message block with each lane holding a different nonce
+		__m128i w[64];
+		for (uint32_t i = 0; i < 16; i++)
+			w[i] = _mm_set1_epi32((int)input.finalBlock[i]);
+
+		alignas(16) uint32_t nonceHigh[4], nonceLow[4];
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			nonceHigh[lane] = (uint32_t)((firstNonce + lane) >> 32);
+			nonceLow[lane] = (uint32_t)(firstNonce + lane);
+		}
+
+		w[input.nonceWordIndex] = _mm_load_si128((const __m128i*)nonceHigh);
+		w[input.nonceWordIndex + 1] = _mm_load_si128((const __m128i*)nonceLow);
+
+		for (uint32_t i = 16; i < 64; i++)
+		{
+			const __m128i s0 = XOR(XOR(ROTR(w[i - 15], 7), ROTR(w[i - 15], 18)), _mm_srli_epi32(w[i - 15], 3));
+			const __m128i s1 = XOR(XOR(ROTR(w[i - 2], 17), ROTR(w[i - 2], 19)), _mm_srli_epi32(w[i - 2], 10));
+			w[i] = ADD(ADD(w[i - 16], s0), ADD(w[i - 7], s1));
+		}
+
+		__m128i state[8];
+		for (uint32_t i = 0; i < 8; i++)
+			state[i] = _mm_set1_epi32((int)input.midstate[i]);
+
+		__m128i a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			const __m128i ch = XOR(_mm_and_si128(e, XOR(f, g)), g);
+			const __m128i maj = _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(c, _mm_or_si128(a, b)));
+			const __m128i t1 = ADD(ADD(ADD(h, XOR(XOR(ROTR(e, 6), ROTR(e, 11)), ROTR(e, 25))), ADD(ch, w[i])),
+				_mm_set1_epi32((int)Volt::SHA_256_ROUND_CONSTANTS[i]));
+			const __m128i t2 = ADD(XOR(XOR(ROTR(a, 2), ROTR(a, 13)), ROTR(a, 22)), maj);
+
+			h = g; g = f; f = e; e = ADD(d, t1);
+			d = c; c = b; b = a; a = ADD(t1, t2);
+		}
+
+		const __m128i finalState[8] = { a, b, c, d, e, f, g, h };
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			alignas(16) uint32_t lanes[4];
+			_mm_store_si128((__m128i*)lanes, ADD(state[i], finalState[i]));
+
+			for (uint32_t lane = 0; lane < 4; lane++)
+				digestsOutput[lane][i] = lanes[lane];
+		}
+
+		#undef ADD
+		#undef XOR
+		#undef ROTR
+	}
+
+	// Hashes 8 consecutive nonces at once using 256-bit vectors.
+	VOLT_TARGET_FEATURES("avx2") void HashNonceAVX2(const Volt::NonceKernelInput& input, uint64_t firstNonce,
+		uint32_t(*digestsOutput)[8])
+	{
+		#define ADD(x, y) _mm256_add_epi32(x, y)
+		#define XOR(x, y) _mm256_xor_si256(x, y)
+		#define ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+		// Load the message block with each lane holding a different nonce
+		__m256i w[64];
+		for (uint32_t i = 0; i < 16; i++)
+			w[i] = _mm256_set1_epi32((int)input.finalBlock[i]);
+
+		alignas(32) uint32_t nonceHigh[8], nonceLow[8];
+		for (uint32_t lane = 0; lane < 8; lane++)
+		{
+			nonceHigh[lane] = (uint32_t)((firstNonce + lane) >> 32);
+			nonceLow[lane] = (uint32_t)(firstNonce + lane);
+		}
+
+		w[input.nonceWordIndex] = _mm256_load_si256((const __m256i*)nonceHigh);
+		w[input.nonceWordIndex + 1] = _mm256_load_si256((const __m256i*)nonceLow);
+
+		for (uint32_t i = 16; i < 64; i++)
+		{
+			const __m256i s0 = XOR(XOR(ROTR(w[i - 15], 7), ROTR(w[i - 15], 18)), _mm256_srli_epi32(w[i - 15], 3));
+			const __m256i s1 = XOR(XOR(ROTR(w[i - 2], 17), ROTR(w[i - 2], 19)), _mm256_srli_epi32(w[i - 2], 10));
+			w[i] = ADD(ADD(w[i - 16], s0), ADD(w[i - 7], s1));
+		}
+
+		__m256i state[8];
+		for (uint32_t i = 0; i < 8; i++)
+			state[i] = _mm256_set1_epi32((int)input.midstate[i]);
+
+		__m256i a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			const __m256i ch = XOR(_mm256_and_si256(e, XOR(f, g)), g);
+			const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+			const __m256i t1 = ADD(ADD(ADD(h, XOR(XOR(ROTR(e, 6), ROTR(e, 11)), ROTR(e, 25))), ADD(ch, w[i])),
+				_mm256_set1_epi32((int)Volt::SHA_256_ROUND_CONSTANTS[i]));
+			const __m256i t2 = ADD(XOR(XOR(ROTR(a, 2), ROTR(a, 13)), ROTR(a, 22)), maj);
+
+			h = g; g = f; f = e; e = ADD(d, t1);
+			d = c; c = b; b = a; a = ADD(t1, t2);
+		}
+
+		const __m256i finalState[8] = { a, b, c, d, e, f, g, h };
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			alignas(32) uint32_t lanes[8];
+			_mm256_store_si256((__m256i*)lanes, ADD(state[i], finalState[i]));
+
+			for (uint32_t lane = 0; lane < 8; lane++)
+				digestsOutput[lane][i] = lanes[lane];
+		}
+
+		#undef ADD
+		#undef XOR
+		#undef ROTR
+	}
+#endif
+
+	// Returns TRUE if the CPU (and OS) supports the kernel given.
+	bool DetectKernelSupport(Volt::NonceKernel kernel)
+	{
+		switch (kernel)
+		{
+		case Volt::NonceKernel::SCALAR:
+			return true;
+		case Volt::NonceKernel::SSE41:
+			return Volt::IsCPUFeatureSupported(Volt::CPUFeature::SSE41);
+		case Volt::NonceKernel::AVX2:
+			return Volt::IsCPUFeatureSupported(Volt::CPUFeature::AVX2);
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+namespace Volt
+{
+	ErrorCode InitNonceKernelInput(const SHA256Midstate& midstate, const uint8_t* tail, size_t tailLength, size_t nonceOffset,
+		NonceKernelInput& inputOutput)
+	{
+		// The tail, the 0x80 padding byte and the 64-bit message length must all fit into the final message block
+		// The nonce must also lie fully within the tail and be aligned to a word boundary
+		if (tailLength > SHA_256_BLOCK_LENGTH - 9 || nonceOffset % 4 != 0 || nonceOffset + sizeof(uint64_t) > tailLength)
+			return ErrorID::NONCE_KERNEL_INPUT_INVALID;
+
+		// Build the padded final message block
+		uint8_t finalBlock[SHA_256_BLOCK_LENGTH] = {};
+		std::copy(tail, tail + tailLength, finalBlock);
+		finalBlock[tailLength] = 0x80;
+
+		const uint64_t messageBits = (midstate.bytesProcessed + tailLength) * 8;
+		for (size_t i = 0; i < sizeof(uint64_t); i++)
+			finalBlock[SHA_256_BLOCK_LENGTH - 1 - i] = (uint8_t)(messageBits >> (8 * i));
+
+		// Convert the final block into big-endian words
+		for (size_t i = 0; i < 16; i++)
+		{
+			inputOutput.finalBlock[i] = ((uint32_t)finalBlock[i * 4] << 24) | ((uint32_t)finalBlock[i * 4 + 1] << 16) |
+				((uint32_t)finalBlock[i * 4 + 2] << 8) | (uint32_t)finalBlock[i * 4 + 3];
+		}
+
+		std::copy(std::begin(midstate.state), std::end(midstate.state), inputOutput.midstate);
+		inputOutput.nonceWordIndex = (uint32_t)(nonceOffset / 4);
+
+		return ErrorID::NONE;
+	}
+
+	NonceKernel GetBestNonceKernel()
+	{
+		static const NonceKernel bestKernel = DetectKernelSupport(NonceKernel::AVX2) ? NonceKernel::AVX2 :
+			DetectKernelSupport(NonceKernel::SSE41) ? NonceKernel::SSE41 : NonceKernel::SCALAR;
+
+		return bestKernel;
+	}
+
+	bool IsNonceKernelSupported(NonceKernel kernel)
+	{
+		return DetectKernelSupport(kernel);
+	}
+
+	uint32_t GetNonceKernelLaneCount(NonceKernel kernel)
+	{
+		switch (kernel)
+		{
+		case NonceKernel::SSE41:
+			return 4;
+		case NonceKernel::AVX2:
+			return 8;
+		default:
+			return 1;
+		}
+	}
+
+	void HashNonceBatch(NonceKernel kernel, const NonceKernelInput& input, uint64_t firstNonce, uint32_t(*digestsOutput)[8])
+	{
+		switch (kernel)
+		{
+	#ifdef VOLT_CPU_X86
+		case NonceKernel::SSE41:
+			HashNonceSSE41(input, firstNonce, digestsOutput);
+			break;
+		case NonceKernel::AVX2:
+			HashNonceAVX2(input, firstNonce, digestsOutput);
+			break;
+	#endif
+		default:
+			HashNonceScalar(input, firstNonce, digestsOutput);
+			break;
+		}
+	}
+
+	void ConvertDigestWordsToBytes(const uint32_t(&digestWords)[8], uint8_t* digestOutput)
+	{
+		for (size_t i = 0; i < 8; i++)
+		{
+			digestOutput[i * 4] = (uint8_t)(digestWords[i] >> 24);
+			digestOutput[i * 4 + 1] = (uint8_t)(digestWords[i] >> 16);
+			digestOutput[i * 4 + 2] = (uint8_t)(digestWords[i] >> 8);
+			digestOutput[i * 4 + 3] = (uint8_t)digestWords[i];
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef VIDIBOLT_SHA256_KERNEL_H
+#define VIDIBOLT_SHA256_KERNEL_H
+
+#define SHA_256_KERNEL_MAX_LANES 8
+
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+#include <crypto/sha256.h>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// An enumeration that represents the implementations of the nonce search kernel.
+	enum class NonceKernel : int
+	{
+		SCALAR, // Hashes 1 nonce per call, supported by every CPU
+		SSE41,  // Hashes 4 nonces per call, requires SSE4.1 support
+		AVX2    // Hashes 8 nonces per call, requires AVX2 support
+	};
+
+	// A struct which holds everything the nonce search kernels need to hash a message for any nonce, this being the 
+	// midstate of the message prefix and the final padded 64-byte message block containing the nonce.
+	struct NonceKernelInput
+	{
+		uint32_t midstate[8];
+		uint32_t finalBlock[16];
+		uint32_t nonceWordIndex; // Index of the word in the final block holding the upper 32 bits of the nonce
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Initializes the kernel input from the midstate of a message prefix and the tail of the message which follows it.
+	// The tail must fit into a single message block along with the SHA256 padding (55 bytes at most), and the big-endian 
+	// 64-bit nonce located at 'nonceOffset' into the tail must be aligned to 4 bytes.
+	// An error code is returned in the event of a failure occurring.
+	extern VOLT_API ErrorCode InitNonceKernelInput(const SHA256Midstate& midstate, const uint8_t* tail, size_t tailLength,
+		size_t nonceOffset, NonceKernelInput& inputOutput);
+
+	// Returns the fastest nonce search kernel supported by the CPU, this is detected once at runtime.
+	extern VOLT_API NonceKernel GetBestNonceKernel();
+
+	// Returns TRUE if the CPU supports the nonce search kernel given, else FALSE is returned.
+	extern VOLT_API bool IsNonceKernelSupported(NonceKernel kernel);
+
+	// Returns the number of nonces hashed per call by the nonce search kernel given.
+	extern VOLT_API uint32_t GetNonceKernelLaneCount(NonceKernel kernel);
+
+	// Generates the SHA256 digests for consecutive nonces starting at 'firstNonce', one for each lane of the kernel given.
+	// The digest of each lane is written into 'digestsOutput' as 8 words (the first word holding the first 4 bytes of the 
+	// digest), so the output must have room for the lane count of the kernel.
+	// Note that the kernel must be supported by the CPU.
+	extern VOLT_API void HashNonceBatch(NonceKernel kernel, const NonceKernelInput& input, uint64_t firstNonce,
+		uint32_t(*digestsOutput)[8]);
+
+	// Writes the 32-byte digest represented by the digest words given into 'digestOutput'.
+	extern VOLT_API void ConvertDigestWordsToBytes(const uint32_t(&digestWords)[8], uint8_t* digestOutput);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include <crypto/sha256_native.h>
+#include <crypto/cpu_features.h>
+
+#include <algorithm>
+
+#ifdef VOLT_CPU_X86
+	#include <immintrin.h>
+#endif
+
+namespace
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	inline uint32_t RotateRight(uint32_t value, uint32_t amount)
+	{
+		return (value >> amount) | (value << (32 - amount));
+	}
+
+	inline uint32_t LoadBigEndian32(const uint8_t* data)
+	{
+		return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+	}
+
+	// The portable implementation, supported by every CPU.
+	void CompressScalar(uint32_t(&state)[8], const uint8_t* blocks, size_t numBlocks)
+	{
+		for (; numBlocks > 0; numBlocks--, blocks += SHA_256_BLOCK_LENGTH)
+		{
+			uint32_t w[64];
+			for (uint32_t i = 0; i < 16; i++)
+				w[i] = LoadBigEndian32(blocks + i * 4);
+
+			for (uint32_t i = 16; i < 64; i++)
+			{
+				const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+				const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+
+			uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6],
+				h = state[7];
+
+			for (uint32_t i = 0; i < 64; i++)
+			{
+				const uint32_t t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + ((e & (f ^ g)) ^ g) +
+					Volt::SHA_256_ROUND_CONSTANTS[i] + w[i];
+				const uint32_t t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) | (c & (a | b)));
+
+				h = g; g = f; f = e; e = d + t1;
+				d = c; c = b; b = a; a = t1 + t2;
+			}
+
+			state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+			state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef VOLT_CPU_X86
+	// Does 4 rounds using the current message vector, and expands the next and previous vectors of the message schedule.
+	VOLT_TARGET_FEATURES("sha,sse4.1") inline void SHANIQuadRound(__m128i& state0, __m128i& state1, const __m128i& current,
+		__m128i& next, __m128i& previous, uint32_t quad)
+	{
+		__m128i message = _mm_add_epi32(current, _mm_loadu_si128((const __m128i*)&Volt::SHA_256_ROUND_CONSTANTS[quad * 4]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+
+		if (quad >= 3 && quad < 15)
+		{
+			next = _mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4));
+			next = _mm_sha256msg2_epu32(next, current);
+		}
+
+		message = _mm_shuffle_epi32(message, 0x0E);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+
+		if (quad >= 1 && quad < 13)
+			previous = _mm_sha256msg1_epu32(previous, current);
+	}
+
+	// Uses the x86 SHA extensions, each sha256rnds2 instruction does 2 rounds and the message schedule is expanded by the
+	// sha256msg1/sha256msg2 instructions. The state is kept in the ABEF/CDGH layout the instructions expect.
+	VOLT_TARGET_FEATURES("sha,sse4.1") void CompressSHANI(uint32_t(&state)[8], const uint8_t* blocks, size_t numBlocks)
+	{
+		const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+
+		// Shuffle the state from ABCD/EFGH into ABEF/CDGH
+		__m128i temp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);
+		__m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+		state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+		for (; numBlocks > 0; numBlocks--, blocks += SHA_256_BLOCK_LENGTH)
+		{
+			const __m128i savedState0 = state0, savedState1 = state1;
+
+			__m128i message0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 0)), byteSwapMask);
+			__m128i message1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 16)), byteSwapMask);
+			__m128i message2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 32)), byteSwapMask);
+			__m128i message3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 48)), byteSwapMask);
+
+			// The message vectors hold a sliding window of the message schedule, they're rotated every 4 rounds so each
+			// vector stays in a register
+			for (uint32_t i = 0; i < 16; i += 4)
+			{
+				SHANIQuadRound(state0, state1, message0, message1, message3, i);
+				SHANIQuadRound(state0, state1, message1, message2, message0, i + 1);
+				SHANIQuadRound(state0, state1, message2, message3, message1, i + 2);
+				SHANIQuadRound(state0, state1, message3, message0, message2, i + 3);
+			}
+
+			state0 = _mm_add_epi32(state0, savedState0);
+			state1 = _mm_add_epi32(state1, savedState1);
+		}
+
+		// Shuffle the state back into ABCD/EFGH
+		temp = _mm_shuffle_epi32(state0, 0x1B);
+		state1 = _mm_shuffle_epi32(state1, 0xB1);
+		state0 = _mm_blend_epi16(temp, state1, 0xF0);
+		state1 = _mm_alignr_epi8(state1, temp, 8);
+
+		_mm_storeu_si128((__m128i*)&state[0], state0);
+		_mm_storeu_si128((__m128i*)&state[4], state1);
+	}
+#endif
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+namespace Volt
+{
+	void CompressSHA256Blocks(SHA256Backend backend, uint32_t(&state)[8], const uint8_t* blocks, size_t numBlocks)
+	{
+		switch (backend)
+		{
+	#ifdef VOLT_CPU_X86
+		case SHA256Backend::SHA_NI:
+			CompressSHANI(state, blocks, numBlocks);
+			break;
+	#endif
+		default:
+			CompressScalar(state, blocks, numBlocks);
+			break;
+		}
+	}
+
+	void FinalizeSHA256Digest(SHA256Backend backend, uint32_t(&state)[8], uint64_t bytesProcessed, const uint8_t* tail,
+		size_t tailLength, uint8_t* digestOutput)
+	{
+		// Process the whole blocks of the tail directly from the input
+		const size_t wholeBlocks = tailLength / SHA_256_BLOCK_LENGTH;
+		if (wholeBlocks > 0)
+			Volt::CompressSHA256Blocks(backend, state, tail, wholeBlocks);
+
+		// The remaining bytes, the 0x80 padding byte and the 64-bit message length need one or two more blocks
+		const size_t remainingLength = tailLength - wholeBlocks * SHA_256_BLOCK_LENGTH;
+		const size_t finalBlocks = (remainingLength + 9 > SHA_256_BLOCK_LENGTH) ? 2 : 1;
+
+		uint8_t paddedBlocks[SHA_256_BLOCK_LENGTH * 2] = {};
+		std::copy_n(tail + wholeBlocks * SHA_256_BLOCK_LENGTH, remainingLength, paddedBlocks);
+		paddedBlocks[remainingLength] = 0x80;
+
+		const uint64_t messageBits = (bytesProcessed + tailLength) * 8;
+		for (size_t i = 0; i < sizeof(uint64_t); i++)
+			paddedBlocks[finalBlocks * SHA_256_BLOCK_LENGTH - 1 - i] = (uint8_t)(messageBits >> (8 * i));
+
+		Volt::CompressSHA256Blocks(backend, state, paddedBlocks, finalBlocks);
+
+		for (size_t i = 0; i < 8; i++)
+		{
+			digestOutput[i * 4] = (uint8_t)(state[i] >> 24);
+			digestOutput[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+			digestOutput[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+			digestOutput[i * 4 + 3] = (uint8_t)state[i];
+		}
+	}
+}
@@ -0,0 +1,180 @@
+#include <crypto/signiture_cache.h>
+#include <util/random_generation.h>
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	// The number of shards the cache is split into, each with its own lock.
+	constexpr size_t cacheShardCount = 16;
+	static_assert(256 % cacheShardCount == 0, "Shards are picked using a single byte of the key");
+
+	// Hashes a cache key using its first bytes, the keys are salted digests so they're already uniformly distributed.
+	struct SignitureCacheKeyHasher
+	{
+		size_t operator()(const Volt::SignitureCacheKey& key) const
+		{
+			uint64_t hash = 0;
+			for (size_t i = 0; i < sizeof(uint64_t); i++)
+				hash = (hash << 8) | key[i];
+
+			return (size_t)hash;
+		}
+	};
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class SignitureCache::Implementation
+	{
+	public:
+		// A shard of the cache, the order the keys were inserted in is kept so the oldest key can be evicted.
+		struct Shard
+		{
+			std::mutex mutex;
+			std::unordered_set<SignitureCacheKey, SignitureCacheKeyHasher> keys;
+			std::deque<SignitureCacheKey> insertionOrder;
+		};
+
+		std::vector<Shard> shards;
+		size_t shardCapacity;
+		uint8_t salt[32];
+
+		std::atomic<uint64_t> hits, misses, insertions, evictions, verificationNanoseconds;
+	public:
+		Implementation(size_t capacity) :
+			shards(cacheShardCount), shardCapacity(std::max<size_t>(capacity / cacheShardCount, 1)), hits(0), misses(0),
+			insertions(0), evictions(0), verificationNanoseconds(0)
+		{
+			// Fall back onto the weaker random generator if OpenSSL can't provide random bytes
+			if (RAND_bytes(this->salt, sizeof(this->salt)) <= 0)
+			{
+				for (uint8_t& byte : this->salt)
+					byte = (uint8_t)Volt::GenerateRandomUint32(0, UINT8_MAX);
+			}
+		}
+
+		~Implementation() = default;
+
+		// Returns the shard the key given belongs to. The shard is picked using the last byte of the key, which the hasher
+		// doesn't read, since picking it using the hash would leave every key of a shard with the same low bits (and MSVC
+		// picks buckets using the low bits of the hash, so only a fraction of each shard's buckets would be used).
+		Shard& GetShard(const SignitureCacheKey& key)
+		{
+			return this->shards[key.back() % this->shards.size()];
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SignitureCache::SignitureCache(size_t capacity) :
+		impl(std::make_unique<Implementation>(capacity))
+	{}
+
+	SignitureCache::~SignitureCache() = default;
+
+	SignitureCacheKey SignitureCache::GetKey(const SHA256Digest& digest, const uint8_t* signiture, size_t signitureLength,
+		const CompressedPublicKey& publicKey) const
+	{
+		// The signiture length is included so the boundary between the signiture and public key can't be shifted
+		const uint8_t signitureLengthByte = (uint8_t)signitureLength;
+
+		SHA256Hasher hasher;
+		hasher.Update(this->impl->salt, sizeof(this->impl->salt));
+		hasher.Update(digest.data(), digest.size());
+		hasher.Update(&signitureLengthByte, 1);
+		hasher.Update(signiture, signitureLength);
+		hasher.Update(publicKey.data(), publicKey.size());
+
+		SignitureCacheKey key;
+		hasher.Finalize(key);
+
+		return key;
+	}
+
+	bool SignitureCache::Contains(const SignitureCacheKey& key)
+	{
+		Implementation::Shard& shard = this->impl->GetShard(key);
+
+		bool found = false;
+		{
+			std::scoped_lock lock(shard.mutex);
+			found = shard.keys.count(key) > 0;
+		}
+
+		(found ? this->impl->hits : this->impl->misses).fetch_add(1, std::memory_order_relaxed);
+		return found;
+	}
+
+	void SignitureCache::Insert(const SignitureCacheKey& key, uint64_t verificationNanoseconds)
+	{
+		Implementation::Shard& shard = this->impl->GetShard(key);
+		{
+			std::scoped_lock lock(shard.mutex);
+			if (!shard.keys.insert(key).second)
+				return;
+
+			shard.insertionOrder.emplace_back(key);
+
+			// Evict the oldest key once the shard is full
+			if (shard.insertionOrder.size() > this->impl->shardCapacity)
+			{
+				shard.keys.erase(shard.insertionOrder.front());
+				shard.insertionOrder.pop_front();
+				this->impl->evictions.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		this->impl->insertions.fetch_add(1, std::memory_order_relaxed);
+		this->impl->verificationNanoseconds.fetch_add(verificationNanoseconds, std::memory_order_relaxed);
+	}
+
+	SignitureCacheStats SignitureCache::GetStats() const
+	{
+		SignitureCacheStats stats = {};
+		stats.hits = this->impl->hits.load();
+		stats.misses = this->impl->misses.load();
+		stats.insertions = this->impl->insertions.load();
+		stats.evictions = this->impl->evictions.load();
+		stats.verificationNanoseconds = this->impl->verificationNanoseconds.load();
+
+		if (stats.insertions > 0)
+			stats.savedNanoseconds = (uint64_t)((double)stats.verificationNanoseconds / stats.insertions * stats.hits);
+
+		for (Implementation::Shard& shard : this->impl->shards)
+		{
+			std::scoped_lock lock(shard.mutex);
+			stats.size += shard.keys.size();
+		}
+
+		return stats;
+	}
+
+	void SignitureCache::Clear()
+	{
+		for (Implementation::Shard& shard : this->impl->shards)
+		{
+			std::scoped_lock lock(shard.mutex);
+			shard.keys.clear();
+			shard.insertionOrder.clear();
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SignitureCache& GetSignitureCache()
+	{
+		static SignitureCache cache(VOLT_SIGNITURE_CACHE_CAPACITY);
+		return cache;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,79 @@
+#ifndef VIDIBOLT_SIGNITURE_CACHE_H
+#define VIDIBOLT_SIGNITURE_CACHE_H
+
+#include <util/volt_api.h>
+#include <crypto/sha256.h>
+#include <crypto/public_key_cache.h>
+
+#include <memory>
+
+// The number of valid signitures remembered by the shared signiture cache.
+#define VOLT_SIGNITURE_CACHE_CAPACITY 65536
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The type of the keys stored in a signiture cache, which is the salted hash of a (digest, signiture, public key) triple.
+	using SignitureCacheKey = SHA256Digest;
+
+	// A struct which holds the statistics of a signiture cache.
+	struct SignitureCacheStats
+	{
+		uint64_t hits, misses, insertions, evictions;
+		size_t size;
+
+		// The total time spent verifying the signitures which were inserted, and the estimated time saved by the hits
+		// (the number of hits multiplied by the average verification time).
+		uint64_t verificationNanoseconds, savedNanoseconds;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which remembers signitures which have already been proven valid, so a transaction which is verified when it's
+	// added to the mempool doesn't need its signiture verified again when the block holding it is verified (or when the
+	// whole chain is verified).
+	//
+	// The keys are hashed with a random salt generated when the cache is created, so the keys (and which shard they land
+	// in) can't be predicted by anyone trying to fill the cache with colliding entries. The cache is bounded and split into
+	// shards which each have their own lock, the oldest entries of a shard are evicted once it's full.
+	class SignitureCache
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		VOLT_API SignitureCache(size_t capacity);
+		VOLT_API SignitureCache(const SignitureCache& cache) = delete;
+
+		VOLT_API ~SignitureCache();
+
+		VOLT_API void operator=(const SignitureCache& cache) = delete;
+
+		// Returns the salted cache key of the signiture of the digest given, made with the public key given.
+		VOLT_API SignitureCacheKey GetKey(const SHA256Digest& digest, const uint8_t* signiture, size_t signitureLength,
+			const CompressedPublicKey& publicKey) const;
+
+		// Returns TRUE if the signiture matching the key given has already been proven valid, else FALSE is returned.
+		VOLT_API bool Contains(const SignitureCacheKey& key);
+
+		// Remembers the signiture matching the key given as valid, along with the time it took to verify it.
+		VOLT_API void Insert(const SignitureCacheKey& key, uint64_t verificationNanoseconds);
+
+		// Returns the statistics of the cache so far.
+		VOLT_API SignitureCacheStats GetStats() const;
+
+		// Removes every signiture from the cache.
+		VOLT_API void Clear();
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the signiture cache shared by the mempool and block validation, which holds 'VOLT_SIGNITURE_CACHE_CAPACITY'
+	// signitures.
+	extern VOLT_API SignitureCache& GetSignitureCache();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
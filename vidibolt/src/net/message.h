@@ -49,6 +49,15 @@ namespace Volt
 		// Message IDs related to requesting the balance held by a specified address from other peer nodes.
 		ADDRESS_AMOUNT_REQUEST,
 		ADDRESS_AMOUNT_RESPONSE,
+
+		// Message IDs related to the distribution of mining work between a FULL node coordinating a pool and its workers.
+		POOL_JOB_REQUEST,
+		POOL_JOB_RESPONSE,
+		POOL_SHARE_SUBMIT,
+		POOL_SHARE_RESPONSE,
+
+		// Message IDs related to relaying transactions to other peer nodes.
+		TRANSACTION_RELAY,
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
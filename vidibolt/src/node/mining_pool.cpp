@@ -0,0 +1,345 @@
+#include <node/mining_pool.h>
+#include <core/block_template.h>
+#include <crypto/sha256_kernel.h>
+#include <util/data_conversion.h>
+#include <util/random_generation.h>
+
+#include <unordered_map>
+#include <algorithm>
+#include <unordered_set>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <cmath>
+
+namespace
+{
+	// The time constant (in seconds) of the moving average used to estimate the hash rate of a worker.
+	constexpr double HASH_RATE_AVERAGE_SECONDS = 30;
+
+	// A snapshot of the pool's block template which nonce ranges are handed out from.
+	struct PoolTemplate
+	{
+		Volt::Block block;
+		Volt::NonceKernelInput kernelInput;
+		Volt::DifficultyTarget target;
+		uint64_t nextNonce = 0;
+	};
+
+	// A job handed out to a worker.
+	struct Job
+	{
+		uint64_t workerID = 0;
+		std::shared_ptr<PoolTemplate> poolTemplate;
+		uint64_t nonceStart = 0, nonceEnd = 0;
+		uint64_t shareDifficulty = 0;
+		Volt::DifficultyTarget shareTarget = {};
+		std::unordered_set<uint64_t> submittedNonces;
+	};
+
+	// The state the pool keeps about each of its workers.
+	struct Worker
+	{
+		Volt::PoolWorkerStats stats;
+		std::deque<uint64_t> jobIDs; // The IDs of the most recent jobs of the worker, oldest first
+		std::chrono::steady_clock::time_point lastJobTime;
+		uint64_t shareDifficultySinceLastJob = 0; // The sum of the difficulties of the shares since the last job
+		bool hashRateMeasured = false;
+	};
+}
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class MiningPool::Implementation
+	{
+	public:
+		Chain& chain;
+		BlockTemplate blockTemplate;
+		uint64_t shareDifficulty;
+
+		mutable std::mutex mutex;
+		std::shared_ptr<PoolTemplate> currentTemplate;
+		DigestField tipHash;
+		uint64_t nextJobID;
+		std::unordered_map<uint64_t, Job> jobs;
+		std::unordered_map<uint64_t, Worker> workers;
+	public:
+		Implementation(MemPool& pool, Chain& chain, uint64_t difficulty, uint64_t shareDifficulty,
+			const ECKeyPair* poolPublicKey) :
+			chain(chain), blockTemplate(pool, chain, difficulty, poolPublicKey), shareDifficulty(shareDifficulty),
+			nextJobID(1)
+		{
+			this->tipHash = chain.GetLatestBlock().GetBlockHashField();
+			this->SnapshotTemplate();
+		}
+
+		~Implementation() = default;
+
+		// Takes a snapshot of the block template and makes it the template which jobs are handed out from.
+		void SnapshotTemplate()
+		{
+			auto poolTemplate = std::make_shared<PoolTemplate>();
+			poolTemplate->block = this->blockTemplate.GetBlock();
+			poolTemplate->kernelInput = this->blockTemplate.GetKernelInput();
+			poolTemplate->target = Volt::GetDifficultyTarget(poolTemplate->block.GetDifficulty());
+
+			this->currentTemplate = poolTemplate;
+		}
+
+		// Brings the block template up to date, if a new block has landed on the chain every outstanding job is dropped.
+		// The mutex must already be locked by the caller.
+		ErrorCode RefreshLocked()
+		{
+			bool templateChanged = false;
+			ErrorCode error = this->blockTemplate.Refresh(&templateChanged);
+			if (error || !templateChanged)
+				return error;
+
+			const DigestField& latestHash = this->chain.GetLatestBlock().GetBlockHashField();
+			if (latestHash != this->tipHash)
+			{
+				this->tipHash = latestHash;
+				this->jobs.clear();
+
+				for (auto& [workerID, worker] : this->workers)
+					worker.jobIDs.clear();
+			}
+
+			this->SnapshotTemplate();
+			return ErrorID::NONE;
+		}
+
+		// Updates the hash rate estimate of the worker from the shares it submitted since its last job, then returns the
+		// size of the nonce range it should be handed next.
+		uint64_t RetargetNonceRange(Worker& worker, std::chrono::steady_clock::time_point timeNow)
+		{
+			if (worker.stats.nonceRangeSize != 0)
+			{
+				const double timeElapsed = std::chrono::duration<double>(timeNow - worker.lastJobTime).count();
+				if (timeElapsed > 0)
+				{
+					// Every share is worth the expected number of hashes needed to find it
+					const double measuredRate = (double)worker.shareDifficultySinceLastJob / timeElapsed;
+
+					// Exponential moving average weighted by the time elapsed, so that a worker asking for jobs quickly
+					// doesn't get its estimate thrown off by the short intervals
+					if (!worker.hashRateMeasured)
+						worker.stats.hashesPerSecond = measuredRate;
+					else
+					{
+						const double weight = 1.0 - std::exp(-timeElapsed / HASH_RATE_AVERAGE_SECONDS);
+						worker.stats.hashesPerSecond += weight * (measuredRate - worker.stats.hashesPerSecond);
+					}
+
+					worker.hashRateMeasured = true;
+				}
+			}
+
+			worker.lastJobTime = timeNow;
+			worker.shareDifficultySinceLastJob = 0;
+
+			double rangeSize = worker.hashRateMeasured ? worker.stats.hashesPerSecond * VOLT_POOL_TARGET_JOB_SECONDS :
+				(double)VOLT_POOL_INITIAL_NONCE_RANGE_SIZE;
+
+			rangeSize = std::clamp(rangeSize, (double)VOLT_POOL_MIN_NONCE_RANGE_SIZE, (double)VOLT_POOL_MAX_NONCE_RANGE_SIZE);
+
+			// Round the range size up to a whole number of nonce chunks
+			const uint64_t numChunks = ((uint64_t)rangeSize + VOLT_NONCE_CHUNK_SIZE - 1) / VOLT_NONCE_CHUNK_SIZE;
+			worker.stats.nonceRangeSize = numChunks * VOLT_NONCE_CHUNK_SIZE;
+
+			return worker.stats.nonceRangeSize;
+		}
+
+		// Claims the next range of nonces of the current template, once every nonce of the template has been handed out
+		// the extra nonce of the template is changed to get a fresh search space.
+		void ClaimNonceRange(uint64_t rangeSize, uint64_t& nonceStart, uint64_t& nonceEnd)
+		{
+			PoolTemplate& poolTemplate = *this->currentTemplate;
+
+			nonceStart = poolTemplate.nextNonce;
+			nonceEnd = (UINT64_MAX - nonceStart < rangeSize - 1) ? UINT64_MAX : nonceStart + rangeSize - 1;
+
+			if (nonceEnd != UINT64_MAX)
+			{
+				poolTemplate.nextNonce = nonceEnd + 1;
+				return;
+			}
+
+			// The jobs of the exhausted template keep a reference to it, so the template is replaced rather than modified
+			auto freshTemplate = std::make_shared<PoolTemplate>(poolTemplate);
+			const uint64_t extraNonce = Volt::GenerateRandomUint64(0, UINT64_MAX);
+
+			Volt::SetBlockExtraNonce(freshTemplate->block, extraNonce);
+			Volt::SetKernelInputSearchSpace(freshTemplate->kernelInput, freshTemplate->block.GetTimestamp(), extraNonce);
+			freshTemplate->nextNonce = 0;
+
+			this->currentTemplate = freshTemplate;
+		}
+
+		ErrorCode AssignJob(uint64_t workerID, PoolJob& job)
+		{
+			std::scoped_lock lock(this->mutex);
+
+			ErrorCode error = this->RefreshLocked();
+			if (error)
+				return error;
+
+			Worker& worker = this->workers[workerID];
+			const uint64_t rangeSize = this->RetargetNonceRange(worker, std::chrono::steady_clock::now());
+
+			const std::shared_ptr<PoolTemplate> poolTemplate = this->currentTemplate;
+			const uint64_t jobID = this->nextJobID++;
+
+			Job& newJob = this->jobs[jobID];
+			newJob.workerID = workerID;
+			newJob.poolTemplate = poolTemplate;
+			newJob.shareDifficulty = this->shareDifficulty;
+			newJob.shareTarget = Volt::GetDifficultyTarget(this->shareDifficulty);
+			this->ClaimNonceRange(rangeSize, newJob.nonceStart, newJob.nonceEnd);
+
+			// Only the most recent jobs of the worker are kept
+			worker.jobIDs.push_back(jobID);
+			if (worker.jobIDs.size() > VOLT_POOL_MAX_JOBS_PER_WORKER)
+			{
+				this->jobs.erase(worker.jobIDs.front());
+				worker.jobIDs.pop_front();
+			}
+
+			job.jobID = jobID;
+			job.nonceStart = newJob.nonceStart;
+			job.nonceEnd = newJob.nonceEnd;
+			job.shareDifficulty = this->shareDifficulty;
+			job.block = poolTemplate->block;
+
+			return ErrorID::NONE;
+		}
+
+		ErrorCode SubmitShare(uint64_t workerID, uint64_t jobID, uint64_t nonce, bool& blockSolved)
+		{
+			std::scoped_lock lock(this->mutex);
+			blockSolved = false;
+
+			// Drop the jobs on top of the old tip if a new block has landed
+			ErrorCode error = this->RefreshLocked();
+			if (error)
+				return error;
+
+			auto jobIterator = this->jobs.find(jobID);
+			auto workerIterator = this->workers.find(workerID);
+
+			if (jobIterator == this->jobs.end() || workerIterator == this->workers.end() ||
+				jobIterator->second.workerID != workerID)
+			{
+				if (workerIterator != this->workers.end())
+					workerIterator->second.stats.sharesRejected++;
+
+				return ErrorID::POOL_JOB_NOT_FOUND;
+			}
+
+			Job& job = jobIterator->second;
+			Worker& worker = workerIterator->second;
+
+			error = this->CheckShare(job, nonce, blockSolved);
+			if (error)
+			{
+				worker.stats.sharesRejected++;
+				return error;
+			}
+
+			job.submittedNonces.insert(nonce);
+			worker.stats.sharesAccepted++;
+			worker.shareDifficultySinceLastJob += std::max<uint64_t>(job.shareDifficulty, 1);
+
+			if (blockSolved)
+			{
+				worker.stats.blocksFound++;
+				return this->RefreshLocked();
+			}
+
+			return ErrorID::NONE;
+		}
+
+		// Checks that the share is valid for the job, if the share also satisfies the block difficulty then the mined block
+		// is pushed to the chain.
+		ErrorCode CheckShare(const Job& job, uint64_t nonce, bool& blockSolved)
+		{
+			if (nonce < job.nonceStart || nonce > job.nonceEnd)
+				return ErrorID::POOL_SHARE_NONCE_OUT_OF_RANGE;
+
+			if (job.submittedNonces.count(nonce))
+				return ErrorID::POOL_SHARE_DUPLICATE;
+
+			// The share is hashed from the cached kernel input of the template, so only the header tail has to be hashed
+			uint32_t digests[SHA_256_KERNEL_MAX_LANES][8];
+			Volt::HashNonceBatch(NonceKernel::SCALAR, job.poolTemplate->kernelInput, nonce, digests);
+
+			if (!Volt::DigestMeetsTarget(digests[0], job.shareTarget))
+				return ErrorID::POOL_SHARE_DIFFICULTY_INSUFFICIENT;
+
+			if (Volt::DigestMeetsTarget(digests[0], job.poolTemplate->target))
+			{
+				DigestField blockHash = { {}, BinaryFieldState::VALID };
+				Volt::ConvertDigestWordsToBytes(digests[0], blockHash.data.data());
+
+				const Block& block = job.poolTemplate->block;
+				Block minedBlock(block.GetIndex(), block.GetPreviousBlockHashField(), block.GetTransactions(),
+					block.GetDifficulty(), blockHash, block.GetTimestamp(), nonce, block.GetExtraNonce());
+
+				ErrorCode error = Volt::PushBlock(this->chain, std::move(minedBlock));
+				if (error)
+					return error;
+
+				blockSolved = true;
+			}
+
+			return ErrorID::NONE;
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	MiningPool::MiningPool(MemPool& pool, Chain& chain, uint64_t difficulty, uint64_t shareDifficulty,
+		const ECKeyPair* poolPublicKey) :
+		impl(std::make_unique<Implementation>(pool, chain, difficulty, shareDifficulty, poolPublicKey))
+	{}
+
+	MiningPool::~MiningPool() = default;
+
+	ErrorCode MiningPool::AssignJob(uint64_t workerID, PoolJob& job)
+	{
+		return this->impl->AssignJob(workerID, job);
+	}
+
+	ErrorCode MiningPool::SubmitShare(uint64_t workerID, uint64_t jobID, uint64_t nonce, bool& blockSolved)
+	{
+		return this->impl->SubmitShare(workerID, jobID, nonce, blockSolved);
+	}
+
+	bool MiningPool::GetWorkerStats(uint64_t workerID, PoolWorkerStats& stats) const
+	{
+		std::scoped_lock lock(this->impl->mutex);
+
+		auto workerIterator = this->impl->workers.find(workerID);
+		if (workerIterator == this->impl->workers.end())
+			return false;
+
+		stats = workerIterator->second.stats;
+		return true;
+	}
+
+	void MiningPool::SetShareDifficulty(uint64_t shareDifficulty)
+	{
+		std::scoped_lock lock(this->impl->mutex);
+		this->impl->shareDifficulty = shareDifficulty;
+	}
+
+	uint64_t MiningPool::GetShareDifficulty() const
+	{
+		std::scoped_lock lock(this->impl->mutex);
+		return this->impl->shareDifficulty;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
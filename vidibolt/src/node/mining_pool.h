@@ -0,0 +1,117 @@
+#ifndef VIDIBOLT_NODE_MINING_POOL_H
+#define VIDIBOLT_NODE_MINING_POOL_H
+
+#include <core/block.h>
+#include <core/chain.h>
+#include <core/mem_pool.h>
+#include <core/nonce_partition.h>
+#include <crypto/ecdsa.h>
+#include <util/volt_api.h>
+#include <util/error_identifier.h>
+
+#include <memory>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The bounds of the nonce range sizes handed out to pool workers, range sizes are always a multiple of the nonce chunk
+	// size used by the mining workers.
+	constexpr uint64_t VOLT_POOL_MIN_NONCE_RANGE_SIZE = VOLT_NONCE_CHUNK_SIZE * 16;
+	constexpr uint64_t VOLT_POOL_MAX_NONCE_RANGE_SIZE = 1ull << 40;
+
+	// The nonce range size handed out to a worker whose hash rate hasn't been measured yet.
+	constexpr uint64_t VOLT_POOL_INITIAL_NONCE_RANGE_SIZE = 1ull << 24;
+
+	// The number of seconds a worker should take to search the nonce range of a job.
+	constexpr double VOLT_POOL_TARGET_JOB_SECONDS = 10;
+
+	// The number of recent jobs of a worker which shares are still accepted for, older jobs are dropped.
+	constexpr uint32_t VOLT_POOL_MAX_JOBS_PER_WORKER = 4;
+
+	// A struct which holds a unit of work handed out by a mining pool to one of its workers.
+	// The worker searches the nonce range ['nonceStart', 'nonceEnd'] of the block and submits every hash satisfying the
+	// share difficulty back to the pool.
+	struct PoolJob
+	{
+		uint64_t jobID = 0;
+		uint64_t nonceStart = 0, nonceEnd = 0;
+		uint64_t shareDifficulty = 0;
+		Block block;
+	};
+
+	// A struct which holds the outcome of a share submitted to a mining pool.
+	struct PoolShareResult
+	{
+		ErrorCode status; // 'ErrorID::NONE' if the share was accepted, else the reason it was rejected
+		bool blockSolved = false; // TRUE if the share also satisfied the block difficulty and the block was pushed to the chain
+	};
+
+	// A struct which holds the statistics of a mining pool worker.
+	struct PoolWorkerStats
+	{
+		uint64_t sharesAccepted = 0;
+		uint64_t sharesRejected = 0;
+		uint64_t blocksFound = 0;
+		double hashesPerSecond = 0; // Estimated from the rate at which the worker submits shares
+		uint64_t nonceRangeSize = 0; // The size of the nonce range the worker will be handed in its next job
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which coordinates the mining workers of a pool, owned by a FULL node (see Node::SetMiningPool()).
+	// The pool keeps a block template up to date with the mempool and the chain, and hands out disjoint ranges of nonces
+	// from it to its workers as jobs. Workers submit shares (hashes satisfying a difficulty much lower than the block
+	// difficulty) back, which the pool uses to measure the hash rate of each worker.
+	//
+	// The nonce range handed to a worker is sized from its measured hash rate so that every job takes roughly
+	// 'VOLT_POOL_TARGET_JOB_SECONDS' to search, meaning a slow worker never sits on a large part of the search space and
+	// every worker comes back for a new job (and so picks up a new template) at roughly the same rate.
+	// The share difficulty should be low enough for a worker to find several shares per job, else the measured rates are
+	// noisy.
+	//
+	// When the mempool changes, new jobs are handed out from the updated template while shares for the jobs of the old one
+	// are still accepted. When a new block lands on the chain every outstanding job is dropped, so shares for them are
+	// rejected as stale. The pool is thread safe.
+	class MiningPool
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		// The mempool and chain given must outlive the pool, mined blocks are pushed to the chain by the pool.
+		// The mining reward of the blocks mined is paid to the public key of the pool (if given).
+		VOLT_API MiningPool(MemPool& pool, Chain& chain, uint64_t difficulty, uint64_t shareDifficulty,
+			const ECKeyPair* poolPublicKey = nullptr);
+		VOLT_API MiningPool(const MiningPool& pool) = delete;
+
+		VOLT_API ~MiningPool();
+
+		VOLT_API void operator=(const MiningPool& pool) = delete;
+
+		// Hands out the next job to the worker with the ID given, the job is returned via 'job'.
+		// Worker IDs must be assigned by the pool's side (the node uses the ID of the connection the worker's messages
+		// arrive on), never taken from the worker, else a worker could submit shares and take jobs as another worker.
+		// An error code is returned in the event of a failure occurring.
+		VOLT_API ErrorCode AssignJob(uint64_t workerID, PoolJob& job);
+
+		// Checks the share submitted by the worker for the job given. If the share also satisfies the block difficulty
+		// then the mined block is pushed to the chain and 'blockSolved' is set to TRUE.
+		// An error code is returned if the share was rejected, e.g. 'ErrorID::POOL_JOB_NOT_FOUND' for a stale job.
+		VOLT_API ErrorCode SubmitShare(uint64_t workerID, uint64_t jobID, uint64_t nonce, bool& blockSolved);
+
+		// Returns the statistics of the worker with the ID given via 'stats'.
+		// Returns FALSE if the pool has never handed out a job to the worker, else TRUE is returned.
+		VOLT_API bool GetWorkerStats(uint64_t workerID, PoolWorkerStats& stats) const;
+
+		// Sets the difficulty of the shares submitted by workers, this applies to jobs handed out from now on.
+		VOLT_API void SetShareDifficulty(uint64_t shareDifficulty);
+
+		// Returns the difficulty of the shares submitted by workers.
+		VOLT_API uint64_t GetShareDifficulty() const;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <node/node.h>
 #include <util/random_generation.h>
 
+#include <exception>
 #include <string>
 
 namespace Volt
@@ -20,10 +21,11 @@ namespace Volt
 		TCPServer server;
 		MemPool* mempool;
 		Chain* chain;
+		MiningPool* miningPool;
 	public:
 		Implementation(NodeType type, MemPool* mempool, Chain* chain, uint32_t port, uint64_t nodeNetworkID) :
 			type(type), client(port), server(port), port(port), guid(0), nodeNetworkID(nodeNetworkID), mempool(mempool),
-			chain(chain)
+			chain(chain), miningPool(nullptr)
 		{
 			this->peerList.Reserve(64);
 		}
@@ -51,11 +53,11 @@ namespace Volt
 
 		ErrorCode ProcessAddressBalanceResponse(const RecievedMessage& peerResponseMsg)
 		{
-			// The recieved response message should be formatted as so: [ [uint32_t] Request ID, [double] Balance ]
+			// The recieved response message should be formatted as so: [ [uint32_t] Request ID, [Amount] Balance ]
 			// Extract the elements from the response message
 			MessageIterator iterator = peerResponseMsg.transmittedMsg.GetBegin();
 
-			const double returnedBalance = iterator.GetNextElementData<double>();
+			const Amount returnedBalance = iterator.GetNextElementData<Amount>();
 			const uint32_t requestID = iterator.GetNextElementData<uint32_t>();
 
 			if (returnedBalance == -1) // If the returned balance value is -1 then an error occurred on the peer node's side
@@ -88,7 +90,7 @@ namespace Volt
 
 			// Get the balance tied to the public key addresss
 			const ECKeyPair publicKey(publicKeyAddress, std::string(), &operationError);
-			double retrievedBalance = -1;
+			Amount retrievedBalance = -1;
 
 			if (!operationError)
 				retrievedBalance = this->chain->GetAddressBalance(publicKey);
@@ -106,6 +108,169 @@ namespace Volt
 			return operationError;
 		}
 
+		// Fulfills the pending operation return promise matching the request ID given with the value given.
+		void FulfillPendingReturn(uint32_t requestID, const OperationReturnValue& value)
+		{
+			for (uint32_t index = 0; index < this->pendingRequestReturns.GetSize(); index++)
+			{
+				Node::PendingOperationReturn& returnPromise = this->pendingRequestReturns[index];
+				if (requestID == returnPromise.first)
+				{
+					returnPromise.second.set_value(value);
+					this->pendingRequestReturns.EraseElementAtIndex(index);
+					break;
+				}
+			}
+		}
+
+		ErrorCode ProcessPoolJobResponse(const RecievedMessage& poolResponseMsg)
+		{
+			// The recieved response message should be formatted as so: [ [uint32_t] Request ID, [uint32_t] Status, 
+			// [uint64_t] Job ID, [uint64_t] Nonce Start, [uint64_t] Nonce End, [uint64_t] Share Difficulty, 
+			// [std::string] Block JSON ]
+			// Extract the elements from the response message
+			MessageIterator iterator = poolResponseMsg.transmittedMsg.GetBegin();
+
+			const std::string blockJSON = iterator.GetNextElementData<std::string>();
+
+			PoolJob job;
+			job.shareDifficulty = iterator.GetNextElementData<uint64_t>();
+			job.nonceEnd = iterator.GetNextElementData<uint64_t>();
+			job.nonceStart = iterator.GetNextElementData<uint64_t>();
+			job.jobID = iterator.GetNextElementData<uint64_t>();
+
+			const ErrorID status = (ErrorID)iterator.GetNextElementData<uint32_t>();
+			const uint32_t requestID = iterator.GetNextElementData<uint32_t>();
+
+			// A job ID of 0 tells the requester that no job was handed out
+			json::error_code ec;
+			const json::value blockValue = json::parse(blockJSON, ec);
+			ErrorCode error = ErrorID::NONE;
+
+			if (status == ErrorID::NONE && !ec)
+			{
+				// The block comes from the pool, so the conversion throws if its JSON has missing or malformed fields
+				try
+				{
+					job.block = json::value_to<Block>(blockValue);
+				}
+				catch (const std::exception&)
+				{
+					job.jobID = 0;
+					error = ErrorID::RECIEVED_TRANSMITTED_DATA_INVALID;
+				}
+			}
+			else
+			{
+				job.jobID = 0;
+			}
+
+			this->FulfillPendingReturn(requestID, job);
+			return error;
+		}
+
+		ErrorCode TransmitPoolJob(const RecievedMessage& workerRequestMsg)
+		{
+			// The recieved request message should be formatted as so: [ [uint32_t] Request ID ]
+			// Extract the elements from the request message
+			MessageIterator iterator = workerRequestMsg.transmittedMsg.GetBegin();
+
+			const uint32_t requestID = iterator.GetNextElementData<uint32_t>();
+
+			// Workers are told apart by the connection their messages arrive on rather than an ID they report themselves,
+			// so a peer can't take jobs or submit shares as another worker
+			const uint64_t workerID = workerRequestMsg.connectionID;
+
+			// Hand out the next job of the pool to the worker
+			PoolJob job;
+			ErrorCode status = ErrorID::MINING_POOL_NOT_AVAILABLE;
+			std::string blockJSON;
+
+			if (this->miningPool)
+				status = this->miningPool->AssignJob(workerID, job);
+
+			if (!status)
+				blockJSON = json::serialize(json::value_from(job.block));
+
+			// Initialize the outbound message to be transmitted
+			Message outboundMsg;
+			outboundMsg.header.id = MessageRepType::POOL_JOB_RESPONSE;
+			outboundMsg.header.networkID = this->nodeNetworkID;
+
+			outboundMsg << requestID << (uint32_t)(ErrorID)status << job.jobID << job.nonceStart << job.nonceEnd <<
+				job.shareDifficulty << blockJSON;
+
+			// Send the response to the worker which requested the job
+			return this->server.PushOutboundResponseMessage(workerRequestMsg, outboundMsg);
+		}
+
+		ErrorCode ProcessPoolShareResponse(const RecievedMessage& poolResponseMsg)
+		{
+			// The recieved response message should be formatted as so: [ [uint32_t] Request ID, [uint32_t] Status, 
+			// [int] Block Solved ]
+			// Extract the elements from the response message
+			MessageIterator iterator = poolResponseMsg.transmittedMsg.GetBegin();
+
+			PoolShareResult result;
+			result.blockSolved = (bool)iterator.GetNextElementData<int>();
+			result.status = (ErrorID)iterator.GetNextElementData<uint32_t>();
+
+			const uint32_t requestID = iterator.GetNextElementData<uint32_t>();
+
+			this->FulfillPendingReturn(requestID, result);
+			return ErrorID::NONE;
+		}
+
+		ErrorCode ProcessPoolShare(const RecievedMessage& workerSubmitMsg)
+		{
+			// The recieved submission message should be formatted as so: [ [uint32_t] Request ID, [uint64_t] Job ID,
+			// [uint64_t] Nonce ]
+			// Extract the elements from the submission message
+			MessageIterator iterator = workerSubmitMsg.transmittedMsg.GetBegin();
+
+			const uint64_t nonce = iterator.GetNextElementData<uint64_t>();
+			const uint64_t jobID = iterator.GetNextElementData<uint64_t>();
+			const uint32_t requestID = iterator.GetNextElementData<uint32_t>();
+
+			// The worker is the connection the share arrived on, the same as when its job was handed out
+			const uint64_t workerID = workerSubmitMsg.connectionID;
+
+			// Check the share against the job it was found for
+			bool blockSolved = false;
+			ErrorCode status = ErrorID::MINING_POOL_NOT_AVAILABLE;
+
+			if (this->miningPool)
+				status = this->miningPool->SubmitShare(workerID, jobID, nonce, blockSolved);
+
+			// Initialize the outbound message to be transmitted
+			Message outboundMsg;
+			outboundMsg.header.id = MessageRepType::POOL_SHARE_RESPONSE;
+			outboundMsg.header.networkID = this->nodeNetworkID;
+
+			outboundMsg << requestID << (uint32_t)(ErrorID)status << (int)blockSolved;
+
+			// Send the response to the worker which submitted the share
+			return this->server.PushOutboundResponseMessage(workerSubmitMsg, outboundMsg);
+		}
+
+		ErrorCode ProcessRelayedTransaction(const RecievedMessage& peerRelayMsg)
+		{
+			// The recieved relay message should be formatted as so: [ [std::string] Transaction Encoding ]
+			// Extract the elements from the relay message
+			MessageIterator iterator = peerRelayMsg.transmittedMsg.GetBegin();
+
+			const std::string encoding = iterator.GetNextElementData<std::string>();
+
+			// Transactions which can't be decoded or aren't valid are dropped, since they're the peer's problem and not the
+			// node's
+			Transaction tx;
+			if (this->mempool && this->chain &&
+				!Volt::DecodeTransaction((const uint8_t*)encoding.data(), encoding.size(), tx))
+				Volt::PushTransaction(*this->mempool, *this->chain, tx);
+
+			return ErrorID::NONE;
+		}
+
 		ErrorCode PushPeerNodeToList(const RecievedMessage& peerResponseMsg)
 		{
 			// The peers data in the response message is formatted as so :
@@ -164,6 +329,13 @@ namespace Volt
 			this->impl->peerList = *peerList;
 	}
 
+	void Node::SetMiningPool(MiningPool* pool)
+	{
+		assert(!(pool && this->impl->type != NodeType::FULL)); // Only FULL nodes can coordinate a mining pool
+
+		this->impl->miningPool = pool;
+	}
+
 	ErrorCode Node::FlushNode()
 	{
 		// Do transmission and reading of outgoing and incoming data
@@ -232,14 +404,22 @@ namespace Volt
 				case MessageRepType::ADDRESS_AMOUNT_RESPONSE:
 					error = this->impl->ProcessAddressBalanceResponse(msg);
 					break;
+				case MessageRepType::POOL_JOB_RESPONSE:
+					error = this->impl->ProcessPoolJobResponse(msg);
+					break;
+				case MessageRepType::POOL_SHARE_RESPONSE:
+					error = this->impl->ProcessPoolShareResponse(msg);
+					break;
 				}
 
-				if (error)
-					return error;
 			}
 
-			// Pop the recieved message off the queue
+			// Pop the recieved message off the queue, this is done even if processing it failed so that a malformed message
+			// doesn't stay at the front of the queue
 			this->impl->client.GetInboundMessages().PopFrontElement();
+
+			if (error)
+				return error;
 		}
 
 		////////////// Now, handle data incoming from the server side of the node //////////////
@@ -258,14 +438,25 @@ namespace Volt
 				case MessageRepType::ADDRESS_AMOUNT_REQUEST:
 					error = this->impl->TransmitAddressBalance(msg);
 					break;
+				case MessageRepType::POOL_JOB_REQUEST:
+					error = this->impl->TransmitPoolJob(msg);
+					break;
+				case MessageRepType::POOL_SHARE_SUBMIT:
+					error = this->impl->ProcessPoolShare(msg);
+					break;
+				case MessageRepType::TRANSACTION_RELAY:
+					error = this->impl->ProcessRelayedTransaction(msg);
+					break;
 				}
 
-				if (error)
-					return error;
 			}
 
-			// Pop the recieved message off the queue
+			// Pop the recieved message off the queue, this is done even if processing it failed so that a malformed message
+			// doesn't stay at the front of the queue
 			this->impl->server.GetInboundMessages().PopFrontElement();
+
+			if (error)
+				return error;
 		}
 
 		return ErrorID::NONE;
@@ -6,6 +6,7 @@
 #include <core/transaction.h>
 #include <net/tcp_client.h>
 #include <net/tcp_server.h>
+#include <node/mining_pool.h>
 #include <util/volt_api.h>
 #include <util/ts_vector.h>
 
@@ -33,7 +34,11 @@ namespace Volt
 		// Can either store the entire blockchain data locally on the its own machine or point to a full node in the same LAN 
 		// therefore avoiding having to store any blockchain data, however it will store the current state of the mempool.
 		// This node mines blocks on its own unlike pool miners.
-		SOLO_MINER
+		SOLO_MINER,
+
+		// Doesn't store blockchain data or the mempool, instead it mines ranges of nonces handed out as jobs by a FULL node
+		// coordinating a mining pool and submits shares back to it.
+		POOL_MINER
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,6 +54,11 @@ namespace Volt
 	 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// The value returned by an operation requested from a peer node, which type it holds depends on the operation.
+	using OperationReturnValue = std::variant<Amount, PoolJob, PoolShareResult>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 	// Handles VOLT node functionality e.g. broadcasting data to other nodes, recieving data from other nodes etc.
 	// Also, note that nodes must have either a full node or a solo miner node which stores a full copy of the blockchain in
 	// order to request other peer nodes to do tasks which involve operations around the blockchain e.g. requesting the balance
@@ -65,11 +75,16 @@ namespace Volt
 
 		friend extern VOLT_API ErrorCode AddPeerNode(Node& node, const std::string& ipAddress);
 		friend extern VOLT_API ErrorCode RequestAddressBalance(Node& node, const ECKeyPair& publicKey,
-			std::future<std::variant<double>>& returnedVal);
+			std::future<OperationReturnValue>& returnedVal);
+		friend extern VOLT_API ErrorCode RequestPoolJob(Node& node, const std::string& poolAddress,
+			std::future<OperationReturnValue>& returnedVal);
+		friend extern VOLT_API ErrorCode SubmitPoolShare(Node& node, const std::string& poolAddress, uint64_t jobID,
+			uint64_t nonce, std::future<OperationReturnValue>& returnedVal);
+		friend extern VOLT_API ErrorCode RelayTransaction(Node& node, const std::string& peerAddress, const Transaction& tx);
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	private:
-		using PendingOperationReturn = std::pair<uint32_t, std::promise<std::variant<double>>>;
+		using PendingOperationReturn = std::pair<uint32_t, std::promise<OperationReturnValue>>;
 
 		// Attemps to connect to peer node. Specified number of attempts are made on failures to connect before giving up and 
 		// returning an error.
@@ -90,7 +105,7 @@ namespace Volt
 		// Returns vector of pending/recieved returned data from requested operations executed by peer nodes.
 		VOLT_API Vector<PendingOperationReturn>& GetPendingReturnsFromOperations();
 	public:
-		using OperationReturn = std::future<std::variant<double>>;
+		using OperationReturn = std::future<OperationReturnValue>;
 
 		VOLT_API Node(NodeType type, MemPool* mempool, Chain* chain, uint32_t port = 60000, 
 			uint64_t nodeNetworkID = VOLT_MAINNET_NETWORK_ID);
@@ -103,6 +118,11 @@ namespace Volt
 		// Assigns the node with the GUID given and a list of direct peers.
 		VOLT_API void InitNode(uint64_t guid, const Vector<Peer>* peerList = nullptr);
 
+		// Makes the node coordinate the mining pool given, the node then hands out jobs from the pool to the pool miner 
+		// nodes which request them and checks the shares they submit. The pool must outlive the node, pass a null pointer 
+		// to stop coordinating the pool. Only FULL nodes can coordinate a mining pool.
+		VOLT_API void SetMiningPool(MiningPool* pool);
+
 		// Should be called every now and then so all pending outbound messages are transmitted and all pending inbound
 		// messages are recieved.
 		VOLT_API ErrorCode FlushNode();
@@ -33,7 +33,7 @@ namespace Volt
 		return operationError;
 	}
 
-	ErrorCode RequestAddressBalance(Node& node, const ECKeyPair& publicKey, std::future<std::variant<double>>& returnVal)
+	ErrorCode RequestAddressBalance(Node& node, const ECKeyPair& publicKey, std::future<OperationReturnValue>& returnVal)
 	{
 		std::scoped_lock lock(operationMutex);
 
@@ -63,7 +63,7 @@ namespace Volt
 		if (!operationError)
 		{
 			// Push pending request return promise
-			Node::PendingOperationReturn requestReturnPromise = { requestID, std::promise<std::variant<double>>() };
+			Node::PendingOperationReturn requestReturnPromise = { requestID, std::promise<OperationReturnValue>() };
 
 			returnVal = requestReturnPromise.second.get_future();
 			node.GetPendingReturnsFromOperations().EmplaceBackElement(std::move(requestReturnPromise));
@@ -82,4 +82,104 @@ namespace Volt
 
 		return operationError;
 	}
-}
\ No newline at end of file
+
+	ErrorCode RequestPoolJob(Node& node, const std::string& poolAddress, std::future<OperationReturnValue>& returnVal)
+	{
+		std::scoped_lock lock(operationMutex);
+
+		const uint32_t requestID = node.GenerateRequestID();
+
+		// Connect to the pool node, the connection is reused if it's already open
+		ErrorCode operationError = node.AttemptPeerConnect(poolAddress);
+		if (operationError == ErrorID::CLIENT_CONNECTION_OCCUPIED)
+			operationError = ErrorID::NONE;
+
+		if (!operationError)
+		{
+			// Push pending request return promise
+			Node::PendingOperationReturn requestReturnPromise = { requestID, std::promise<OperationReturnValue>() };
+
+			returnVal = requestReturnPromise.second.get_future();
+			node.GetPendingReturnsFromOperations().EmplaceBackElement(std::move(requestReturnPromise));
+
+			// Construct request message
+			Message requestMsg;
+			requestMsg.header.id = MessageRepType::POOL_JOB_REQUEST;
+			requestMsg.header.networkID = node.GetNetworkID();
+
+			requestMsg << requestID;
+
+			// Push request message into queue to be transmitted
+			node.GetClient().PushOutboundMessage(requestMsg);
+			node.GetClient().TransmitOutboundMessages();
+		}
+
+		return operationError;
+	}
+
+	ErrorCode SubmitPoolShare(Node& node, const std::string& poolAddress, uint64_t jobID, uint64_t nonce,
+		std::future<OperationReturnValue>& returnVal)
+	{
+		std::scoped_lock lock(operationMutex);
+
+		const uint32_t requestID = node.GenerateRequestID();
+
+		// Connect to the pool node, the connection is reused if it's already open
+		ErrorCode operationError = node.AttemptPeerConnect(poolAddress);
+		if (operationError == ErrorID::CLIENT_CONNECTION_OCCUPIED)
+			operationError = ErrorID::NONE;
+
+		if (!operationError)
+		{
+			// Push pending request return promise
+			Node::PendingOperationReturn requestReturnPromise = { requestID, std::promise<OperationReturnValue>() };
+
+			returnVal = requestReturnPromise.second.get_future();
+			node.GetPendingReturnsFromOperations().EmplaceBackElement(std::move(requestReturnPromise));
+
+			// Construct submission message
+			Message submitMsg;
+			submitMsg.header.id = MessageRepType::POOL_SHARE_SUBMIT;
+			submitMsg.header.networkID = node.GetNetworkID();
+
+			submitMsg << requestID << jobID << nonce;
+
+			// Push submission message into queue to be transmitted
+			node.GetClient().PushOutboundMessage(submitMsg);
+			node.GetClient().TransmitOutboundMessages();
+		}
+
+		return operationError;
+	}
+
+	ErrorCode RelayTransaction(Node& node, const std::string& peerAddress, const Transaction& tx)
+	{
+		std::scoped_lock lock(operationMutex);
+
+		uint8_t encoding[VOLT_TRANSACTION_MAX_ENCODED_SIZE];
+		const size_t encodingLength = Volt::EncodeTransaction(tx, encoding);
+		if (encodingLength == 0)
+			return ErrorID::TRANSACTION_ENCODING_INVALID;
+
+		// Connect to the peer node, the connection is reused if it's already open
+		ErrorCode operationError = node.AttemptPeerConnect(peerAddress);
+		if (operationError == ErrorID::CLIENT_CONNECTION_OCCUPIED)
+			operationError = ErrorID::NONE;
+
+		if (!operationError)
+		{
+			// Construct relay message
+			Message relayMsg;
+			relayMsg.header.id = MessageRepType::TRANSACTION_RELAY;
+			relayMsg.header.networkID = node.GetNetworkID();
+
+			relayMsg << std::string((const char*)encoding, encodingLength);
+
+			// Push relay message into queue to be transmitted
+			node.GetClient().PushOutboundMessage(relayMsg);
+			node.GetClient().TransmitOutboundMessages();
+		}
+
+		return operationError;
+	}
+}
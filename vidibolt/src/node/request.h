@@ -14,9 +14,32 @@ namespace Volt
 
 	// Sends request to a peer FULL node to return the balance tied to the public key given.
 	// The returned amount is returned through the last parameter as a future which contains a variant,
-	// the expected output is of type DOUBLE.
+	// the expected output is of type AMOUNT (in base units, see VOLT_AMOUNT_UNITS_PER_COIN).
 	extern VOLT_API ErrorCode RequestAddressBalance(Node& node, const ECKeyPair& publicKey, 
-		std::future<std::variant<double>>& returnVal);
+		std::future<OperationReturnValue>& returnVal);
+
+	// Sends request to the FULL node coordinating a mining pool at the address given to hand out a job. The pool tells its
+	// workers apart by their connections, so the connection to the pool is kept open between pool requests (and shares
+	// must be submitted over the connection the job was requested on).
+	// The job is returned through the last parameter as a future which contains a variant, the expected output is of type
+	// POOLJOB. A job ID of 0 means that the pool couldn't hand out a job.
+	//
+	// The job should be mined via a MiningJob with its share callback set to the share difficulty of the job and timestamp
+	// rolling disabled, each share found is submitted via SubmitPoolShare() and a new job is requested once the job
+	// finishes (or a share is rejected as stale).
+	extern VOLT_API ErrorCode RequestPoolJob(Node& node, const std::string& poolAddress,
+		std::future<OperationReturnValue>& returnVal);
+
+	// Submits the share found for the pool job given to the FULL node coordinating the mining pool at the address given.
+	// The outcome is returned through the last parameter as a future which contains a variant, the expected output is of
+	// type POOLSHARERESULT.
+	extern VOLT_API ErrorCode SubmitPoolShare(Node& node, const std::string& poolAddress, uint64_t jobID, uint64_t nonce,
+		std::future<OperationReturnValue>& returnVal);
+
+	// Relays the transaction given to the peer node at the address given in its binary encoding (see EncodeTransaction()),
+	// the peer pushes it into its mempool if it has one. No response is sent back.
+	// 'ErrorID::TRANSACTION_ENCODING_INVALID' is returned if the transaction can't be encoded (e.g. a malformed key).
+	extern VOLT_API ErrorCode RelayTransaction(Node& node, const std::string& peerAddress, const Transaction& tx);
 }
 
 #endif
\ No newline at end of file
@@ -1,57 +1,337 @@
 #include <util/data_conversion.h>
+#include <crypto/cpu_features.h>
 
-#include <sstream>
-#include <iomanip>
-#include <algorithm>
+#include <atomic>
+#include <string>
 
-namespace Volt
+#ifdef VOLT_CPU_X86
+	#include <immintrin.h>
+#endif
+
+namespace
 {
-	std::vector<uint8_t> ConvertHexToByteData(const std::string& hex)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	constexpr char upperHexCharacters[] = "0123456789ABCDEF";
+	constexpr char lowerHexCharacters[] = "0123456789abcdef";
+
+	// The value of every character as a hex digit, characters which aren't hex digits are set to 0xFF.
+	struct HexValueTable
 	{
-		std::vector<uint8_t> resultByteData;
-		resultByteData.reserve(hex.size() / 2);
-	
-		// Convert the hexadecimal string into bytes
-		for (size_t i = 0; i < hex.size(); i += 2)
+		uint8_t values[256];
+
+		constexpr HexValueTable() :
+			values()
 		{
-			int leftShiftAmt = 4;
-			unsigned char deneryChar = 0;
-			
-			for (size_t j = 0; j < 2; j++)
-			{
-				if (hex[i + j] >= '0' && hex[i + j] <= '9')
-					deneryChar += (unsigned char)((hex[i + j] - '0') << leftShiftAmt);
-				else if (hex[i + j] >= 'A' && hex[i + j] <= 'F')
-					deneryChar += (unsigned char)((10 + (hex[i + j] - 'A')) << leftShiftAmt);
+			for (uint32_t i = 0; i < 256; i++)
+				values[i] = 0xFF;
+
+			for (uint8_t i = 0; i < 10; i++)
+				values['0' + i] = i;
 
-				leftShiftAmt -= 4;
+			for (uint8_t i = 0; i < 6; i++)
+			{
+				values['A' + i] = (uint8_t)(10 + i);
+				values['a' + i] = (uint8_t)(10 + i);
 			}
+		}
+	};
+
+	constexpr HexValueTable hexValueTable;
+
+	// Returns the value of the hex character given, other characters are treated as zero.
+	inline uint8_t ConvertHexCharacter(char c)
+	{
+		const uint8_t value = hexValueTable.values[(uint8_t)c];
+		return value == 0xFF ? 0 : value;
+	}
+
+	// The portable implementations, supported by every CPU.
+	void EncodeHexScalar(const uint8_t* bytes, size_t length, char* hexOutput)
+	{
+		for (size_t i = 0; i < length; i++)
+		{
+			hexOutput[i * 2] = upperHexCharacters[bytes[i] >> 4];
+			hexOutput[i * 2 + 1] = upperHexCharacters[bytes[i] & 0x0F];
+		}
+	}
+
+	// Returns FALSE if a character which isn't a hex digit was found.
+	bool DecodeHexScalar(const char* hex, size_t byteLength, uint8_t* byteOutput)
+	{
+		uint8_t invalidBits = 0;
+		for (size_t i = 0; i < byteLength; i++)
+		{
+			const uint8_t high = hexValueTable.values[(uint8_t)hex[i * 2]];
+			const uint8_t low = hexValueTable.values[(uint8_t)hex[i * 2 + 1]];
+
+			invalidBits |= high | low;
+			byteOutput[i] = (uint8_t)(((high & 0x80) ? 0 : high << 4) | ((low & 0x80) ? 0 : low));
+		}
+
+		return (invalidBits & 0x80) == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef VOLT_CPU_X86
+	// Converts 16 bytes into 32 upper case hex characters.
+	VOLT_TARGET_FEATURES("ssse3") inline void EncodeHex16(const uint8_t* bytes, char* hexOutput)
+	{
+		const __m128i characters = _mm_loadu_si128((const __m128i*)upperHexCharacters);
+		const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+		const __m128i data = _mm_loadu_si128((const __m128i*)bytes);
+		const __m128i high = _mm_shuffle_epi8(characters, _mm_and_si128(_mm_srli_epi16(data, 4), nibbleMask));
+		const __m128i low = _mm_shuffle_epi8(characters, _mm_and_si128(data, nibbleMask));
+
+		_mm_storeu_si128((__m128i*)hexOutput, _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128((__m128i*)(hexOutput + 16), _mm_unpackhi_epi8(high, low));
+	}
+
+	// Converts 16 hex characters into their values, characters which aren't hex digits are zeroed and cleared in
+	// 'validMask'.
+	VOLT_TARGET_FEATURES("ssse3") inline __m128i DecodeHexCharacters16(__m128i characters, __m128i& validMask)
+	{
+		// Digits are the characters within 0-9 after subtracting '0', and letters are the characters within 0-5 after
+		// lower casing them and subtracting 'a', everything else wraps around to larger values
+		const __m128i digits = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+		const __m128i letters = _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+		const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+		const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+		validMask = _mm_and_si128(validMask, _mm_or_si128(isDigit, isLetter));
+		return _mm_or_si128(_mm_and_si128(isDigit, digits),
+			_mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+	}
+
+	// Converts 32 hex characters into 16 bytes.
+	VOLT_TARGET_FEATURES("ssse3") inline void DecodeHex16(const char* hex, uint8_t* byteOutput, __m128i& validMask)
+	{
+		// Multiplying each pair of values by (16, 1) and adding them gives the bytes as 16-bit integers
+		const __m128i pairWeights = _mm_set1_epi16(0x0110);
+
+		const __m128i first = _mm_maddubs_epi16(
+			DecodeHexCharacters16(_mm_loadu_si128((const __m128i*)hex), validMask), pairWeights);
+		const __m128i second = _mm_maddubs_epi16(
+			DecodeHexCharacters16(_mm_loadu_si128((const __m128i*)(hex + 16)), validMask), pairWeights);
+
+		_mm_storeu_si128((__m128i*)byteOutput, _mm_packus_epi16(first, second));
+	}
+
+	VOLT_TARGET_FEATURES("ssse3") void EncodeHexSSSE3(const uint8_t* bytes, size_t length, char* hexOutput)
+	{
+		size_t i = 0;
+		for (; i + 16 <= length; i += 16)
+			EncodeHex16(bytes + i, hexOutput + i * 2);
+
+		EncodeHexScalar(bytes + i, length - i, hexOutput + i * 2);
+	}
+
+	VOLT_TARGET_FEATURES("ssse3") bool DecodeHexSSSE3(const char* hex, size_t byteLength, uint8_t* byteOutput)
+	{
+		__m128i validMask = _mm_set1_epi8(-1);
+
+		size_t i = 0;
+		for (; i + 16 <= byteLength; i += 16)
+			DecodeHex16(hex + i * 2, byteOutput + i, validMask);
+
+		const bool tailValid = DecodeHexScalar(hex + i * 2, byteLength - i, byteOutput + i);
+		return tailValid && _mm_movemask_epi8(validMask) == 0xFFFF;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The AVX2 versions of the functions above, the 128-bit lanes are shuffled separately so the lanes are reordered
+	// after interleaving and packing.
+	VOLT_TARGET_FEATURES("avx2") inline __m256i DecodeHexCharacters32(__m256i characters, __m256i& validMask)
+	{
+		const __m256i digits = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+		const __m256i letters = _mm256_sub_epi8(_mm256_or_si256(characters, _mm256_set1_epi8(0x20)),
+			_mm256_set1_epi8('a'));
+
+		const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+		const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+
+		validMask = _mm256_and_si256(validMask, _mm256_or_si256(isDigit, isLetter));
+		return _mm256_or_si256(_mm256_and_si256(isDigit, digits),
+			_mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+	}
+
+	VOLT_TARGET_FEATURES("avx2") void EncodeHexAVX2(const uint8_t* bytes, size_t length, char* hexOutput)
+	{
+		const __m256i characters = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)upperHexCharacters));
+		const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+		size_t i = 0;
+		for (; i + 32 <= length; i += 32)
+		{
+			const __m256i data = _mm256_loadu_si256((const __m256i*)(bytes + i));
+			const __m256i high = _mm256_shuffle_epi8(characters, _mm256_and_si256(_mm256_srli_epi16(data, 4), nibbleMask));
+			const __m256i low = _mm256_shuffle_epi8(characters, _mm256_and_si256(data, nibbleMask));
+
+			// Holds the hex of bytes 0-7 and 16-23, then bytes 8-15 and 24-31
+			const __m256i interleavedLow = _mm256_unpacklo_epi8(high, low);
+			const __m256i interleavedHigh = _mm256_unpackhi_epi8(high, low);
 
-			resultByteData.emplace_back(deneryChar);
+			_mm256_storeu_si256((__m256i*)(hexOutput + i * 2), _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x20));
+			_mm256_storeu_si256((__m256i*)(hexOutput + i * 2 + 32),
+				_mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x31));
 		}
 
+		EncodeHexSSSE3(bytes + i, length - i, hexOutput + i * 2);
+	}
+
+	VOLT_TARGET_FEATURES("avx2") bool DecodeHexAVX2(const char* hex, size_t byteLength, uint8_t* byteOutput)
+	{
+		const __m256i pairWeights = _mm256_set1_epi16(0x0110);
+		__m256i validMask = _mm256_set1_epi8(-1);
+
+		size_t i = 0;
+		for (; i + 32 <= byteLength; i += 32)
+		{
+			const __m256i first = _mm256_maddubs_epi16(
+				DecodeHexCharacters32(_mm256_loadu_si256((const __m256i*)(hex + i * 2)), validMask), pairWeights);
+			const __m256i second = _mm256_maddubs_epi16(
+				DecodeHexCharacters32(_mm256_loadu_si256((const __m256i*)(hex + i * 2 + 32)), validMask), pairWeights);
+
+			// Packing gives bytes 0-7, 16-23, 8-15 and 24-31 in that order
+			_mm256_storeu_si256((__m256i*)(byteOutput + i),
+				_mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+		}
+
+		const bool tailValid = DecodeHexSSSE3(hex + i * 2, byteLength - i, byteOutput + i);
+		return tailValid && _mm256_movemask_epi8(validMask) == -1;
+	}
+#endif
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::atomic<Volt::HexCodecBackend> selectedBackend = Volt::GetBestHexCodecBackend();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+namespace Volt
+{
+	HexCodecBackend GetBestHexCodecBackend()
+	{
+		static const HexCodecBackend bestBackend = IsHexCodecBackendSupported(HexCodecBackend::AVX2) ? HexCodecBackend::AVX2 :
+			IsHexCodecBackendSupported(HexCodecBackend::SSSE3) ? HexCodecBackend::SSSE3 : HexCodecBackend::SCALAR;
+
+		return bestBackend;
+	}
+
+	bool IsHexCodecBackendSupported(HexCodecBackend backend)
+	{
+		switch (backend)
+		{
+		case HexCodecBackend::SCALAR:
+			return true;
+		case HexCodecBackend::SSSE3:
+			return Volt::IsCPUFeatureSupported(CPUFeature::SSSE3);
+		case HexCodecBackend::AVX2:
+			return Volt::IsCPUFeatureSupported(CPUFeature::AVX2);
+		}
+
+		return false;
+	}
+
+	HexCodecBackend GetHexCodecBackend()
+	{
+		return selectedBackend.load(std::memory_order_relaxed);
+	}
+
+	ErrorCode SetHexCodecBackend(HexCodecBackend backend)
+	{
+		if (!IsHexCodecBackendSupported(backend))
+			return ErrorID::HEX_CODEC_BACKEND_NOT_SUPPORTED;
+
+		selectedBackend.store(backend, std::memory_order_relaxed);
+		return ErrorID::NONE;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<uint8_t> ConvertHexToByteData(const std::string& hex)
+	{
+		std::vector<uint8_t> resultByteData((hex.size() + 1) / 2);
+		Volt::ConvertHexToByteData(hex.data(), hex.size(), resultByteData.data());
+
+		// A trailing odd character is converted as the upper half of a byte
+		if (hex.size() % 2 != 0)
+			resultByteData.back() = (uint8_t)(ConvertHexCharacter(hex.back()) << 4);
+
 		return resultByteData;
 	}
 
-	std::string ConvertByteToHexData(const std::vector<uint8_t>& bytes)
+	bool ConvertHexToByteData(const char* hex, size_t hexLength, uint8_t* byteOutput)
 	{
-		std::stringstream ss;
-		for (uint32_t i = 0; i < bytes.size(); i++)
-			ss << std::hex << std::setw(2) << std::setfill('0') << (int)bytes[i];
+		bool isValid = false;
+		switch (selectedBackend.load(std::memory_order_relaxed))
+		{
+	#ifdef VOLT_CPU_X86
+		case HexCodecBackend::AVX2:
+			isValid = DecodeHexAVX2(hex, hexLength / 2, byteOutput);
+			break;
+		case HexCodecBackend::SSSE3:
+			isValid = DecodeHexSSSE3(hex, hexLength / 2, byteOutput);
+			break;
+	#endif
+		default:
+			isValid = DecodeHexScalar(hex, hexLength / 2, byteOutput);
+			break;
+		}
 
-		// Convert hex to upper case format
-		std::string hex = ss.str();
-		std::transform(hex.begin(), hex.end(), hex.begin(), ::toupper);
+		return isValid && hexLength % 2 == 0;
+	}
+
+	std::string ConvertByteToHexData(const std::vector<uint8_t>& bytes)
+	{
+		std::string hex(bytes.size() * 2, '0');
+		Volt::ConvertByteToHexData(bytes.data(), bytes.size(), &hex[0]);
 
 		return hex;
 	}
 
+	void ConvertByteToHexData(const uint8_t* bytes, size_t length, char* hexOutput)
+	{
+		switch (selectedBackend.load(std::memory_order_relaxed))
+		{
+	#ifdef VOLT_CPU_X86
+		case HexCodecBackend::AVX2:
+			EncodeHexAVX2(bytes, length, hexOutput);
+			break;
+		case HexCodecBackend::SSSE3:
+			EncodeHexSSSE3(bytes, length, hexOutput);
+			break;
+	#endif
+		default:
+			EncodeHexScalar(bytes, length, hexOutput);
+			break;
+		}
+	}
+
 	std::string ConvertUintToHex(const uint64_t& num)
 	{
-		std::stringstream hexStream;
-		hexStream << std::hex << std::setw(2) << std::setfill('0') << num;
+		char hex[VOLT_UINT64_HEX_LENGTH];
+		return std::string(hex, Volt::ConvertUintToHex(num, hex));
+	}
+
+	size_t ConvertUintToHex(uint64_t num, char* hexOutput, bool upperCase)
+	{
+		const char* hexCharacters = upperCase ? upperHexCharacters : lowerHexCharacters;
+
+		// Count the significant digits, at least 2 are always written
+		size_t digitCount = 2;
+		while (digitCount < VOLT_UINT64_HEX_LENGTH && (num >> (digitCount * 4)) != 0)
+			digitCount++;
+
+		for (size_t i = 0; i < digitCount; i++)
+			hexOutput[digitCount - 1 - i] = hexCharacters[(num >> (i * 4)) & 0x0F];
 
-		return hexStream.str();
+		return digitCount;
 	}
 
 	uint64_t ConvertHexToUint(const std::string& hex)
@@ -59,6 +339,21 @@ namespace Volt
 		return std::stoull(hex, nullptr, 16);
 	}
 
+	uint64_t ConvertHexToUint(const char* hex, size_t hexLength)
+	{
+		uint64_t result = 0;
+		for (size_t i = 0; i < hexLength; i++)
+		{
+			const uint8_t value = hexValueTable.values[(uint8_t)hex[i]];
+			if (value == 0xFF)
+				break;
+
+			result = (result << 4) | value;
+		}
+
+		return result;
+	}
+
 	std::vector<uint8_t> GetRawString(const std::string& str)
 	{
 		std::vector<uint8_t> rawStringData;
@@ -69,4 +364,4 @@ namespace Volt
 
 		return rawStringData;
 	}
-}
\ No newline at end of file
+}
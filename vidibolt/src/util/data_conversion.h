@@ -2,26 +2,76 @@
 #define VIDIBOLT_DATA_CONVERSIONS_H
 
 #include <util/volt_api.h>
+#include <util/error_identifier.h>
 #include <string>
 #include <vector>
 
+// The maximum number of characters written by 'ConvertUintToHex' into a buffer.
+#define VOLT_UINT64_HEX_LENGTH 16
+
 namespace Volt
 {
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// An enumeration that represents the implementations which hex data can be encoded and decoded with.
+	enum class HexCodecBackend : int
+	{
+		SCALAR, // The portable table based implementation, supported by every CPU
+		SSSE3,  // Converts 16 bytes at a time using SSSE3 shuffles
+		AVX2    // Converts 32 bytes at a time using AVX2 shuffles
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the fastest hex codec backend supported by the CPU, this is detected once at runtime.
+	extern VOLT_API HexCodecBackend GetBestHexCodecBackend();
+
+	// Returns TRUE if the CPU supports the hex codec backend given, else FALSE is returned.
+	extern VOLT_API bool IsHexCodecBackendSupported(HexCodecBackend backend);
+
+	// Returns the hex codec backend currently used, this is the best backend unless overridden.
+	extern VOLT_API HexCodecBackend GetHexCodecBackend();
+
+	// Overrides the hex codec backend used by every thread (e.g. for benchmarking or testing).
+	// An error code is returned if the backend isn't supported by the CPU.
+	extern VOLT_API ErrorCode SetHexCodecBackend(HexCodecBackend backend);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 	// Returns vector array of bytes representing the resulting data from converting from a hex format to a byte format.
+	// Characters which aren't hex digits are treated as zero.
 	extern VOLT_API std::vector<uint8_t> ConvertHexToByteData(const std::string& hex);
 
+	// Converts the upper or lower case hex data given into bytes, 'hexLength / 2' bytes are written into 'byteOutput' and
+	// characters which aren't hex digits are treated as zero. Returns FALSE if the hex data has an odd length or contains
+	// a character which isn't a hex digit, else TRUE is returned.
+	extern VOLT_API bool ConvertHexToByteData(const char* hex, size_t hexLength, uint8_t* byteOutput);
+
 	// Returns the resulting hex data string from the conversion of the given byte data to hexadecimal format.
 	extern VOLT_API std::string ConvertByteToHexData(const std::vector<uint8_t>& bytes);
 
+	// Converts the byte data given into upper case hex, 'length * 2' characters are written into 'hexOutput'.
+	extern VOLT_API void ConvertByteToHexData(const uint8_t* bytes, size_t length, char* hexOutput);
+
 	// Returns the resulting hex data string from the conversion of the given unsigned integer to hexadecimal format.
 	extern VOLT_API std::string ConvertUintToHex(const uint64_t& num);
 
+	// Writes the hex of the unsigned integer given into 'hexOutput' without a null terminator, at least 2 digits are
+	// written. Returns the number of characters written, which is never more than 'VOLT_UINT64_HEX_LENGTH'.
+	extern VOLT_API size_t ConvertUintToHex(uint64_t num, char* hexOutput, bool upperCase = false);
+
 	// Returns the resulting unsigned integer retrieved from the hex to uint conversion
 	extern VOLT_API uint64_t ConvertHexToUint(const std::string& hex);
 
+	// Returns the resulting unsigned integer retrieved from the hex to uint conversion, parsing stops at the first
+	// character which isn't a hex digit.
+	extern VOLT_API uint64_t ConvertHexToUint(const char* hex, size_t hexLength);
+
 	// Returns vector of characters extracted from string object.
     // NOTE: The unsigned char vector doesn't include the null terminator.
 	extern VOLT_API std::vector<uint8_t> GetRawString(const std::string& str);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 }
 
 #endif
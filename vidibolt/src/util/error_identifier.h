@@ -38,6 +38,18 @@ namespace Volt
 		NO_SUITABLE_NODE_IN_NODE_PEER_LIST = 20022,
 		CLIENT_CONNECTION_OCCUPIED = 20023,
 		BALANCE_REQUEST_PEER_SIDE_ERROR = 20024,
+		MERKLE_LEAF_INDEX_INVALID = 20025,
+		MINING_JOB_ALREADY_RUNNING = 20026,
+		MINING_JOB_NOT_RUNNING = 20027,
+		MINING_JOB_CANCELLED = 20028,
+		MINING_POOL_NOT_AVAILABLE = 20029,
+		POOL_JOB_NOT_FOUND = 20030,
+		POOL_SHARE_NONCE_OUT_OF_RANGE = 20031,
+		POOL_SHARE_DUPLICATE = 20032,
+		POOL_SHARE_DIFFICULTY_INSUFFICIENT = 20033,
+		HEX_CODEC_BACKEND_NOT_SUPPORTED = 20034,
+		TRANSACTION_ENCODING_INVALID = 20035,
+		TRANSACTION_ENCODING_VERSION_UNSUPPORTED = 20036,
 
 		// OpenSSL related error codes
 		MESSAGE_EMPTY = 40000,
@@ -55,6 +67,9 @@ namespace Volt
 		ECDSA_KEY_GENERATION_ERROR = 40012,
 		EC_PARAMGEN_CURVE_ERROR = 40013,
 		SIGNITURE_INVALID = 40014,
+		MIDSTATE_PREFIX_LENGTH_INVALID = 40015,
+		NONCE_KERNEL_INPUT_INVALID = 40016,
+		SHA256_BACKEND_NOT_SUPPORTED = 40017,
 
 		// ASIO error codes
 		EOF_ERROR = 2,
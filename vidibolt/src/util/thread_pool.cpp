@@ -0,0 +1,139 @@
+#include <util/thread_pool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class ThreadPool::Implementation
+	{
+	public:
+		std::vector<std::thread> workers;
+
+		std::mutex mutex, runMutex;
+		std::condition_variable taskCondition, doneCondition;
+
+		const std::function<void()>* task;
+		uint64_t taskGeneration; // Increased for every task run, so workers can tell a new task has been given
+		uint32_t activeWorkers;
+		bool stopping;
+	public:
+		Implementation(uint32_t numWorkers) :
+			task(nullptr), taskGeneration(0), activeWorkers(0), stopping(false)
+		{
+			this->workers.reserve(numWorkers);
+			for (uint32_t index = 0; index < numWorkers; index++)
+				this->workers.emplace_back(&Implementation::RunWorker, this);
+		}
+
+		~Implementation()
+		{
+			{
+				std::scoped_lock lock(this->mutex);
+				this->stopping = true;
+			}
+
+			this->taskCondition.notify_all();
+			for (std::thread& worker : this->workers)
+				worker.join();
+		}
+
+		// The loop run by each worker thread, which waits for tasks and runs them until the pool is destroyed.
+		void RunWorker()
+		{
+			uint64_t lastTaskGeneration = 0;
+
+			while (true)
+			{
+				const std::function<void()>* currentTask = nullptr;
+				{
+					std::unique_lock lock(this->mutex);
+					this->taskCondition.wait(lock, [&]() { 
+						return this->stopping || this->taskGeneration != lastTaskGeneration; 
+					});
+
+					if (this->stopping)
+						return;
+
+					lastTaskGeneration = this->taskGeneration;
+					currentTask = this->task;
+				}
+
+				(*currentTask)();
+
+				std::scoped_lock lock(this->mutex);
+				if (--this->activeWorkers == 0)
+					this->doneCondition.notify_one();
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ThreadPool::ThreadPool(uint32_t numWorkers) :
+		impl(std::make_unique<Implementation>(numWorkers))
+	{}
+
+	ThreadPool::~ThreadPool() = default;
+
+	void ThreadPool::Run(const std::function<void()>& task)
+	{
+		// Run the task on the calling thread only if there's no workers or another task is already running
+		std::unique_lock runLock(this->impl->runMutex, std::try_to_lock);
+		if (!runLock.owns_lock() || this->impl->workers.empty())
+		{
+			task();
+			return;
+		}
+
+		{
+			std::scoped_lock lock(this->impl->mutex);
+			this->impl->task = &task;
+			this->impl->activeWorkers = (uint32_t)this->impl->workers.size();
+			this->impl->taskGeneration++;
+		}
+
+		this->impl->taskCondition.notify_all();
+
+		// The workers hold a reference to the task, so they must be waited for even if the task throws on this thread
+		std::exception_ptr taskException;
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			taskException = std::current_exception();
+		}
+
+		{
+			std::unique_lock lock(this->impl->mutex);
+			this->impl->doneCondition.wait(lock, [&]() { return this->impl->activeWorkers == 0; });
+			this->impl->task = nullptr;
+		}
+
+		if (taskException)
+			std::rethrow_exception(taskException);
+	}
+
+	uint32_t ThreadPool::GetThreadCount() const
+	{
+		return (uint32_t)this->impl->workers.size() + 1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ThreadPool& GetSharedThreadPool()
+	{
+		static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+		return pool;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
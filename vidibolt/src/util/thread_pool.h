@@ -0,0 +1,52 @@
+#ifndef VIDIBOLT_THREAD_POOL_H
+#define VIDIBOLT_THREAD_POOL_H
+
+#include <util/volt_api.h>
+
+#include <functional>
+#include <memory>
+
+namespace Volt
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A class which holds a fixed set of worker threads that tasks can be run across in parallel, so short lived parallel
+	// work (e.g. verifying the transactions of a block) doesn't pay for creating threads every time.
+	// 
+	// The calling thread always takes part in running a task, so a pool without any worker threads runs tasks on the
+	// calling thread only. Only one task runs on the pool at a time, if the pool is busy the task is run on the calling
+	// thread only (this also means a task can run tasks of its own without deadlocking).
+	class ThreadPool
+	{
+	private:
+		class Implementation;
+		std::unique_ptr<Implementation> impl;
+	public:
+		VOLT_API ThreadPool(uint32_t numWorkers);
+		VOLT_API ThreadPool(const ThreadPool& pool) = delete;
+
+		VOLT_API ~ThreadPool();
+
+		VOLT_API void operator=(const ThreadPool& pool) = delete;
+
+		// Runs the task given on every worker thread and the calling thread, then waits for all of them to finish.
+		// The task is run once by each thread, so it should split its work between the threads itself (e.g. by claiming
+		// work items from an atomic counter).
+		// An exception thrown by the task on the calling thread is rethrown once the workers have finished, exceptions
+		// thrown on the worker threads aren't supported (they terminate the program), so the task shouldn't throw.
+		VOLT_API void Run(const std::function<void()>& task);
+
+		// Returns the number of threads which tasks are run across, including the calling thread.
+		VOLT_API uint32_t GetThreadCount() const;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the thread pool shared by the verification work of the node, it has a thread for every hardware thread of the
+	// CPU (including the calling thread) and is created the first time this function is called.
+	extern VOLT_API ThreadPool& GetSharedThreadPool();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
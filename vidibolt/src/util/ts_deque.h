@@ -34,6 +34,10 @@ namespace Volt
 				deque(deque)
 			{}
 
+			Implementation(std::deque<Ty>&& deque) :
+				deque(std::move(deque))
+			{}
+
 			~Implementation() = default;
 
 			void operator=(const Implementation<Ty>& other)
@@ -47,12 +51,24 @@ namespace Volt
 				this->deque.push_back(data);
 			}
 
+			void PushBackElement(Ty&& data)
+			{
+				std::scoped_lock lock(this->mutex);
+				this->deque.push_back(std::move(data));
+			}
+
 			void PushFrontElement(const Ty& data)
 			{
 				std::scoped_lock lock(this->mutex);
 				this->deque.push_front(data);
 			}
 
+			void PushFrontElement(Ty&& data)
+			{
+				std::scoped_lock lock(this->mutex);
+				this->deque.push_front(std::move(data));
+			}
+
 			void ClearElements()
 			{
 				std::scoped_lock lock(this->mutex);
@@ -130,17 +146,29 @@ namespace Volt
 		VOLT_EXPORT Deque();
 		VOLT_EXPORT Deque(const Deque<Ty>& other);
 		VOLT_EXPORT Deque(const std::deque<Ty>& deque);
+		VOLT_EXPORT Deque(std::deque<Ty>&& deque);
+
+		// Takes the elements of the other queue without copying them, the queue moved from is left without any storage
+		// so it can only be assigned to or destroyed.
+		VOLT_EXPORT Deque(Deque<Ty>&& other) noexcept;
 
 		VOLT_EXPORT ~Deque() = default;
 
 		VOLT_EXPORT void operator=(const Deque<Ty>& other);
+		VOLT_EXPORT void operator=(Deque<Ty>&& other) noexcept;
 
 		// Pushes element to the back of the queue.
 		VOLT_EXPORT void PushBackElement(const Ty& data);
 
+		// Pushes element to the back of the queue.
+		VOLT_EXPORT void PushBackElement(Ty&& data);
+
 		// Pushes element to the front of the queue.
 		VOLT_EXPORT void PushFrontElement(const Ty& data);
 
+		// Pushes element to the front of the queue.
+		VOLT_EXPORT void PushFrontElement(Ty&& data);
+
 		// Clears out the queue of all elements it contains.
 		VOLT_EXPORT void ClearElements();
 
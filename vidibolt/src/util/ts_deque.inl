@@ -15,21 +15,45 @@ namespace Volt
 		impl(std::make_unique<Implementation<Ty>>(deque))
 	{}
 
+	template<typename Ty>
+	Deque<Ty>::Deque(std::deque<Ty>&& deque) :
+		impl(std::make_unique<Implementation<Ty>>(std::move(deque)))
+	{}
+
+	template<typename Ty> Deque<Ty>::Deque(Deque<Ty>&& other) noexcept :
+		impl(std::move(other.impl))
+	{}
+
 	template<typename Ty> void Deque<Ty>::operator=(const Deque<Ty>& other)
 	{
 		this->impl = std::make_unique<Implementation<Ty>>(*other.impl);
 	}
 
+	template<typename Ty> void Deque<Ty>::operator=(Deque<Ty>&& other) noexcept
+	{
+		this->impl = std::move(other.impl);
+	}
+
 	template<typename Ty> void Deque<Ty>::PushBackElement(const Ty& data)
 	{
 		this->impl->PushBackElement(data);
 	}
 
+	template<typename Ty> void Deque<Ty>::PushBackElement(Ty&& data)
+	{
+		this->impl->PushBackElement(std::move(data));
+	}
+
 	template<typename Ty> void Deque<Ty>::PushFrontElement(const Ty& data)
 	{
 		this->impl->PushFrontElement(data);
 	}
 
+	template<typename Ty> void Deque<Ty>::PushFrontElement(Ty&& data)
+	{
+		this->impl->PushFrontElement(std::move(data));
+	}
+
 	template<typename Ty> void Deque<Ty>::ClearElements()
 	{
 		this->impl->ClearElements();
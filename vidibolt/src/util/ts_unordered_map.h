@@ -31,6 +31,10 @@ namespace Volt
 				map(map)
 			{}
 
+			Implementation(std::unordered_map<Key, Ty>&& map) :
+				map(std::move(map))
+			{}
+
 			~Implementation() = default;
 
 			void operator=(const Implementation<Key, Ty>& other)
@@ -142,10 +146,16 @@ namespace Volt
 		VOLT_EXPORT UnorderedMap();
 		VOLT_EXPORT UnorderedMap(const UnorderedMap<Key, Ty>& other);
 		VOLT_EXPORT UnorderedMap(const std::unordered_map<Key, Ty>& map);
+		VOLT_EXPORT UnorderedMap(std::unordered_map<Key, Ty>&& map);
+
+		// Takes the elements of the other map without copying them, the map moved from is left without any storage so it
+		// can only be assigned to or destroyed.
+		VOLT_EXPORT UnorderedMap(UnorderedMap<Key, Ty>&& other) noexcept;
 
 		VOLT_EXPORT ~UnorderedMap() = default;
 
 		VOLT_EXPORT void operator=(const UnorderedMap<Key, Ty>& other);
+		VOLT_EXPORT void operator=(UnorderedMap<Key, Ty>&& other) noexcept;
 
 		// Reserves space for at least the specified number of elements and regenerates the hash table.
 		VOLT_EXPORT void Reserve(size_t count);
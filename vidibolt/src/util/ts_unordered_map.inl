@@ -15,11 +15,25 @@ namespace Volt
 		impl(std::make_unique<Implementation<Key, Ty>>(map))
 	{}
 
+	template<typename Key, typename Ty>
+	UnorderedMap<Key, Ty>::UnorderedMap(std::unordered_map<Key, Ty>&& map) :
+		impl(std::make_unique<Implementation<Key, Ty>>(std::move(map)))
+	{}
+
+	template<typename Key, typename Ty> UnorderedMap<Key, Ty>::UnorderedMap(UnorderedMap<Key, Ty>&& other) noexcept :
+		impl(std::move(other.impl))
+	{}
+
 	template<typename Key, typename Ty> void UnorderedMap<Key, Ty>::operator=(const UnorderedMap<Key, Ty>& other)
 	{
 		this->impl = std::make_unique<Implementation<Key, Ty>>(*other.impl);
 	}
 
+	template<typename Key, typename Ty> void UnorderedMap<Key, Ty>::operator=(UnorderedMap<Key, Ty>&& other) noexcept
+	{
+		this->impl = std::move(other.impl);
+	}
+
 	template<typename Key, typename Ty> void UnorderedMap<Key, Ty>::Reserve(size_t count)
 	{
 		this->impl->Reserve(count);
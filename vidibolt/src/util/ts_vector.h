@@ -32,6 +32,10 @@ namespace Volt
 				vector(vector)
 			{}
 
+			Implementation(std::vector<Ty>&& vector) :
+				vector(std::move(vector))
+			{}
+
 			~Implementation() = default;
 
 			void operator=(const Implementation<Ty>& impl)
@@ -51,6 +55,12 @@ namespace Volt
 				this->vector.push_back(data);
 			}
 
+			void PushBackElement(Ty&& data)
+			{
+				std::scoped_lock lock(this->mutex);
+				this->vector.push_back(std::move(data));
+			}
+
 			void EmplaceBackElement(const Ty& data)
 			{
 				std::scoped_lock lock(this->mutex);
@@ -155,10 +165,16 @@ namespace Volt
 		VOLT_EXPORT Vector();
 		VOLT_EXPORT Vector(const Vector<Ty>& other);
 		VOLT_EXPORT Vector(const std::vector<Ty>& vector);
+		VOLT_EXPORT Vector(std::vector<Ty>&& vector);
+
+		// Takes the elements of the other vector without copying them, the vector moved from is left without any storage
+		// so it can only be assigned to or destroyed.
+		VOLT_EXPORT Vector(Vector<Ty>&& other) noexcept;
 
 		VOLT_EXPORT ~Vector() = default;
 
 		VOLT_EXPORT void operator=(const Vector<Ty>& other);
+		VOLT_EXPORT void operator=(Vector<Ty>&& other) noexcept;
 		
 		// Allocates memory thats enough to store specified number of elements.
 		VOLT_EXPORT void Reserve(size_t numElements);
@@ -166,6 +182,9 @@ namespace Volt
 		// Appends the element to the back of the vector
 		VOLT_EXPORT void PushBackElement(const Ty& data);
 
+		// Appends the element to the back of the vector
+		VOLT_EXPORT void PushBackElement(Ty&& data);
+
 		// Emplaces the element to the back of the vector.
 		VOLT_EXPORT void EmplaceBackElement(const Ty& data);
 		
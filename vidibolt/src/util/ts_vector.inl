@@ -14,11 +14,24 @@ namespace Volt
 		impl(std::make_unique<Implementation<Ty>>(vector))
 	{}
 
+	template<typename Ty> Vector<Ty>::Vector(std::vector<Ty>&& vector) :
+		impl(std::make_unique<Implementation<Ty>>(std::move(vector)))
+	{}
+
+	template<typename Ty> Vector<Ty>::Vector(Vector<Ty>&& other) noexcept :
+		impl(std::move(other.impl))
+	{}
+
 	template<typename Ty> void Vector<Ty>::operator=(const Vector<Ty>& other)
 	{
 		this->impl = std::make_unique<Implementation<Ty>>(*other.impl);
 	}
 
+	template<typename Ty> void Vector<Ty>::operator=(Vector<Ty>&& other) noexcept
+	{
+		this->impl = std::move(other.impl);
+	}
+
 	template<typename Ty> void Vector<Ty>::Reserve(size_t numElements)
 	{
 		this->impl->Reserve(numElements);
@@ -29,6 +42,11 @@ namespace Volt
 		this->impl->PushBackElement(data);
 	}
 
+	template<typename Ty> void Vector<Ty>::PushBackElement(Ty&& data)
+	{
+		this->impl->PushBackElement(std::move(data));
+	}
+
 	template<typename Ty> void Vector<Ty>::EmplaceBackElement(const Ty& data)
 	{
 		this->impl->EmplaceBackElement(data);
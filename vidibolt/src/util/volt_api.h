@@ -21,6 +21,8 @@ typedef unsigned long long uint64_t;
 typedef unsigned char uint8_t;
 
 constexpr uint32_t VOLT_MAX_TRANSACTIONS_PER_BLOCK = 20;
-constexpr double VOLT_RECOMMENDED_TRANSACTION_FEE = 0.5, VOLT_MINING_REWARD = 250;
+constexpr uint32_t VOLT_BLOCK_HEADER_VERSION = 2, VOLT_BLOCK_HEADER_SIZE = 104, VOLT_BLOCK_HEADER_MIDSTATE_SIZE = 64;
+constexpr uint64_t VOLT_MAX_BLOCK_TIMESTAMP_DRIFT = 7200;
+constexpr long long VOLT_RECOMMENDED_TRANSACTION_FEE = 50000000, VOLT_MINING_REWARD = 25000000000; // In base units (see Amount)
 
 #endif
\ No newline at end of file